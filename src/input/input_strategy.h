@@ -30,6 +30,7 @@ SOFTWARE.
 #define TAYLORTRACK_SRC_INPUT_INPUT_STRATEGY_H_
 
 #include <yarp/os/all.h>
+#include <vector>
 #include "utils/config_parser.h"
 #include "utils/parameters.h"
 
@@ -71,6 +72,26 @@ class InputStrategy {
    * @param config_parser taylortrack::utils::ConfigParser object. Provides strategy the configuration it needs.
    */
   virtual void set_config(const utils::ConfigParser &config_parser) = 0;
+
+  /**
+   * @brief Tells whether read() itself waits until the data is due
+   *
+   * The streamer only pauses between reads of strategies that are not paced.
+   * @return true if the strategy paces its reads, false by default
+   */
+  virtual bool is_paced() {
+    return false;
+  }
+
+  /**
+   * @brief Returns the samples of the last read() before they were put into the bottle
+   *
+   * Lets the streamer record frames without decoding the bottle again. Valid until the next read().
+   * @return interleaved samples, nullptr if the strategy streams no samples
+   */
+  virtual const std::vector<double> *get_last_samples() {
+    return nullptr;
+  }
 };
 }  // namespace input
 }  // namespace taylortrack
@@ -28,6 +28,10 @@ SOFTWARE.
  */
 #include "input/microphone_input_strategy.h"
 #include <strings.h>
+#include <algorithm>
+#include "sim/frame_protocol.h"
+#include "sim/lag_protocol.h"
+#include "utils/signal_view.h"
 
 namespace taylortrack {
 namespace input {
@@ -44,37 +48,36 @@ int PaStreamCallback(const void *input,
                      PaStreamCallbackFlags statusFlags,
                      void *userData) {
   // casting void pointers to needed data types
-  const float **float_input =
-      reinterpret_cast<const float**>(const_cast<void*>(input));
+  const float *const *float_input =
+      reinterpret_cast<const float *const *>(input);
   MicrophoneStreamData *stream_data =
       reinterpret_cast<MicrophoneStreamData*>(userData);
 
-  // Do we need new data? If not, just skip it.
-  if (!stream_data->has_written) {
-    int number_of_channels = stream_data->channel_number;
-
-    // Clear existing data
-    for (int channel = 0; channel < number_of_channels; ++channel) {
-      stream_data->values[channel].clear();
-    }
-
-    // Fill in sample values (read one sample from each channel at a time)
-    for (int frame = 0; frame < static_cast<int>(frameSamples); ++frame) {
-      for (int channel = 0; channel < number_of_channels; ++channel) {
-        stream_data->values[channel].push_back(*float_input[channel]++);
-      }
-    }
-
-    // Mark data as available
-    stream_data->has_written = true;
+  // the ring neither allocates nor locks, a period that does not fit is dropped and counted
+  if (float_input) {
+    utils::CaptureStamp stamp;
+    stamp.position = static_cast<double>(stream_data->ring->get_write_position());
+    // not every host api reports the capture time, the time of the callback is close enough then
+    stamp.time = timeInfo->inputBufferAdcTime > 0.0 ? timeInfo->inputBufferAdcTime
+                                                     : timeInfo->currentTime;
+    if (stream_data->ring->write(float_input, frameSamples))
+      stream_data->stamps->try_push(stamp);
   }
 
   // make sure the compiler shuts up about unused variables
   static_cast<void>(output);
-  static_cast<void>(timeInfo);
   static_cast<void>(statusFlags);
   return 0;
 }
+
+// frames a device ring holds at least, in multiples of the frame size
+const int kRingFrames = 8;
+
+// longest wait for a frame before read() returns without data
+const int kFrameTimeout = 1000;
+
+// capture stamps a device queues until read() collects them
+const size_t kStampCapacity = 1024;
 }  // namespace
 
 yarp::os::Bottle MicrophoneInputStrategy::read(yarp::os::Bottle *bottle) {
@@ -89,8 +92,13 @@ yarp::os::Bottle MicrophoneInputStrategy::read(yarp::os::Bottle *bottle) {
       // Initialize Stream Data
       MicrophoneStreamData *stream_data = new MicrophoneStreamData;
       stream_data->channel_number = microphone_device.channels;
-      stream_data->values.resize(
-          static_cast<uint64_t>(microphone_device.channels));
+      // room for several frames, so a late consumer does not lose periods right away
+      size_t ring_frames = static_cast<size_t>(
+          std::max(kRingFrames * settings_.frame_size, 4 * settings_.period_size));
+      stream_data->ring.reset(
+          new utils::SampleRing(microphone_device.channels, ring_frames));
+      stream_data->stamps.reset(
+          new utils::SpscQueue<utils::CaptureStamp>(kStampCapacity));
 
       // Initialize Stream Parameters
       PaStreamParameters input_parameters;
@@ -117,7 +125,9 @@ yarp::os::Bottle MicrophoneInputStrategy::read(yarp::os::Bottle *bottle) {
           // We don't need any output, so we pass a null pointer
                              nullptr,
                              settings_.sample_rate,
-                             static_cast<uint64_t>(settings_.frame_size),
+                             settings_.period_size > 0 ?
+                                 static_cast<uint64_t>(settings_.period_size) :
+                                 paFramesPerBufferUnspecified,
                              flags,
                              PaStreamCallback,
                              stream_data);
@@ -129,6 +139,18 @@ yarp::os::Bottle MicrophoneInputStrategy::read(yarp::os::Bottle *bottle) {
       // Save streams and stream data objects
       streams_.push_back(stream);
       stream_datas_.push_back(stream_data);
+      rings_.push_back(stream_data->ring.get());
+    }
+
+    if (settings_.align) {
+      // removes the start offsets and the clock drift between the devices
+      std::vector<int> channels;
+      std::vector<int> delays;
+      for (const utils::MicrophoneDevice &device : microphone_devices_) {
+        channels.push_back(device.channels);
+        delays.push_back(device.delay);
+      }
+      aligner_.reset(new utils::StreamAligner(channels, delays, settings_.sample_rate));
     }
 
     // Try starting all streams roughly at the same time
@@ -137,33 +159,86 @@ yarp::os::Bottle MicrophoneInputStrategy::read(yarp::os::Bottle *bottle) {
     }
   }
 
-  // Check if all devices are ready for reading the data
-  bool all_devices_available = true;
-  for (auto stream_data : stream_datas_) {
-    if (!stream_data->has_written) {
-      all_devices_available = false;
-      break;
-    }
-  }
+  if (!read_frame())
+    return *bottle;
 
-  if (all_devices_available) {
+  if (settings_.edge_gcc) {
+    // only the lag vectors leave the capture node
+    utils::SignalView frame(frame_.data(), channels_, channels_,
+                            settings_.frame_size);
+    const std::vector<double> &lag_values = edge_gcc_.process(frame);
+    sim::write_lag_vectors(edge_gcc_.get_last_voice(), lag_values, bottle);
+  } else {
     // Add one sample from every channel at a time to the bottle
-    for (int sample_id = 0; sample_id < settings_.frame_size; ++sample_id) {
-      for (auto &stream_data : stream_datas_) {
-        for (int current_channel_id = 0;
-             current_channel_id < stream_data->channel_number;
-             ++current_channel_id) {
-          bottle->addDouble(stream_data->values[current_channel_id][sample_id]);
+    sim::write_samples(frame_.data(), frame_.size(), channels_,
+                       transport_, &packed_, bottle);
+  }
+  return *bottle;
+}
+
+bool MicrophoneInputStrategy::read_frame() {
+  size_t frame_size = static_cast<size_t>(settings_.frame_size);
+  frame_.resize(frame_size * channels_);
+  // poll about twice per period until every device delivered the whole frame
+  int poll_interval = std::max(1, settings_.period_size * 500 / settings_.sample_rate);
+  int waited = 0;
+  while (true) {
+    bool overrun = report_overruns();
+    if (aligner_) {
+      // lost samples no longer match their stamps
+      if (overrun)
+        aligner_->restart(rings_);
+      for (size_t device = 0; device < stream_datas_.size(); ++device) {
+        utils::CaptureStamp stamp;
+        while (stream_datas_[device]->stamps->try_pop(&stamp))
+          aligner_->add_stamp(static_cast<int>(device), stamp);
+      }
+      if (aligner_->read_frame(rings_, frame_size, frame_.data()))
+        return true;
+    } else {
+      bool all_devices_available = true;
+      for (auto ring : rings_) {
+        if (ring->get_available() < frame_size) {
+          all_devices_available = false;
+          break;
         }
       }
+      if (all_devices_available) {
+        // interleave the channels of all devices
+        int first_channel = 0;
+        for (auto ring : rings_) {
+          ring->read(frame_size, frame_.data() + first_channel, channels_);
+          first_channel += ring->get_channels();
+        }
+        return true;
+      }
     }
+    if (waited >= kFrameTimeout)
+      return false;
+    Pa_Sleep(poll_interval);
+    waited += poll_interval;
+  }
+}
 
-    // Mark all streams as ready to receive data again
-    for (auto &stream_data : stream_datas_) {
-      stream_data->has_written = false;
+bool MicrophoneInputStrategy::report_overruns() {
+  bool overrun = false;
+  for (auto stream_data : stream_datas_) {
+    uint64_t overruns = stream_data->ring->get_overruns();
+    if (overruns != stream_data->reported_overruns) {
+      std::cout << "Warning: " << overruns - stream_data->reported_overruns
+                << " audio periods dropped, " << overruns << " in total" << std::endl;
+      stream_data->reported_overruns = overruns;
+      overrun = true;
     }
   }
-  return *bottle;
+  return overrun;
+}
+
+uint64_t MicrophoneInputStrategy::get_overruns() const {
+  uint64_t overruns = 0;
+  for (auto stream_data : stream_datas_)
+    overruns += stream_data->ring->get_overruns();
+  return overruns;
 }
 
 bool MicrophoneInputStrategy::is_done() {
@@ -184,6 +259,7 @@ void MicrophoneInputStrategy::set_config(
   // Set Data fields
   settings_ = config_parser.get_microphone_input_configuration();
   microphone_devices_ = settings_.devices;
+  transport_ = config_parser.get_input_configuration().transport;
   channels_ = 0;
 
   // Acquire and display information about selected devices
@@ -209,6 +285,21 @@ void MicrophoneInputStrategy::set_config(
     if (!done_) {
       std::cout << "Channels in total: " << channels_ << std::endl;
     }
+
+    if (!done_ && settings_.edge_gcc) {
+      // the lag vectors depend on the geometry of the [audio] section
+      utils::AudioSettings audio = config_parser.get_audio_configuration();
+      if (static_cast<int>(audio.mic_x.size()) != channels_) {
+        std::cout << "Error: " << audio.mic_x.size() << " microphone positions for "
+                  << channels_ << " channels!" << std::endl;
+        done_ = true;
+      } else {
+        // decimated like the receiver does if a decimated_rate is configured
+        edge_gcc_.set_config(config_parser);
+        std::cout << "Streaming " << edge_gcc_.get_lag_vector_size()
+                  << " lag values per frame" << std::endl;
+      }
+    }
   } else {
     std::cout << "Error: No microphones defined!" << std::endl;
     done_ = true;
@@ -31,8 +31,14 @@ SOFTWARE.
 #define TAYLORTRACK_INPUT_MICROPHONE_INPUT_STRATEGY_H_
 
 #include <portaudio.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include "input/input_strategy.h"
+#include "localization/edge_gcc.h"
+#include "utils/sample_ring.h"
+#include "utils/spsc_queue.h"
+#include "utils/stream_aligner.h"
 namespace taylortrack {
 namespace input {
 /**
@@ -40,10 +46,16 @@ namespace input {
  */
 struct MicrophoneStreamData {
   /**
-   * @var values
-   * A vector of vectors containing the recorded sample for each channel
+   * @var ring
+   * Passes the recorded samples of all channels from the audio callback to read()
    */
-  std::vector<std::vector<double>> values;
+  std::unique_ptr<utils::SampleRing> ring;
+
+  /**
+   * @var stamps
+   * Passes the capture time of every recorded period from the audio callback to read()
+   */
+  std::unique_ptr<utils::SpscQueue<utils::CaptureStamp>> stamps;
 
   /**
    * @var channel_number
@@ -52,18 +64,21 @@ struct MicrophoneStreamData {
   int channel_number = 0;
 
   /**
-   * @var has_written
-   * Determines whether data has alsready been written into the values vectors.
-   * Values should only be written into when has_written is false and only be read when has_written is true.
-   * Otherwise it might cause race-conditions.
+   * @var reported_overruns
+   * Number of dropped periods already reported to the user
    */
-  bool has_written = false;
+  uint64_t reported_overruns = 0;
 };
 
 /**
  * @class MicrophoneInputStrategy
  * @brief Records Audio using the PortAudio Library
  *
+ * Each device records periods of period_size samples into its own lock-free ring, read() takes frames of
+ * frame_size samples out of all rings. Periods that do not fit into a full ring are dropped and reported.
+ * With align enabled the capture times of the periods are used to merge the devices sample aligned, see
+ * taylortrack::utils::StreamAligner, and the configured delays are applied.
+ *
  * @code
  * // Example usage:
  * // initialize a parameter object using default values
@@ -116,6 +131,8 @@ class MicrophoneInputStrategy : public InputStrategy {
    *
    * Will add sample values as doubles to the bottle. Each channel will write one sample in turns
    * until each channel has written the amount of samples specified when calling set_config.
+   * With edge_gcc enabled the bottle holds the lag vectors of the frame instead, see sim/lag_protocol.h.
+   * Blocks until every device recorded the frame, the bottle stays empty if that takes longer than a second.
    * @param bottle yarp::os::Bottle to write data into
    * @return Bottle supplied by parameter
    */
@@ -125,6 +142,28 @@ class MicrophoneInputStrategy : public InputStrategy {
 
   void set_config(const utils::ConfigParser &config_parser) override;
 
+  /**
+   * @brief read() waits for the devices, the streamer does not need to pause
+   * @return always true
+   */
+  bool is_paced() override {
+    return true;
+  }
+
+  /**
+   * @brief Returns the samples of the last frame
+   * @return interleaved samples of all devices, nullptr while lag vectors are streamed instead
+   */
+  const std::vector<double> *get_last_samples() override {
+    return settings_.edge_gcc ? nullptr : &frame_;
+  }
+
+  /**
+   * @brief Counts the audio periods dropped because read() did not keep up
+   * @return number of dropped periods of all devices
+   */
+  uint64_t get_overruns() const;
+
  private:
   // signals if all data has been transfered/read
   bool done_ = false;
@@ -141,10 +180,26 @@ class MicrophoneInputStrategy : public InputStrategy {
   std::vector<MicrophoneStreamData*> stream_datas_;
   // number of channels in the transmitted data
   int channels_ = 0;
+  // format of the samples sent to the audio tracking module
+  utils::SampleTransport transport_ = utils::SampleTransport::kBottle;
+  // packed samples of the last frame, kept to reuse the allocation
+  std::vector<char> packed_;
   // a vector of portaudio streams for all microphones
   std::vector<PaStream*> streams_;
   // signals if data is currently being transmitted
   bool running_ = false;
+  // computes the lag vectors of each frame if edge_gcc is enabled
+  localization::EdgeGcc edge_gcc_;
+  // interleaved samples of all devices of the current frame
+  std::vector<double> frame_;
+  // the ring of every device
+  std::vector<utils::SampleRing *> rings_;
+  // merges the devices sample aligned if align is enabled
+  std::unique_ptr<utils::StreamAligner> aligner_;
+  // waits for and interleaves the next frame of all devices into frame_, false on timeout
+  bool read_frame();
+  // reports periods dropped since the last call, true if there were any
+  bool report_overruns();
 };
 }  // namespace input
 }  // namespace taylortrack
@@ -28,44 +28,39 @@ SOFTWARE.
 */
 
 #include "input/read_file_input_strategy.h"
+#include <algorithm>
 
 namespace taylortrack {
 namespace input {
 
 yarp::os::Bottle ReadFileInputStrategy::read(yarp::os::Bottle *bottle) {
-  if (file_.is_open() && file_.tellg() != size_) {
-    char *memory_block = new char[package_size_];
-    file_.read(memory_block, package_size_);
-    bottle->addString(yarp::os::ConstString(memory_block, package_size_));
-    done_ = file_.eof() || file_.tellg() == size_;
+  if (file_ && file_->is_open() && position_ < file_->size()) {
+    // the chunk goes straight from the mapped file into the bottle
+    size_t chunk = std::min(package_size_, file_->size() - position_);
+    const char *data = reinterpret_cast<const char *>(file_->data()) + position_;
+    bottle->addString(yarp::os::ConstString(data, chunk));
+    position_ += chunk;
+    done_ = position_ >= file_->size();
+    file_->prefetch(position_, package_size_);
   } else {
     done_ = true;
   }
 
-  if (done_ && file_.is_open())
-    file_.close();
+  if (done_)
+    file_.reset();
 
   return *bottle;
 }
 
 bool ReadFileInputStrategy::is_done() {
-  return !file_ || done_;
+  return done_;
 }
 
 void ReadFileInputStrategy::set_parameters(const utils::Parameters &parameters) {
-  file_ = std::move(std::ifstream(parameters.file,
-                                  std::ios::in | std::ios::binary | std::ios::ate));
-
-  if (file_) {
-    // Determine the size of the file and initialise the char array for the data..
-    size_ = static_cast<int64_t>(file_.tellg());
-    file_.seekg(0, std::ios::beg);
-    package_size_ = (parameters.size == 0) ? size_ : parameters.size;
-  } else {
-    file_.close();
-  }
-
-  done_ = false;
+  file_.reset(new utils::MappedFile(parameters.file));
+  position_ = 0;
+  package_size_ = (parameters.size <= 0) ? file_->size() : static_cast<size_t>(parameters.size);
+  done_ = !file_->is_open();
 }
 
 void ReadFileInputStrategy::set_config(
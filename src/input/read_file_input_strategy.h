@@ -30,10 +30,11 @@ SOFTWARE.
 #ifndef TAYLORTRACK_INPUT_READ_FILE_INPUT_STRATEGY_H_
 #define TAYLORTRACK_INPUT_READ_FILE_INPUT_STRATEGY_H_
 #include <stdbool.h>
-#include <fstream>
-#include <iostream>
+#include <cstddef>
+#include <memory>
 #include "input/input_strategy.h"
 #include "utils/config_parser.h"
+#include "utils/mapped_file.h"
 #include "utils/parameters.h"
 namespace taylortrack {
 namespace input {
@@ -41,7 +42,8 @@ namespace input {
 * @class ReadFileInputStrategy
 * @brief Implements the read input from file strategy.
 *
-* Strategy which reads the simulation data from a given file and returns the entire file content at once.
+* Strategy which reads the simulation data from a given file and returns the entire file content at once,
+* or chunks of the given size. The file is memory mapped, so every chunk is copied only into its bottle.
 * @code
 * // Example usage:
 * // initiliaze a parameter object with the file to parse and a file size
@@ -90,8 +92,12 @@ class ReadFileInputStrategy : public InputStrategy {
  private:
   // signals if all data has been transfered/read
   bool done_ = true;
-  int64_t size_, package_size_;
-  std::ifstream file_;
+  // number of bytes per read
+  size_t package_size_ = 0;
+  // offset of the next unread byte
+  size_t position_ = 0;
+  // the mapped input file, released once all data has been read
+  std::unique_ptr<utils::MappedFile> file_;
 };
 }  // namespace input
 }  // namespace taylortrack
@@ -0,0 +1,90 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of taylortrack::input::ReplayInputStrategy class.
+*/
+#include "input/replay_input_strategy.h"
+#include <thread>
+#include "sim/frame_protocol.h"
+
+namespace taylortrack {
+namespace input {
+
+yarp::os::Bottle ReplayInputStrategy::read(yarp::os::Bottle *bottle) {
+  if (is_done())
+    return *bottle;
+  wait_for_frame();
+  reader_->read_frame(next_frame_, &samples_);
+  ++next_frame_;
+  // recordings keep no channel layout, it is taken from the configured microphones
+  int channels = channels_ > 0 && samples_.size() % channels_ == 0 ? channels_ : 1;
+  sim::write_samples(samples_.data(), samples_.size(), channels, transport_, &packed_, bottle);
+  return *bottle;
+}
+
+bool ReplayInputStrategy::is_done() {
+  return !reader_ || next_frame_ >= reader_->get_frame_count();
+}
+
+void ReplayInputStrategy::set_parameters(const utils::Parameters &parameters) {
+  reader_.reset(new utils::CaptureReader(parameters.file));
+  if (!reader_->is_valid())
+    std::cout << parameters.file << " is no recording of the streamer!" << std::endl;
+  else if (!reader_->is_complete())
+    std::cout << "Warning: " << parameters.file << " was not closed properly, replaying "
+              << reader_->get_frame_count() << " frames" << std::endl;
+  next_frame_ = 0;
+  first_frame_ = 0;
+}
+
+void ReplayInputStrategy::set_config(const utils::ConfigParser &config_parser) {
+  utils::ReplayInputSettings settings = config_parser.get_replay_input_configuration();
+  speed_ = settings.speed;
+  transport_ = config_parser.get_input_configuration().transport;
+  channels_ = static_cast<int>(config_parser.get_audio_configuration().mic_x.size());
+  if (reader_ && reader_->get_frame_count() > 0)
+    first_frame_ = reader_->seek(reader_->get_timestamp(0) + settings.start);
+  next_frame_ = first_frame_;
+}
+
+bool ReplayInputStrategy::is_paced() {
+  return true;
+}
+
+void ReplayInputStrategy::wait_for_frame() {
+  if (speed_ <= 0.0)
+    return;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (next_frame_ == first_frame_)
+    replay_start_ = now;
+
+  double seconds = (reader_->get_timestamp(next_frame_) - reader_->get_timestamp(first_frame_)) / speed_;
+  std::chrono::steady_clock::time_point due = replay_start_ +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(seconds));
+  std::this_thread::sleep_until(due);
+}
+}  // namespace input
+}  // namespace taylortrack
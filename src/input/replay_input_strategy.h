@@ -0,0 +1,125 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::input::ReplayInputStrategy class.
+*/
+
+#ifndef TAYLORTRACK_INPUT_REPLAY_INPUT_STRATEGY_H_
+#define TAYLORTRACK_INPUT_REPLAY_INPUT_STRATEGY_H_
+
+#include <yarp/os/all.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "input/input_strategy.h"
+#include "utils/capture_reader.h"
+#include "utils/config_parser.h"
+#include "utils/parameters.h"
+
+namespace taylortrack {
+namespace input {
+/**
+* @interface ReplayInputStrategy
+* @brief Replays a capture file recorded by the streamer.
+*
+* Returns a YARP bottle per recorded frame, consisting of its sample amplitude levels as float values. The
+* replay starts at the configured number of seconds into the recording and keeps the time between the frames as
+* they were recorded, scaled by the configured speed.
+* @code
+* // Example usage:
+* taylortrack::utils::Parameters params;
+* params.file = "session.ttcap";
+* taylortrack::utils::ConfigParser config("../conf/input.conf");
+*
+* taylortrack::input::ReplayInputStrategy strategy;
+* strategy.set_parameters(params);
+* strategy.set_config(config);
+* yarp::os::Bottle bottle;
+* strategy.read(&bottle);
+* @endcode
+*/
+class ReplayInputStrategy : public InputStrategy {
+ public:
+  /**
+  * @brief Reads the next recorded frame
+  * @param bottle YARP bottle to store the samples
+  * @pre is_done() returns false
+  * @return YARP bottle consisting of sample amplitude levels as float values
+  */
+  yarp::os::Bottle read(yarp::os::Bottle *bottle) override;
+
+  /**
+  * @brief Detects if all frames have been replayed.
+  * @return true at the end of the recording or if the file is no capture file
+  */
+  bool is_done() override;
+
+  void set_parameters(const taylortrack::utils::Parameters &parameters) override;
+
+  void set_config(const taylortrack::utils::ConfigParser &config_parser) override;
+
+  /**
+  * @brief Tells whether read() waits for the frames to be due
+  * @return true, read() waits itself or runs as fast as possible at speed 0
+  */
+  bool is_paced() override;
+
+  /**
+  * @brief Returns the samples of the last frame
+  * @return interleaved samples of the last read()
+  */
+  const std::vector<double> *get_last_samples() override {
+    return &samples_;
+  }
+
+ private:
+  // the opened recording
+  std::unique_ptr<taylortrack::utils::CaptureReader> reader_;
+  // samples of the last read, kept to reuse the allocation
+  std::vector<double> samples_;
+  // index of the next frame
+  size_t next_frame_ = 0;
+  // index of the frame the replay started with
+  size_t first_frame_ = 0;
+  // replay speed relative to the recording, 0 disables pacing
+  double speed_ = 1.0;
+  // format of the samples sent to the audio tracking module
+  utils::SampleTransport transport_ = utils::SampleTransport::kBottle;
+  // packed samples of the last frame, kept to reuse the allocation
+  std::vector<char> packed_;
+  // number of configured microphones, the channels of the replayed frames
+  int channels_ = 0;
+  // time the first frame was read
+  std::chrono::steady_clock::time_point replay_start_;
+
+  /**
+  * @brief Blocks until the next frame is due.
+  */
+  void wait_for_frame();
+};
+}  // namespace input
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_INPUT_REPLAY_INPUT_STRATEGY_H_
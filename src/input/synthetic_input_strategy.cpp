@@ -0,0 +1,119 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of taylortrack::input::SyntheticInputStrategy class.
+*/
+#include "input/synthetic_input_strategy.h"
+#include <cmath>
+#include <thread>
+#include "sim/frame_protocol.h"
+
+namespace taylortrack {
+namespace input {
+namespace {
+const double kPI = 3.14159265358979323846;
+}  // namespace
+
+yarp::os::Bottle SyntheticInputStrategy::read(yarp::os::Bottle *bottle) {
+  if (is_done())
+    return *bottle;
+
+  int64_t first = synthesizer_->get_position();
+  int64_t frames = frame_size_;
+  samples_.resize(static_cast<size_t>(frames * synthesizer_->get_channels()));
+  synthesizer_->synthesize(static_cast<size_t>(frames), samples_.data());
+  if (ground_truth_.is_open())
+    write_ground_truth(first, frames);
+  wait_for_frames();
+  sim::write_samples(samples_.data(), samples_.size(), synthesizer_->get_channels(),
+                     transport_, &packed_, bottle);
+  return *bottle;
+}
+
+bool SyntheticInputStrategy::is_done() {
+  if (!synthesizer_ || synthesizer_->get_channels() == 0 || frame_size_ <= 0)
+    return true;
+  return total_frames_ > 0 && synthesizer_->get_position() >= total_frames_;
+}
+
+void SyntheticInputStrategy::set_parameters(const utils::Parameters &parameters) {
+  parameter_ = parameters;
+}
+
+void SyntheticInputStrategy::set_config(const utils::ConfigParser &config_parser) {
+  utils::AudioSettings audio_settings = config_parser.get_audio_configuration();
+  utils::SyntheticInputSettings settings = config_parser.get_synthetic_input_configuration();
+  synthesizer_.reset(new sim::SceneSynthesizer(audio_settings, settings));
+  // an explicit size on the command line keeps precedence over the configured frames
+  frame_size_ = parameter_.size > 0 ? parameter_.size : settings.frame_size;
+  total_frames_ = static_cast<int64_t>(std::ceil(settings.duration * audio_settings.sample_rate));
+  speed_ = settings.speed;
+  transport_ = config_parser.get_input_configuration().transport;
+
+  if (ground_truth_.is_open())
+    ground_truth_.close();
+  if (!settings.ground_truth.empty()) {
+    ground_truth_.open(settings.ground_truth.c_str(), std::ios::out | std::ios::trunc);
+    if (!ground_truth_)
+      std::cout << "Ground truth file " << settings.ground_truth << " could not be opened!" << std::endl;
+  }
+}
+
+bool SyntheticInputStrategy::is_paced() {
+  return true;
+}
+
+void SyntheticInputStrategy::wait_for_frames() {
+  if (speed_ <= 0.0)
+    return;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  int64_t streamed_frames = synthesizer_->get_position();
+  if (streamed_frames == frame_size_)
+    stream_start_ = now;
+
+  // a live recording delivers a frame once its last sample has been captured
+  double seconds = streamed_frames / (synthesizer_->get_sample_rate() * speed_);
+  std::chrono::steady_clock::time_point due = stream_start_ +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(seconds));
+  std::this_thread::sleep_until(due);
+}
+
+void SyntheticInputStrategy::write_ground_truth(int64_t first, int64_t frames) {
+  int64_t middle = first + frames / 2;
+  double time = static_cast<double>(middle) / synthesizer_->get_sample_rate();
+  ground_truth_ << middle << ' ' << time;
+  for (size_t source = 0; source < synthesizer_->get_source_count(); ++source) {
+    double x = 0.0;
+    double y = 0.0;
+    synthesizer_->get_source_position(source, time, &x, &y);
+    // counted like the degrees the localization reports
+    double degree = std::fmod(std::atan2(y, x) * 180.0 / kPI + 360.0, 360.0);
+    ground_truth_ << ' ' << x << ' ' << y << ' ' << degree;
+  }
+  ground_truth_ << '\n';
+}
+}  // namespace input
+}  // namespace taylortrack
@@ -0,0 +1,137 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::input::SyntheticInputStrategy class.
+*/
+
+#ifndef TAYLORTRACK_INPUT_SYNTHETIC_INPUT_STRATEGY_H_
+#define TAYLORTRACK_INPUT_SYNTHETIC_INPUT_STRATEGY_H_
+
+#include <yarp/os/all.h>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include "input/input_strategy.h"
+#include "sim/scene_synthesizer.h"
+#include "utils/config_parser.h"
+#include "utils/parameters.h"
+
+namespace taylortrack {
+namespace input {
+/**
+* @interface SyntheticInputStrategy
+* @brief Synthesizes what the configured microphone array records from moving sound sources.
+*
+* Returns a YARP bottle consisting of frame_size interleaved frames of all microphones of the [audio] section,
+* synthesized by a taylortrack::sim::SceneSynthesizer from the [synthetic input] section. Needs no audio
+* hardware and no recordings. Reading is paced by the sample rate times the configured speed, at speed 0 the
+* frames are synthesized as fast as possible. The source positions of every frame can be written to a ground
+* truth file, one line per frame with the index and time of its middle sample followed by x, y and the angle
+* in degrees of every source.
+* @code
+* // Example usage:
+* taylortrack::utils::Parameters params;
+* taylortrack::utils::ConfigParser config("../conf/input.conf");
+*
+* taylortrack::input::SyntheticInputStrategy strategy;
+* strategy.set_parameters(params);
+* strategy.set_config(config);
+* yarp::os::Bottle bottle;
+* strategy.read(&bottle);
+* @endcode
+*/
+class SyntheticInputStrategy : public InputStrategy {
+ public:
+  /**
+  * @brief Synthesizes the next frame
+  * @param bottle YARP bottle to store the samples
+  * @pre is_done() returns false
+  * @return YARP bottle consisting of sample amplitude levels as float values
+  */
+  yarp::os::Bottle read(yarp::os::Bottle *bottle) override;
+
+  /**
+  * @brief Detects if the configured duration has been synthesized.
+  * @return true once the duration is reached or if no config was set
+  */
+  bool is_done() override;
+
+  void set_parameters(const taylortrack::utils::Parameters &parameters) override;
+
+  void set_config(const taylortrack::utils::ConfigParser &config_parser) override;
+
+  /**
+  * @brief Tells whether read() waits for the frames to be due
+  * @return true, read() waits itself or runs as fast as possible at speed 0
+  */
+  bool is_paced() override;
+
+  /**
+  * @brief Returns the samples of the last frame
+  * @return interleaved samples of the last read()
+  */
+  const std::vector<double> *get_last_samples() override {
+    return &samples_;
+  }
+
+ private:
+  // a struct containing the input and output port and other relevant parameters for the data stream
+  taylortrack::utils::Parameters parameter_;
+  // computes the microphone signals, created by set_config()
+  std::unique_ptr<sim::SceneSynthesizer> synthesizer_;
+  // samples of the last read, kept to reuse the allocation
+  std::vector<double> samples_;
+  // frames per channel of each read
+  int64_t frame_size_ = 0;
+  // frames to synthesize in total, 0 for no end
+  int64_t total_frames_ = 0;
+  // streaming speed relative to the sample rate, 0 disables pacing
+  double speed_ = 0.0;
+  // format of the samples sent to the audio tracking module
+  utils::SampleTransport transport_ = utils::SampleTransport::kBottle;
+  // packed samples of the last frame, kept to reuse the allocation
+  std::vector<char> packed_;
+  // time the first frame was read
+  std::chrono::steady_clock::time_point stream_start_;
+  // receives the source positions of every frame if configured
+  std::ofstream ground_truth_;
+
+  /**
+  * @brief Blocks until all frames synthesized so far are due.
+  */
+  void wait_for_frames();
+
+  /**
+  * @brief Writes the source positions at the middle of a frame to the ground truth file.
+  * @param first index of the first frame
+  * @param frames number of frames
+  */
+  void write_ground_truth(int64_t first, int64_t frames);
+};
+}  // namespace input
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_INPUT_SYNTHETIC_INPUT_STRATEGY_H_
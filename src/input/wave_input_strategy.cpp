@@ -27,7 +27,9 @@ SOFTWARE.
 * @brief Implementation of taylortrack::input::WaveInputStrategy class.
 */
 #include "input/wave_input_strategy.h"
-#include <string>
+#include <chrono>
+#include <thread>
+#include "sim/frame_protocol.h"
 
 namespace taylortrack {
 namespace input {
@@ -46,34 +48,23 @@ WaveInputStrategy::~WaveInputStrategy() {
 
 yarp::os::Bottle WaveInputStrategy::read(yarp::os::Bottle *bottle) {
   if (waveParser_ && waveParser_->is_valid() && !waveParser_->is_done()) {
-    if (waveParser_->get_bits_per_sample() == 16) {
-      int64_t sample_amount = 0;
-      if (parameter_.size <= 0) {
+    if (waveParser_->is_decodable()) {
+      int64_t sample_amount = frame_size_;
+      if (sample_amount <= 0)
         sample_amount = waveParser_->get_sample_num();
-      } else {
-        sample_amount = parameter_.size;
-      }
-      std::string samples = waveParser_->get_samples(sample_amount);
-      int64_t sample_number = static_cast<int64_t>(samples.size()
-          / (waveParser_->get_bits_per_sample() / 8));
-      int64_t sample_size = waveParser_->get_block_align()
-          / waveParser_->get_num_channels();
-
-      // Convert to Floats, change endian
-      for (int i = 0; i < sample_number; ++i) {
-        int16_t temporary_value = 0;
-        for (int j = waveParser_->get_bits_per_sample() - 8; j >= 0; j -= 8) {
-          int64_t samplePosition = i * sample_size + (j / 8);
-          int64_t sample = static_cast<unsigned char>(samples[samplePosition]);
-          int64_t shift_distance = j;
-          temporary_value |= (sample << shift_distance);
-        }
-        double cfloat = temporary_value / 32767.0;
-        bottle->addDouble(cfloat);
+      // decoded straight from the mapped file in a single pass
+      int64_t frames = waveParser_->get_decoded_frames(sample_amount, &samples_);
+      if (pad_frames_ && frames < sample_amount) {
+        // the receiver expects complete frames, the end of the file is filled with silence
+        samples_.resize(static_cast<size_t>(sample_amount * waveParser_->get_num_channels()), 0.0);
+        frames = sample_amount;
       }
+      wait_for_frames(frames);
+      sim::write_samples(samples_.data(), samples_.size(), waveParser_->get_num_channels(),
+                         transport_, &packed_, bottle);
     } else {
       std::cout <<
-          "Currently only wave files with 16 bits per sample are supported!"
+          "Only wave files with 8, 16, 24 or 32 bit PCM or 32 bit float samples are supported!"
           << std::endl;
       this->error_ = true;
     }
@@ -81,14 +72,45 @@ yarp::os::Bottle WaveInputStrategy::read(yarp::os::Bottle *bottle) {
   return *bottle;
 }
 
+void WaveInputStrategy::wait_for_frames(int64_t frames) {
+  if (speed_ <= 0.0)
+    return;
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (streamed_frames_ == 0)
+    stream_start_ = now;
+  streamed_frames_ += frames;
+
+  // a live recording delivers a frame once its last sample has been captured
+  double seconds = streamed_frames_ / (waveParser_->get_sample_rate() * speed_);
+  std::chrono::steady_clock::time_point due = stream_start_ +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(seconds));
+  std::this_thread::sleep_until(due);
+}
+
 void WaveInputStrategy::set_parameters(const utils::Parameters &parameters) {
   parameter_ = parameters;
   waveParser_ = new taylortrack::utils::WaveParser(parameters.file);
   error_ = false;
+  frame_size_ = parameters.size;
+  pad_frames_ = false;
+  streamed_frames_ = 0;
 }
 
 void WaveInputStrategy::set_config(const utils::ConfigParser &config_parser) {
-  // ignored for now
+  utils::WaveInputSettings settings = config_parser.get_wave_input_configuration();
+  // an explicit size on the command line keeps precedence over the configured frames
+  if (parameter_.size <= 0) {
+    frame_size_ = settings.frame_size;
+    pad_frames_ = true;
+  }
+  speed_ = settings.speed;
+  streamed_frames_ = 0;
+  transport_ = config_parser.get_input_configuration().transport;
+}
+
+bool WaveInputStrategy::is_paced() {
+  return speed_ > 0.0;
 }
 
 }  // namespace input
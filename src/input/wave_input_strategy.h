@@ -31,6 +31,8 @@ SOFTWARE.
 #define TAYLORTRACK_INPUT_WAVE_INPUT_STRATEGY_H_
 
 #include <yarp/os/all.h>
+#include <chrono>
+#include <vector>
 #include "input/input_strategy.h"
 #include "utils/config_parser.h"
 #include "utils/parameters.h"
@@ -43,7 +45,11 @@ namespace input {
 * @interface WaveInputStrategy
 * @brief Reads a wave file and processes it to a format readable by the tracking algorithm.
 *
-* Returns a YARP bottle consisting of sample amplitude levels as float values
+* Returns a YARP bottle consisting of sample amplitude levels as float values.
+* Once configured, every bottle holds exactly frame_size interleaved frames of all channels, the end of the file is
+* filled with silence. Reading is paced by the sample rate of the file times the configured speed on a monotonic
+* clock, so a recording arrives like it would from the microphones. A size given on the command line replaces
+* the configured frame size and sends the end of the file as it is.
 * @code
 * // Example usage:
 * // initialize a parameter object using default values
@@ -65,7 +71,7 @@ namespace input {
 *  std::cout << bottle.get(i).asDouble() << std::endl;
 * }
 * @endcode
-* @warning Only supports Wave files with 16 Bits per sample at the moment!
+* @warning Only supports Wave files with 8, 16, 24 or 32 bit PCM or 32 bit float samples!
 */
 class WaveInputStrategy : public InputStrategy {
  public:
@@ -104,6 +110,20 @@ class WaveInputStrategy : public InputStrategy {
 
   void set_config(const taylortrack::utils::ConfigParser &config_parser) override;
 
+  /**
+  * @brief Tells whether read() waits for the frames to be due
+  * @return true unless the configured speed is 0
+  */
+  bool is_paced() override;
+
+  /**
+  * @brief Returns the samples of the last frame
+  * @return interleaved samples of the last read()
+  */
+  const std::vector<double> *get_last_samples() override {
+    return &samples_;
+  }
+
  private:
   // a struct containing the input and output port and other relevant parameters for the data stream
   taylortrack::utils::Parameters parameter_;
@@ -111,6 +131,28 @@ class WaveInputStrategy : public InputStrategy {
   taylortrack::utils::WaveParser *waveParser_ = nullptr;
   // signals if an error happened during data transmission
   bool error_ = false;
+  // decoded samples of the last read, kept to reuse the allocation
+  std::vector<double> samples_;
+  // frames per channel of each read, the whole file if not positive
+  int64_t frame_size_ = 0;
+  // signals whether the last frame is filled up to frame_size_
+  bool pad_frames_ = false;
+  // replay speed relative to the sample rate, 0 disables pacing
+  double speed_ = 0.0;
+  // format of the samples sent to the audio tracking module
+  utils::SampleTransport transport_ = utils::SampleTransport::kBottle;
+  // packed samples of the last frame, kept to reuse the allocation
+  std::vector<char> packed_;
+  // frames handed out since streaming started
+  int64_t streamed_frames_ = 0;
+  // time the first frame was read
+  std::chrono::steady_clock::time_point stream_start_;
+
+  /**
+  * @brief Blocks until the given frames following the previous ones are due.
+  * @param frames number of frames per channel of the current read
+  */
+  void wait_for_frames(int64_t frames);
 };
 }  // namespace input
 }  // namespace taylortrack
@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the azimuth tracker.
+*/
+#include "localization/azimuth_tracker.h"
+#include <cmath>
+
+namespace taylortrack {
+namespace localization {
+namespace {
+// wraps an angle into [0, 360)
+double wrap_angle(double angle) {
+  double wrapped = std::fmod(angle, 360.0);
+  return wrapped < 0.0 ? wrapped + 360.0 : wrapped;
+}
+}  // namespace
+
+double angle_difference(double to, double from) {
+  double difference = wrap_angle(to - from);
+  return difference > 180.0 ? difference - 360.0 : difference;
+}
+
+AzimuthTracker::AzimuthTracker(double alpha, double beta)
+    : alpha_(alpha), beta_(beta) {
+}
+
+void AzimuthTracker::update(double angle) {
+  if (!initialized_) {
+    angle_ = wrap_angle(angle);
+    rate_ = 0.0;
+    initialized_ = true;
+    return;
+  }
+  double predicted = angle_ + rate_;
+  double residual = angle_difference(angle, predicted);
+  angle_ = wrap_angle(predicted + alpha_ * residual);
+  rate_ += beta_ * residual;
+}
+
+double AzimuthTracker::predict() const {
+  return wrap_angle(angle_ + rate_);
+}
+
+void AzimuthTracker::reset() {
+  angle_ = 0.0;
+  rate_ = 0.0;
+  initialized_ = false;
+}
+}  // namespace localization
+}  // namespace taylortrack
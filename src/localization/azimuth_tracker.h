@@ -0,0 +1,113 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Alpha beta filter following the azimuth of a speaker.
+*/
+#ifndef TAYLORTRACK_LOCALIZATION_AZIMUTH_TRACKER_H_
+#define TAYLORTRACK_LOCALIZATION_AZIMUTH_TRACKER_H_
+
+namespace taylortrack {
+namespace localization {
+/**
+* @class AzimuthTracker
+* @brief Alpha beta filter over the azimuth in degrees, aware of the wrap around at 360 degrees.
+*
+* Keeps an angle and an angular rate per frame. Each measurement corrects the prediction by alpha
+* times the residual and the rate by beta times the residual.
+* @code
+*  //Example usage:
+*  taylortrack::localization::AzimuthTracker tracker(0.5, 0.05);
+*  tracker.update(srp.get_last_position());
+*  // expected azimuth of the next frame
+*  double angle = tracker.predict();
+* @endcode
+*/
+class AzimuthTracker {
+ public:
+  /**
+   * @brief Constructor
+   * @param alpha gain of the angle correction, between 0 and 1
+   * @param beta gain of the rate correction, between 0 and 1
+   */
+  explicit AzimuthTracker(double alpha = 0.5, double beta = 0.05);
+
+  /**
+   * @brief Feeds the measured azimuth of the current frame.
+   * @param angle measured azimuth in degrees
+   */
+  void update(double angle);
+
+  /**
+   * @brief Returns the expected azimuth of the next frame.
+   * @return predicted azimuth in degrees within [0, 360)
+   */
+  double predict() const;
+
+  /**
+   * @brief Forgets the current track.
+   */
+  void reset();
+
+  /**
+   * @brief Checks whether at least one measurement has been fed.
+   * @return true if a track exists, false otherwise.
+   */
+  bool is_initialized() const {
+    return initialized_;
+  }
+
+  /**
+   * @brief Returns the angular rate of the track.
+   * @return rate in degrees per frame
+   */
+  double get_rate() const {
+    return rate_;
+  }
+
+ private:
+  // gain of the angle correction
+  double alpha_;
+  // gain of the rate correction
+  double beta_;
+  // filtered azimuth of the last frame in degrees
+  double angle_ = 0.0;
+  // filtered angular rate in degrees per frame
+  double rate_ = 0.0;
+  // set by the first measurement
+  bool initialized_ = false;
+};
+
+/**
+ * @brief Returns the signed difference between two angles.
+ * @param to angle in degrees
+ * @param from angle in degrees
+ * @return to - from wrapped into (-180, 180]
+ */
+double angle_difference(double to, double from);
+}  // namespace localization
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_LOCALIZATION_AZIMUTH_TRACKER_H_
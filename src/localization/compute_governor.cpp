@@ -0,0 +1,101 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the compute governor.
+*/
+#include "localization/compute_governor.h"
+#include <algorithm>
+#include <vector>
+
+namespace taylortrack {
+namespace localization {
+namespace {
+// weight of the newest frame in the smoothed load
+const double kSmoothing = 0.2;
+// frames to wait after a level change before judging the new level
+const int kSettleFrames = 5;
+// consecutive frames below the headroom limit needed to step up
+const int kHeadroomFrames = 50;
+// fraction of the budget below which a more expensive level is tried
+const double kHeadroom = 0.4;
+}  // namespace
+
+ComputeGovernor::ComputeGovernor(const utils::AudioSettings &settings,
+                                 double budget)
+    : budget_(budget),
+      frame_period_(static_cast<double>(settings.frame_size) /
+                    settings.sample_rate) {
+  ladder_.push_back(settings);
+
+  // half the grid resolution
+  utils::AudioSettings coarse_grid = ladder_.back();
+  coarse_grid.interval *= 2.0;
+  ladder_.push_back(coarse_grid);
+
+  // half the microphone pairs
+  int microphones = static_cast<int>(settings.mic_x.size());
+  int pairs = microphones * (microphones - 1) / 2;
+  if (settings.max_pairs > 0)
+    pairs = std::min(pairs, settings.max_pairs);
+  if (pairs > 2) {
+    utils::AudioSettings fewer_pairs = ladder_.back();
+    fewer_pairs.max_pairs = (pairs + 1) / 2;
+    if (fewer_pairs.pair_selection == utils::PairSelectionPolicy::kAll)
+      fewer_pairs.pair_selection = utils::PairSelectionPolicy::kTopK;
+    ladder_.push_back(fewer_pairs);
+  }
+
+  // speech band up to 4 kHz only
+  utils::AudioSettings narrow_band = ladder_.back();
+  narrow_band.band_low = std::max(narrow_band.band_low, 300.0);
+  narrow_band.band_high = narrow_band.band_high > 0.0 ?
+                          std::min(narrow_band.band_high, 4000.0) : 4000.0;
+  ladder_.push_back(narrow_band);
+}
+
+bool ComputeGovernor::report(double seconds) {
+  double load = seconds / frame_period_;
+  load_ = frames_at_level_ == 0 ? load :
+          (1.0 - kSmoothing) * load_ + kSmoothing * load;
+  ++frames_at_level_;
+  headroom_frames_ = load_ < kHeadroom * budget_ ? headroom_frames_ + 1 : 0;
+  if (frames_at_level_ < kSettleFrames)
+    return false;
+
+  int level = level_;
+  if (load_ > budget_ && level_ < get_level_count() - 1)
+    ++level;
+  else if (headroom_frames_ >= kHeadroomFrames && level_ > 0)
+    --level;
+  if (level == level_)
+    return false;
+  level_ = level;
+  frames_at_level_ = 0;
+  headroom_frames_ = 0;
+  return true;
+}
+}  // namespace localization
+}  // namespace taylortrack
@@ -0,0 +1,145 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Quality of service governor trading localization resolution for processing time.
+*/
+#ifndef TAYLORTRACK_LOCALIZATION_COMPUTE_GOVERNOR_H_
+#define TAYLORTRACK_LOCALIZATION_COMPUTE_GOVERNOR_H_
+
+#include <vector>
+#include "utils/config.h"
+
+namespace taylortrack {
+namespace localization {
+/**
+* @class ComputeGovernor
+* @brief Chooses a level from a ladder of increasingly cheaper audio settings based on the measured processing time.
+*
+* Level 0 are the configured settings. Every further level halves the grid resolution, the number of microphone
+* pairs or the evaluated frequency band of the previous one. The governor compares a smoothed processing time with
+* the frame period (frame_size / sample_rate), steps down when the budget is exceeded and steps back up after a
+* while with enough headroom.
+* @code
+*  //Example usage:
+*  taylortrack::localization::ComputeGovernor governor(audio);
+*  // one algorithm instance with precomputed tables per level
+*  std::vector<taylortrack::localization::SrpPhat> ladder(governor.get_level_count());
+*  ...
+*  // after each frame
+*  int previous = governor.get_level();
+*  if (governor.report(processing_seconds))
+*    ladder[governor.get_level()].continue_from(ladder[previous]);
+*  taylortrack::localization::SrpPhat &algorithm = ladder[governor.get_level()];
+* @endcode
+*/
+class ComputeGovernor {
+ public:
+  /**
+   * @brief Builds the ladder of settings.
+   * @param settings configured audio settings used for level 0
+   * @param budget fraction of the frame period the processing may take
+   */
+  explicit ComputeGovernor(const utils::AudioSettings &settings,
+                           double budget = 0.8);
+
+  /**
+   * @brief Reports the processing time of the last frame and adapts the level.
+   * @param seconds time spent on the last frame
+   * @return true if the level changed, false otherwise.
+   */
+  bool report(double seconds);
+
+  /**
+   * @brief Returns the current level.
+   * @return level between 0 (configured settings) and get_level_count() - 1
+   */
+  int get_level() const {
+    return level_;
+  }
+
+  /**
+   * @brief Returns the number of levels.
+   * @return length of the ladder
+   */
+  int get_level_count() const {
+    return static_cast<int>(ladder_.size());
+  }
+
+  /**
+   * @brief Returns the audio settings of a level.
+   * @param level level between 0 and get_level_count() - 1
+   * @return settings of that level
+   */
+  const utils::AudioSettings &get_level_settings(int level) const {
+    return ladder_[level];
+  }
+
+  /**
+   * @brief Returns the smoothed processing time relative to the frame period.
+   * @return load, 1 means the processing takes exactly one frame period
+   */
+  double get_load() const {
+    return load_;
+  }
+
+  /**
+   * @brief Returns the time between two frames.
+   * @return frame period in seconds
+   */
+  double get_frame_period() const {
+    return frame_period_;
+  }
+
+  /**
+   * @brief Checks whether even the cheapest level exceeds the budget.
+   *
+   * Queued frames should be dropped in this case to keep the latency bounded.
+   * @return true if the governor cannot step down any further, false otherwise.
+   */
+  bool is_saturated() const {
+    return level_ == get_level_count() - 1 && load_ > budget_;
+  }
+
+ private:
+  // settings of each level, level 0 is the configured one
+  std::vector<utils::AudioSettings> ladder_;
+  // fraction of the frame period the processing may take
+  double budget_;
+  // time between two frames in seconds
+  double frame_period_;
+  // current level
+  int level_ = 0;
+  // exponentially smoothed processing time relative to the frame period
+  double load_ = 0.0;
+  // frames since the last level change
+  int frames_at_level_ = 0;
+  // consecutive frames with enough headroom to step up
+  int headroom_frames_ = 0;
+};
+}  // namespace localization
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_LOCALIZATION_COMPUTE_GOVERNOR_H_
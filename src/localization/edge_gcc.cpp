@@ -0,0 +1,57 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the lag vectors computed on the capture node.
+*/
+#include "localization/edge_gcc.h"
+
+namespace taylortrack {
+namespace localization {
+void EdgeGcc::set_config(const utils::ConfigParser &config) {
+  utils::AudioSettings audio = config.get_audio_configuration();
+  srp_.set_config(config);
+  vad_.set_threshold(audio.vad_threshold);
+  resampler_.reset();
+  if (audio.decimated_rate > 0 && audio.decimated_rate < audio.sample_rate)
+    resampler_.reset(new utils::PolyphaseResampler(audio.sample_rate, audio.decimated_rate,
+                                                   static_cast<int>(audio.mic_x.size())));
+  last_voice_ = false;
+}
+
+const std::vector<double> &EdgeGcc::process(const utils::SignalView &frame) {
+  utils::SignalView localized = frame;
+  if (resampler_) {
+    // the tables of the receiver are built for the decimated rate
+    resampler_->process(frame, &decimated_);
+    localized = utils::SignalView(decimated_.data(), frame.channels, frame.channels,
+                                  static_cast<int64_t>(decimated_.size()) / frame.channels);
+  }
+  last_voice_ = vad_.detect(localized);
+  lag_values_ = srp_.get_lag_vectors(localized);
+  return lag_values_;
+}
+}  // namespace localization
+}  // namespace taylortrack
@@ -0,0 +1,105 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Lag vectors computed on the capture node for the audio tracking module.
+*/
+#ifndef TAYLORTRACK_LOCALIZATION_EDGE_GCC_H_
+#define TAYLORTRACK_LOCALIZATION_EDGE_GCC_H_
+
+#include <memory>
+#include <vector>
+#include "localization/srp_phat.h"
+#include "utils/config_parser.h"
+#include "utils/polyphase_resampler.h"
+#include "utils/signal_view.h"
+#include "utils/vad_simple.h"
+
+namespace taylortrack {
+namespace localization {
+/**
+* @class EdgeGcc
+* @brief Turns captured frames into the lag vectors the audio tracking module projects onto its grid.
+*
+* Mirrors the receiving side: with a decimated_rate in the [audio] section the frames are decimated first, so the
+* lag vectors belong to the same sample rate as the lookup tables of the receiver. The voice activity is decided
+* on the same frame with the same threshold the receiver applies to sample frames.
+* @code
+*  //Example usage:
+*  taylortrack::localization::EdgeGcc edge;
+*  edge.set_config(config);
+*  const std::vector<double> &lag_values = edge.process(frame);
+*  taylortrack::sim::write_lag_vectors(edge.get_last_voice(), lag_values, &bottle);
+* @endcode
+*/
+class EdgeGcc {
+ public:
+  /**
+   * @brief Sets up the localization and the decimation from the [audio] section.
+   * @param config configuration shared with the audio tracking module
+   */
+  void set_config(const utils::ConfigParser &config);
+
+  /**
+   * @brief Computes the lag vectors of the next captured frame.
+   * @param frame interleaved frame at the capture rate, one channel per microphone
+   * @return the lag values of all pairs, valid until the next call
+   */
+  const std::vector<double> &process(const utils::SignalView &frame);
+
+  /**
+   * @brief Returns whether the last frame contained speech.
+   * @return true if the energy of the last frame reached the threshold
+   */
+  bool get_last_voice() const {
+    return last_voice_;
+  }
+
+  /**
+   * @brief Returns the number of values process() produces per frame.
+   * @return number of distinct grid lags summed over all microphone pairs
+   */
+  int get_lag_vector_size() const {
+    return srp_.get_lag_vector_size();
+  }
+
+ private:
+  // computes the lag vectors, configured like level 0 of the receiver
+  SrpPhat srp_;
+  // voice activity of the frames
+  utils::VadSimple vad_ = utils::VadSimple(0.0000007);
+  // decimates the frames if a decimated_rate is configured, keeps its state between frames
+  std::unique_ptr<utils::PolyphaseResampler> resampler_;
+  // decimated samples of the last frame
+  std::vector<double> decimated_;
+  // lag values of the last frame
+  std::vector<double> lag_values_;
+  // whether the last frame contained speech
+  bool last_voice_ = false;
+};
+}  // namespace localization
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_LOCALIZATION_EDGE_GCC_H_
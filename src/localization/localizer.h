@@ -5,6 +5,7 @@
 #include <vector>
 #include "utils/config.h"
 #include "utils/config_parser.h"
+#include "utils/signal_view.h"
 
 namespace taylortrack {
   namespace localization {
@@ -30,6 +31,13 @@ namespace taylortrack {
       */
       virtual RArray get_position_distribution(const std::vector<RArray> &signals) = 0;
 
+      /**
+      * @brief Returns a probability distribution for the position of the speaker over all degrees
+      * @param  frame a view on an interleaved frame containing one channel per microphone
+      * @return A RArray with all probability values
+      */
+      virtual RArray get_position_distribution(const utils::SignalView &frame) = 0;
+
       /**
       * @brief Sets all relevant parameters of the implemented algorithm. Missing Parameters have to be placed inside
       *        the AudioSettings struct.
@@ -0,0 +1,94 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the shared localization engine.
+*/
+#include "localization/srp_engine.h"
+#include <algorithm>
+
+namespace taylortrack {
+namespace localization {
+SrpEngine::SrpEngine(int threads)
+    : pool_(std::make_shared<utils::ThreadPool>(threads)) {
+}
+
+std::shared_ptr<utils::FftPlan> SrpEngine::get_fft_plan(size_t length) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<utils::FftPlan> &plan = fft_plans_[length];
+  if (!plan)
+    plan = std::make_shared<utils::FftPlan>(length);
+  return plan;
+}
+
+std::shared_ptr<const SrpTables> SrpEngine::get_tables(
+    const std::string &key,
+    const std::function<std::shared_ptr<const SrpTables>()> &build) {
+  // building under the lock keeps two sessions with the same geometry
+  // from building the same tables twice
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<const SrpTables> &tables = tables_[key];
+  if (!tables)
+    tables = build();
+  return tables;
+}
+
+size_t SrpEngine::get_table_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tables_.size();
+}
+
+int SrpEngine::add_session(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  session_names_.push_back(name);
+  latencies_.push_back(LatencyStats());
+  return static_cast<int>(session_names_.size()) - 1;
+}
+
+int SrpEngine::get_session_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(session_names_.size());
+}
+
+std::string SrpEngine::get_session_name(int session) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return session_names_.at(static_cast<size_t>(session));
+}
+
+void SrpEngine::report_latency(int session, double seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LatencyStats &stats = latencies_.at(static_cast<size_t>(session));
+  ++stats.frames;
+  stats.last = seconds;
+  stats.mean += (seconds - stats.mean) / stats.frames;
+  stats.maximum = std::max(stats.maximum, seconds);
+}
+
+LatencyStats SrpEngine::get_latency(int session) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latencies_.at(static_cast<size_t>(session));
+}
+}  // namespace localization
+}  // namespace taylortrack
@@ -0,0 +1,266 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Resources shared by the localizers of several microphone arrays in one process.
+*/
+#ifndef TAYLORTRACK_LOCALIZATION_SRP_ENGINE_H_
+#define TAYLORTRACK_LOCALIZATION_SRP_ENGINE_H_
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/fft_plan.h"
+#include "utils/thread_pool.h"
+
+namespace taylortrack {
+namespace localization {
+/**
+* @struct SrpTables
+* @brief Lookup tables of SrpPhat which only depend on the array geometry, the grid, the sample rate and the frame size.
+*
+* Grid point (slice * grid size + x) * grid size + y lies in the horizontal grid slice with index slice.
+*
+* The tables are never changed after they were built, so several localizers may read them at once.
+*/
+struct SrpTables {
+  /**
+   * @var lag_table
+   * Index into the unshifted cross correlation for each pair and grid point.
+  */
+  std::vector<int> lag_table;
+
+  /**
+   * @var point_degrees
+   * Degree bin of each grid point.
+  */
+  std::vector<int> point_degrees;
+
+  /**
+   * @var point_bins
+   * Azimuth and elevation bin of each grid point, degree * elevation_count + elevation - elevation_min.
+  */
+  std::vector<int> point_bins;
+
+  /**
+   * @var elevation_min
+   * Lowest elevation in degrees of any grid point.
+  */
+  int elevation_min = 0;
+
+  /**
+   * @var elevation_count
+   * Number of elevation bins from elevation_min upwards, 1 for planar setups.
+  */
+  int elevation_count = 1;
+
+  /**
+   * @var degree_offsets
+   * Degree d owns the grid points from degree_points[degree_offsets[d]] up to degree_points[degree_offsets[d + 1]].
+  */
+  std::vector<int> degree_offsets;
+
+  /**
+   * @var degree_points
+   * Grid points grouped by degree.
+  */
+  std::vector<int> degree_points;
+
+  /**
+   * @var pair_lags
+   * Distinct cross correlation indices needed by each pair.
+  */
+  std::vector<std::vector<int>> pair_lags;
+
+  /**
+   * @var lag_slots
+   * Position in pair_lags for each pair and grid point.
+  */
+  std::vector<int> lag_slots;
+
+  /**
+   * @var lag_cosine
+   * Cosine of 2 pi n / fft length for evaluating single lags.
+  */
+  std::vector<double> lag_cosine;
+
+  /**
+   * @var lag_sine
+   * Sine of 2 pi n / fft length for evaluating single lags.
+  */
+  std::vector<double> lag_sine;
+
+  /**
+   * @var tail_phases
+   * Phase of the sample following the frame at each bin.
+  */
+  std::vector<std::complex<double>> tail_phases;
+};
+
+/**
+* @struct LatencyStats
+* @brief Processing time statistics of one session.
+*/
+struct LatencyStats {
+  /**
+   * @var frames
+   * Number of reported frames.
+  */
+  int frames = 0;
+
+  /**
+   * @var last
+   * Processing time of the last frame in seconds.
+  */
+  double last = 0.0;
+
+  /**
+   * @var mean
+   * Mean processing time in seconds.
+  */
+  double mean = 0.0;
+
+  /**
+   * @var maximum
+   * Longest processing time in seconds.
+  */
+  double maximum = 0.0;
+};
+
+/**
+* @class SrpEngine
+* @brief Shares a thread pool, FFT plans and geometry tables between the SrpPhat instances of several microphone
+* arrays and keeps track of the processing time of each array.
+*
+* Tables and plans are built by the first localizer asking for them and reused by all later ones with the same
+* geometry or length. All methods may be called from several threads at once.
+* @code
+*  //Example usage:
+*  std::shared_ptr<taylortrack::localization::SrpEngine> engine =
+*      std::make_shared<taylortrack::localization::SrpEngine>(4);
+*  int session = engine->add_session("kitchen");
+*  taylortrack::localization::SrpPhat srp;
+*  srp.set_engine(engine);
+*  srp.set_config(config);
+*  // after each frame
+*  engine->report_latency(session, seconds);
+* @endcode
+*/
+class SrpEngine {
+ public:
+  /**
+   * @brief Starts the shared thread pool.
+   * @param threads total number of threads of the pool including the calling threads
+   */
+  explicit SrpEngine(int threads);
+
+  /**
+   * @brief Returns the thread pool shared by all sessions.
+   * @return pool running the subbands of every localizer using this engine
+   */
+  std::shared_ptr<utils::ThreadPool> get_pool() const {
+    return pool_;
+  }
+
+  /**
+   * @brief Returns the FFT plan for a signal length, building it on first use.
+   * @param length signal length, has to be a power of two
+   * @return plan shared by every localizer asking for this length
+   */
+  std::shared_ptr<utils::FftPlan> get_fft_plan(size_t length);
+
+  /**
+   * @brief Returns the tables stored under a key, building them on first use.
+   * @param key description of everything the tables depend on
+   * @param build function building the tables if the key is unknown
+   * @return tables shared by every localizer asking for this key
+   */
+  std::shared_ptr<const SrpTables> get_tables(
+      const std::string &key,
+      const std::function<std::shared_ptr<const SrpTables>()> &build);
+
+  /**
+   * @brief Returns the number of distinct tables built so far.
+   * @return number of distinct keys passed to get_tables()
+   */
+  size_t get_table_count() const;
+
+  /**
+   * @brief Registers a session for latency tracking.
+   * @param name name of the session, e.g. the name of its config section
+   * @return index of the session for report_latency() and get_latency()
+   */
+  int add_session(const std::string &name);
+
+  /**
+   * @brief Returns the number of registered sessions.
+   * @return number of add_session() calls
+   */
+  int get_session_count() const;
+
+  /**
+   * @brief Returns the name of a session.
+   * @param session index returned by add_session()
+   * @return name given to add_session()
+   */
+  std::string get_session_name(int session) const;
+
+  /**
+   * @brief Adds the processing time of a frame to the statistics of a session.
+   * @param session index returned by add_session()
+   * @param seconds processing time of the frame
+   */
+  void report_latency(int session, double seconds);
+
+  /**
+   * @brief Returns the processing time statistics of a session.
+   * @param session index returned by add_session()
+   * @return statistics of all frames reported for the session
+   */
+  LatencyStats get_latency(int session) const;
+
+ private:
+  // pool shared by all sessions
+  std::shared_ptr<utils::ThreadPool> pool_;
+  // plans by signal length
+  std::map<size_t, std::shared_ptr<utils::FftPlan>> fft_plans_;
+  // tables by key
+  std::map<std::string, std::shared_ptr<const SrpTables>> tables_;
+  // name of each session
+  std::vector<std::string> session_names_;
+  // statistics of each session
+  std::vector<LatencyStats> latencies_;
+  // guards all members above except the pool
+  mutable std::mutex mutex_;
+};
+}  // namespace localization
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_LOCALIZATION_SRP_ENGINE_H_
@@ -27,10 +27,17 @@ SOFTWARE.
  * @brief Implementation of srpphat.h
  */
 #include "localization/srp_phat.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 #include "utils/fft_lib.h"
+#include "utils/text_sample_reader.h"
 
 namespace taylortrack {
 namespace localization {
@@ -58,7 +65,116 @@ std::vector<std::tuple<int, int>> SrpPhat::get_microphone_pairs() {
       }
     }
   }
-  return pairs;
+  switch (pair_selection_) {
+    case utils::PairSelectionPolicy::kMinimumBaseline:
+      return select_minimum_baseline(pairs);
+    case utils::PairSelectionPolicy::kTopK:
+      return select_diverse_pairs(pairs);
+    default:
+      // every pair, the round robin policy chooses its subset per frame
+      return pairs;
+  }
+}
+
+double SrpPhat::get_baseline(const std::tuple<int, int> &pair) const {
+  double x_difference =
+      x_dim_mics_[std::get<0>(pair)] - x_dim_mics_[std::get<1>(pair)];
+  double y_difference =
+      y_dim_mics_[std::get<0>(pair)] - y_dim_mics_[std::get<1>(pair)];
+  return std::sqrt(x_difference * x_difference + y_difference * y_difference);
+}
+
+std::vector<std::tuple<int, int>> SrpPhat::select_minimum_baseline(
+    const std::vector<std::tuple<int, int>> &pairs) const {
+  std::vector<int> candidates;
+  for (int i = 0; i < static_cast<int>(pairs.size()); i++) {
+    if (get_baseline(pairs[i]) >= min_baseline_)
+      candidates.push_back(i);
+  }
+  // over budget: keep the longest baselines
+  if (max_pairs_ > 0 && static_cast<int>(candidates.size()) > max_pairs_) {
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](int first, int second) {
+                       return get_baseline(pairs[first]) >
+                           get_baseline(pairs[second]);
+                     });
+    candidates.resize(static_cast<size_t>(max_pairs_));
+    std::sort(candidates.begin(), candidates.end());
+  }
+  std::vector<std::tuple<int, int>> selected;
+  for (int index : candidates)
+    selected.push_back(pairs[index]);
+  return selected;
+}
+
+std::vector<std::tuple<int, int>> SrpPhat::select_diverse_pairs(
+    const std::vector<std::tuple<int, int>> &pairs) const {
+  if (max_pairs_ <= 0 || max_pairs_ >= static_cast<int>(pairs.size()))
+    return pairs;
+
+  std::vector<double> orientations(pairs.size());
+  for (int i = 0; i < static_cast<int>(pairs.size()); i++) {
+    int index1 = std::get<0>(pairs[i]);
+    int index2 = std::get<1>(pairs[i]);
+    orientations[i] = atan2(y_dim_mics_[index2] - y_dim_mics_[index1],
+                            x_dim_mics_[index2] - x_dim_mics_[index1]);
+  }
+
+  std::vector<bool> taken(pairs.size(), false);
+  std::vector<int> chosen;
+  while (static_cast<int>(chosen.size()) < max_pairs_) {
+    int best = -1;
+    double best_score = -1.0;
+    double best_baseline = -1.0;
+    for (int i = 0; i < static_cast<int>(pairs.size()); i++) {
+      if (taken[i])
+        continue;
+      // a pair parallel to an already chosen one adds no new direction
+      double novelty = 1.0;
+      for (int j : chosen)
+        novelty = std::min(novelty,
+                           std::abs(sin(orientations[i] - orientations[j])));
+      double baseline = get_baseline(pairs[i]);
+      double score = baseline * novelty;
+      if (score > best_score ||
+          (score == best_score && baseline > best_baseline)) {
+        best = i;
+        best_score = score;
+        best_baseline = baseline;
+      }
+    }
+    taken[best] = true;
+    chosen.push_back(best);
+  }
+  std::sort(chosen.begin(), chosen.end());
+
+  std::vector<std::tuple<int, int>> selected;
+  for (int index : chosen)
+    selected.push_back(pairs[index]);
+  return selected;
+}
+
+std::vector<int> SrpPhat::schedule_frame_pairs() {
+  std::vector<int> frame_pairs;
+  int pair_count = static_cast<int>(pairs_.size());
+  if (pair_selection_ != utils::PairSelectionPolicy::kRoundRobin
+      || max_pairs_ <= 0 || max_pairs_ >= pair_count) {
+    for (int i = 0; i < pair_count; i++)
+      frame_pairs.push_back(i);
+  } else {
+    for (int i = 0; i < max_pairs_; i++)
+      frame_pairs.push_back((round_robin_offset_ + i) % pair_count);
+    round_robin_offset_ = (round_robin_offset_ + max_pairs_) % pair_count;
+  }
+  if (shard_count_ > 1) {
+    // every shard sees the same schedule and keeps its share of it
+    frame_pairs.erase(std::remove_if(frame_pairs.begin(), frame_pairs.end(),
+                                     [this](int pair) {
+                                       return pair % shard_count_ != shard_;
+                                     }),
+                      frame_pairs.end());
+  }
+  return frame_pairs;
 }
 
 RArray SrpPhat::generalized_cross_correlation(const RArray &signal1,
@@ -110,44 +226,20 @@ std::vector<double> SrpPhat::get_axis_values(bool xaxis) {
 }
 
 RArray SrpPhat::get_position_distribution(const std::vector<RArray> &signals) {
-  std::vector<std::vector<double>> gcc_grid =
-      get_generalized_cross_correlation(signals);
-  RArray degree_values(360);
-  std::vector<double> xAxisValues = get_axis_values(true);
-  std::vector<double> yAxisValues = get_axis_values(false);
-
-  for (int i = 0; i < static_cast<int>(xAxisValues.size()); i++) {
-    for (int j = 0; j < static_cast<int>(yAxisValues.size()); j++) {
-      int degree = point_to_degree(xAxisValues[i], yAxisValues[j]);
-      if (degree == 360)
-        degree = 0;
-      degree_values[degree] += gcc_grid[i][j];
-    }
-  }
+  RArray degree_values = get_degree_values(get_gcc_grid(signals));
   // get maximum for normalization of values
   double res = degree_values.sum();
   return degree_values / res;
 }
 
+RArray SrpPhat::get_position_distribution(const utils::SignalView &frame) {
+  RArray degree_values = get_degree_values(get_gcc_grid(frame));
+  double res = degree_values.sum();
+  return degree_values / res;
+}
+
 int SrpPhat::get_position(const std::vector<RArray> &signals) {
-  std::vector<std::vector<double>> gcc_grid =
-      get_generalized_cross_correlation(signals);
-  RArray degree_values(360);
-  std::vector<double> xAxisValues = get_axis_values(true);
-  std::vector<double> yAxisValues = get_axis_values(false);
-  for (int i = 0; i < 360; i++) {
-    degree_values[i] = 0;
-  }
-  int vectorSize = static_cast<int> (x_length_ / stepsize_ + 1);
-  for (int i = 0; i < vectorSize; i++) {
-    for (int j = 0; j < vectorSize; j++) {
-      int degree = point_to_degree(xAxisValues[j],
-                                   static_cast<double> (yAxisValues[i]));
-      if (degree == 360)
-        degree = 0;
-      degree_values[degree] += gcc_grid[j][i];
-    }
-  }
+  RArray degree_values = get_degree_values(get_gcc_grid(signals));
   double res = degree_values.max();
   return find_value(degree_values, res);
 }
@@ -163,47 +255,482 @@ int SrpPhat::find_value(const RArray &in_vector, double value) {
 
 std::vector<std::vector<double>>
 SrpPhat::get_generalized_cross_correlation(const std::vector<RArray> &signals) {
-  std::vector<std::tuple<int, int>> pairs = get_microphone_pairs();
-  std::vector<std::vector<double>> generalized_cross_correlation_values;
-  int64_t vectorSize = int64_t(x_length_ / stepsize_ + 1);
-  // initializing the gcc grid
-  generalized_cross_correlation_values.
-      resize(static_cast<int64_t>(vectorSize));
-  for (int i = 0; i < vectorSize; ++i) {
-    generalized_cross_correlation_values[i].
-        resize(static_cast<int64_t>(vectorSize));
-  }
-  std::vector<std::vector<std::vector<double>>> micDelays = delay_tensor_;
-  // iterating over all microphone pairs
-  for (int i = 0; i < static_cast<int>(pairs.size()); i++) {
-    int index1 = std::get<0>(pairs[i]);
-    int index2 = std::get<1>(pairs[i]);
-    // assigning the corresponding signals
-    RArray signal1 = signals[index1];
-    RArray signal2 = signals[index2];
-    // get the current frame from the complete signal
-    RArray signalSlice1 =
-        signal1[std::slice(0, static_cast<size_t>(frame_size_ + 1), 1)];
-    RArray signalSlice2 =
-        signal2[std::slice(0, static_cast<size_t>(frame_size_), 1)];
-    // computing the cross correlation of both frames
-    RArray generalized_cross_temp =
-        generalized_cross_correlation(signalSlice1, signalSlice2);
-    // iterating over the whole x-y grid
-    for (int x = 0; x < vectorSize; x++) {
-      for (int y = 0; y < vectorSize; y++) {
-        double delay = micDelays[x][y][i];
-        // adding the corresponding cross correlation value to the grid
-        generalized_cross_correlation_values[x][y] +=
-            generalized_cross_temp[(frame_size_ - 1) +
-                round(delay / (1.0 / samplerate_))];
+  return unflatten_grid(get_gcc_grid(signals));
+}
+
+std::vector<std::vector<double>>
+SrpPhat::get_generalized_cross_correlation(const utils::SignalView &frame) {
+  return unflatten_grid(get_gcc_grid(frame));
+}
+
+std::vector<double> SrpPhat::get_gcc_grid(const std::vector<RArray> &signals,
+                                          bool windowed) {
+  std::vector<int> frame_pairs = schedule_frame_pairs();
+  transform_frame(signals, frame_pairs);
+  return accumulate_grid(frame_pairs, windowed);
+}
+
+std::vector<double> SrpPhat::get_gcc_grid(const utils::SignalView &frame,
+                                          bool windowed) {
+  std::vector<int> frame_pairs = schedule_frame_pairs();
+  transform_frame(frame, frame_pairs);
+  return accumulate_grid(frame_pairs, windowed);
+}
+
+void SrpPhat::transform_frame(const std::vector<RArray> &signals,
+                              const std::vector<int> &frame_pairs) {
+  std::vector<bool> used_channels = get_used_channels(frame_pairs);
+  for (int channel = 0; channel < static_cast<int>(used_channels.size());
+       ++channel) {
+    if (used_channels[channel]) {
+      const RArray &signal = signals[channel];
+      transform_channel(channel, &signal[0], 1,
+                        static_cast<int64_t>(signal.size()));
+    }
+  }
+}
+
+void SrpPhat::transform_frame(const utils::SignalView &frame,
+                              const std::vector<int> &frame_pairs) {
+  std::vector<bool> used_channels = get_used_channels(frame_pairs);
+  for (int channel = 0; channel < static_cast<int>(used_channels.size());
+       ++channel) {
+    // reading straight from the interleaved frame, no per channel copies
+    if (used_channels[channel])
+      transform_channel(channel, &frame.at(channel, 0), frame.stride,
+                        frame.length);
+  }
+}
+
+bool SrpPhat::detect_voice(const std::vector<int> &frame_pairs,
+                           int64_t length) {
+  last_voice_ = true;
+  if (!spectral_vad_ || frame_pairs.empty())
+    return true;
+  // the first channel of the frame that has been transformed anyway
+  int channel = std::get<0>(pairs_[frame_pairs[0]]);
+  last_voice_ = vad_.detect_spectrum(
+      channel_spectra_[channel],
+      std::min(length, static_cast<int64_t>(frame_size_)));
+  return last_voice_;
+}
+
+std::vector<bool> SrpPhat::get_used_channels(
+    const std::vector<int> &frame_pairs) const {
+  // the beamformer sums up every channel
+  std::vector<bool> used_channels(x_dim_mics_.size(), beamforming_);
+  for (int i : frame_pairs) {
+    used_channels[std::get<0>(pairs_[i])] = true;
+    used_channels[std::get<1>(pairs_[i])] = true;
+  }
+  return used_channels;
+}
+
+void SrpPhat::transform_channel(int channel, const double *samples,
+                                int64_t stride, int64_t length) {
+  CArray &spectrum = channel_spectra_[channel];
+  if (spectrum.size() != fft_length_)
+    spectrum.resize(fft_length_);
+  // pack the frame and zero pad it to the correlation length
+  int64_t frame_length = std::min(length, static_cast<int64_t>(frame_size_));
+  for (int64_t n = 0; n < frame_length; ++n)
+    spectrum[n] = samples[n * stride];
+  for (int64_t n = frame_length; n < static_cast<int64_t>(fft_length_); ++n)
+    spectrum[n] = 0.0;
+
+  fft_plan_->fft(spectrum);
+
+  channel_tails_[channel] =
+      length > frame_size_ ? samples[frame_size_ * stride] : 0.0;
+}
+
+Complex SrpPhat::weighted_cross_spectrum(int pair, size_t k) const {
+  const CArray &spectrum1 = channel_spectra_[std::get<0>(pairs_[pair])];
+  const CArray &spectrum2 = channel_spectra_[std::get<1>(pairs_[pair])];
+  double tail = channel_tails_[std::get<0>(pairs_[pair])];
+  // the first signal is one sample longer, at the end of the zero padded
+  // frame this sample adds its value times the tail phase to the spectrum
+  Complex first = spectrum1[k] + tail * tables_->tail_phases[k];
+  // computing nominator and denominator of the generalized cross correlation
+  Complex nominator = first * std::conj(spectrum2[k]);
+  double magnitude = std::abs(nominator);
+  return magnitude > 0.0 ? nominator / std::pow(magnitude, beta_) :
+                           Complex(0.0, 0.0);
+}
+
+std::vector<double> SrpPhat::accumulate_grid(
+    const std::vector<int> &frame_pairs, bool windowed) {
+  if (windowed)
+    return accumulate_window(frame_pairs);
+  if (subbands_ > 1 || band_first_ > 0 || band_last_ < fft_length_ / 2)
+    return accumulate_subbands(frame_pairs);
+
+  int point_count = point_count_;
+  std::vector<double> grid(static_cast<size_t>(point_count), 0.0);
+  CArray cross_correlation(fft_length_);
+  // iterating over the microphone pairs scheduled for this frame
+  for (int i : frame_pairs) {
+    for (size_t k = 0; k < fft_length_; ++k)
+      cross_correlation[k] = weighted_cross_spectrum(i, k);
+    // reverse transfering to time domain with the shared plan
+    fft_plan_->ifft(cross_correlation);
+    // adding the corresponding cross correlation value to each grid point
+    const int *lags = &tables_->lag_table[static_cast<size_t>(i) * point_count];
+    for (int point = 0; point < point_count; ++point)
+      grid[point] += cross_correlation[lags[point]].real();
+  }
+  return grid;
+}
+
+std::vector<double> SrpPhat::evaluate_lags(
+    const std::vector<int> &frame_pairs,
+    const std::vector<const std::vector<int> *> &lags,
+    std::vector<size_t> *offsets) {
+  // offsets of the lag values of each scheduled pair
+  offsets->assign(frame_pairs.size() + 1, 0);
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot)
+    (*offsets)[slot + 1] = (*offsets)[slot] + lags[slot]->size();
+
+  size_t bin_count = band_last_ >= band_first_ ?
+                     band_last_ - band_first_ + 1 : 0;
+  subband_values_.resize(static_cast<size_t>(subbands_));
+  // fft_length_ is a power of two, so the phase index wraps with a mask
+  size_t phase_mask = fft_length_ - 1;
+  std::function<void(int)> evaluate = [&](int band) {
+    size_t first = band_first_ + bin_count * band / subbands_;
+    size_t last = band_first_ + bin_count * (band + 1) / subbands_;
+    std::vector<double> &values = subband_values_[band];
+    values.assign(offsets->back(), 0.0);
+    for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+      const std::vector<int> &pair_lags = *lags[slot];
+      double *pair_values = &values[(*offsets)[slot]];
+      for (size_t k = first; k < last; ++k) {
+        Complex weighted = weighted_cross_spectrum(frame_pairs[slot], k);
+        // the spectrum of a real signal is hermitian, so every bin except
+        // dc and nyquist also stands for its negative frequency
+        double weight = k == 0 || k == fft_length_ / 2 ? 1.0 : 2.0;
+        double real = weight * weighted.real();
+        double imag = weight * weighted.imag();
+        for (size_t j = 0; j < pair_lags.size(); ++j) {
+          size_t phase = (k * static_cast<size_t>(pair_lags[j])) & phase_mask;
+          pair_values[j] += real * tables_->lag_cosine[phase] - imag * tables_->lag_sine[phase];
+        }
       }
     }
+  };
+  if (pool_) {
+    pool_->parallel_for(subbands_, evaluate);
+  } else {
+    for (int band = 0; band < subbands_; ++band)
+      evaluate(band);
+  }
+
+  // accumulating the subbands, scaled like the inverse transformation
+  std::vector<double> lag_values(offsets->back(), 0.0);
+  for (const std::vector<double> &values : subband_values_) {
+    for (size_t j = 0; j < lag_values.size(); ++j)
+      lag_values[j] += values[j];
+  }
+  for (double &value : lag_values)
+    value /= fft_length_;
+  return lag_values;
+}
+
+std::vector<double> SrpPhat::accumulate_subbands(
+    const std::vector<int> &frame_pairs) {
+  std::vector<const std::vector<int> *> lags;
+  for (int pair : frame_pairs)
+    lags.push_back(&tables_->pair_lags[pair]);
+  std::vector<size_t> offsets;
+  std::vector<double> lag_values = evaluate_lags(frame_pairs, lags, &offsets);
+
+  int point_count = point_count_;
+  std::vector<double> grid(static_cast<size_t>(point_count), 0.0);
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+    const double *values = &lag_values[offsets[slot]];
+    const int *slots =
+        &tables_->lag_slots[static_cast<size_t>(frame_pairs[slot]) * point_count];
+    for (int point = 0; point < point_count; ++point)
+      grid[point] += values[slots[point]];
   }
-  return generalized_cross_correlation_values;
+  return grid;
 }
 
-std::vector<std::vector<std::vector<double>>> SrpPhat::get_delay_tensor() {
+std::vector<double> SrpPhat::accumulate_window(
+    const std::vector<int> &frame_pairs) {
+  int point_count = point_count_;
+  size_t window_size = search_points_.size();
+  // collecting the distinct lags the points of the window need
+  window_lags_.resize(frame_pairs.size());
+  window_slots_.resize(frame_pairs.size() * window_size);
+  std::vector<const std::vector<int> *> lags;
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+    const int *pair_lags =
+        &tables_->lag_table[static_cast<size_t>(frame_pairs[slot]) * point_count];
+    std::vector<int> &distinct = window_lags_[slot];
+    distinct.clear();
+    for (size_t j = 0; j < window_size; ++j) {
+      int lag = pair_lags[search_points_[j]];
+      if (lag_marks_[lag] < 0) {
+        lag_marks_[lag] = static_cast<int>(distinct.size());
+        distinct.push_back(lag);
+      }
+      window_slots_[slot * window_size + j] = lag_marks_[lag];
+    }
+    for (int lag : distinct)
+      lag_marks_[lag] = -1;
+    lags.push_back(&distinct);
+  }
+  std::vector<size_t> offsets;
+  std::vector<double> lag_values = evaluate_lags(frame_pairs, lags, &offsets);
+
+  // points outside of the window keep a value of zero
+  std::vector<double> grid(static_cast<size_t>(point_count), 0.0);
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+    const double *values = &lag_values[offsets[slot]];
+    for (size_t j = 0; j < window_size; ++j)
+      grid[search_points_[j]] += values[window_slots_[slot * window_size + j]];
+  }
+  return grid;
+}
+
+bool SrpPhat::prepare_search_window() {
+  if (!tracking_ || !tracker_.is_initialized() || sweep_requested_ ||
+      frames_since_sweep_ >= full_sweep_interval_)
+    return false;
+  double center = tracker_.predict();
+  search_points_.clear();
+  for (int degree = 0; degree < 360; ++degree) {
+    if (std::abs(angle_difference(degree, center)) <= tracking_window_)
+      search_points_.insert(search_points_.end(),
+                            tables_->degree_points.begin() + tables_->degree_offsets[degree],
+                            tables_->degree_points.begin() + tables_->degree_offsets[degree + 1]);
+  }
+  return true;
+}
+
+void SrpPhat::update_tracker(bool windowed) {
+  if (!tracking_)
+    return;
+  if (windowed) {
+    ++frames_since_sweep_;
+    // a peak at the border of the window means the speaker is leaving it
+    sweep_requested_ = std::abs(angle_difference(last_position_,
+        tracker_.predict())) > tracking_window_ - 1.0;
+  } else {
+    frames_since_sweep_ = 0;
+    sweep_requested_ = false;
+  }
+  tracker_.update(last_position_);
+}
+
+RArray SrpPhat::get_degree_values(const std::vector<double> &grid) {
+  RArray degree_values(360);
+  int elevations = tables_->elevation_count;
+  if (elevations == 1) {
+    for (int point = 0; point < static_cast<int>(grid.size()); ++point)
+      degree_values[tables_->point_degrees[point]] += grid[point];
+    return degree_values;
+  }
+  bin_values_.assign(static_cast<size_t>(360 * elevations), 0.0);
+  for (int point = 0; point < static_cast<int>(grid.size()); ++point)
+    bin_values_[tables_->point_bins[point]] += grid[point];
+  for (int degree = 0; degree < 360; ++degree) {
+    for (int elevation = 0; elevation < elevations; ++elevation)
+      degree_values[degree] += bin_values_[degree * elevations + elevation];
+  }
+  return degree_values;
+}
+
+void SrpPhat::store_elevation() {
+  int elevations = tables_->elevation_count;
+  if (elevations == 1) {
+    last_elevation_ = tables_->elevation_min;
+    return;
+  }
+  std::vector<double>::const_iterator row =
+      bin_values_.begin() + last_position_ * elevations;
+  last_elevation_ = tables_->elevation_min +
+      static_cast<int>(std::max_element(row, row + elevations) - row);
+}
+
+std::vector<double> SrpPhat::sum_slices(
+    const std::vector<double> &grid) const {
+  int slice_size = grid_size_ * grid_size_;
+  std::vector<double> plane(grid.begin(), grid.begin() + slice_size);
+  for (int point = slice_size; point < static_cast<int>(grid.size()); ++point)
+    plane[point % slice_size] += grid[point];
+  return plane;
+}
+
+std::vector<std::vector<double>> SrpPhat::unflatten_grid(
+    const std::vector<double> &grid) const {
+  std::vector<double> plane = sum_slices(grid);
+  std::vector<std::vector<double>> nested(static_cast<size_t>(grid_size_));
+  for (int x = 0; x < grid_size_; ++x)
+    nested[x].assign(plane.begin() + x * grid_size_,
+                     plane.begin() + (x + 1) * grid_size_);
+  return nested;
+}
+
+void SrpPhat::build_lookup_tables() {
+  grid_size_ = static_cast<int>(x_length_ / stepsize_ + 1);
+  point_count_ = grid_size_ * grid_size_ * static_cast<int>(z_slices_.size());
+  fft_length_ = 1;
+  while (fft_length_ < static_cast<size_t>(2 * frame_size_))
+    fft_length_ <<= 1;
+  channel_spectra_.assign(x_dim_mics_.size(), CArray());
+  channel_tails_.assign(x_dim_mics_.size(), 0.0);
+  lag_marks_.assign(fft_length_, -1);
+
+  // bins of the evaluated band, the whole spectrum unless limited
+  double bin_width = static_cast<double>(samplerate_) / fft_length_;
+  band_first_ = static_cast<size_t>(std::max(0.0,
+                                             std::ceil(band_low_ / bin_width)));
+  band_last_ = fft_length_ / 2;
+  if (band_high_ > 0.0)
+    band_last_ = std::min(band_last_,
+                          static_cast<size_t>(band_high_ / bin_width));
+
+  if (engine_) {
+    // arrays with the same geometry share their tables and plans
+    tables_ = engine_->get_tables(get_table_key(), [this]() {
+      return build_tables();
+    });
+    fft_plan_ = engine_->get_fft_plan(fft_length_);
+  } else {
+    tables_ = build_tables();
+    fft_plan_ = std::make_shared<utils::FftPlan>(fft_length_);
+  }
+}
+
+std::string SrpPhat::get_table_key() const {
+  std::ostringstream key;
+  key << std::setprecision(17) << samplerate_ << ' ' << frame_size_ << ' '
+      << x_length_ << ' ' << y_length_ << ' ' << stepsize_;
+  for (size_t m = 0; m < x_dim_mics_.size(); ++m)
+    key << ' ' << x_dim_mics_[m] << ',' << y_dim_mics_[m] << ','
+        << z_dim_mics_[m];
+  for (double height : z_slices_)
+    key << ' ' << height;
+  key << ' ' << static_cast<int>(pair_selection_) << ' ' << max_pairs_ << ' '
+      << min_baseline_;
+  return key.str();
+}
+
+std::shared_ptr<const SrpTables> SrpPhat::build_tables() {
+  std::shared_ptr<SrpTables> tables = std::make_shared<SrpTables>();
+  std::vector<int> &point_degrees = tables->point_degrees;
+  std::vector<int> &degree_offsets = tables->degree_offsets;
+  std::vector<int> &degree_points = tables->degree_points;
+  std::vector<int> &lag_table = tables->lag_table;
+  std::vector<double> xAxisValues = get_axis_values(true);
+  std::vector<double> yAxisValues = get_axis_values(false);
+  int point_count = point_count_;
+  int slice_size = grid_size_ * grid_size_;
+  int slices = static_cast<int>(z_slices_.size());
+  double array_height = z_dim_mics_.size() > 0 ? z_dim_mics_.sum() / z_dim_mics_.size() : 0.0;
+  std::vector<int> point_elevations(static_cast<size_t>(point_count), 0);
+  point_degrees.assign(static_cast<size_t>(point_count), 0);
+  for (int slice = 0; slice < slices; slice++) {
+    for (int x = 0; x < grid_size_; x++) {
+      for (int y = 0; y < grid_size_; y++) {
+        int degree = point_to_degree(xAxisValues[x], yAxisValues[y]);
+        if (degree == 360)
+          degree = 0;
+        int point = slice * slice_size + x * grid_size_ + y;
+        point_degrees[point] = degree;
+        point_elevations[point] = static_cast<int>(round(atan2(
+            z_slices_[slice] - array_height,
+            std::hypot(xAxisValues[x], yAxisValues[y])) * 180 / kPI));
+      }
+    }
+  }
+  // one projection onto azimuth and elevation bins, only the elevations
+  // occurring in the grid get a bin
+  tables->elevation_min = *std::min_element(point_elevations.begin(),
+                                            point_elevations.end());
+  tables->elevation_count = *std::max_element(point_elevations.begin(),
+                                              point_elevations.end())
+      - tables->elevation_min + 1;
+  tables->point_bins.resize(point_degrees.size());
+  for (int point = 0; point < point_count; ++point)
+    tables->point_bins[point] = point_degrees[point] * tables->elevation_count
+        + point_elevations[point] - tables->elevation_min;
+
+  // grid points grouped by degree for evaluating angular windows
+  degree_offsets.assign(361, 0);
+  for (int degree : point_degrees)
+    ++degree_offsets[degree + 1];
+  for (int degree = 0; degree < 360; ++degree)
+    degree_offsets[degree + 1] += degree_offsets[degree];
+  degree_points.resize(point_degrees.size());
+  std::vector<int> fill(degree_offsets.begin(), degree_offsets.end() - 1);
+  for (int point = 0; point < point_count; ++point)
+    degree_points[fill[point_degrees[point]]++] = point;
+
+  int64_t length = static_cast<int64_t>(fft_length_);
+  lag_table.assign(pairs_.size() * point_count, 0);
+  for (int slice = 0; slice < slices; slice++) {
+    std::vector<std::vector<std::vector<double>>> delay_tensor =
+        get_delay_tensor(z_slices_[slice]);
+    for (int i = 0; i < static_cast<int>(pairs_.size()); i++) {
+      for (int x = 0; x < grid_size_; x++) {
+        for (int y = 0; y < grid_size_; y++) {
+          double delay = delay_tensor[x][y][i];
+          int64_t shifted_index = (length / 2 - 1) +
+              static_cast<int64_t>(round(delay / (1.0 / samplerate_)));
+          // undo the fftshift so the inverse transform can be indexed directly
+          int64_t index = ((shifted_index + length / 2) % length + length)
+              % length;
+          lag_table[i * point_count + slice * slice_size + x * grid_size_ + y] =
+              static_cast<int>(index);
+        }
+      }
+    }
+  }
+
+  // distinct lags of each pair for evaluating them one by one
+  tables->pair_lags.assign(pairs_.size(), std::vector<int>());
+  tables->lag_slots.assign(lag_table.size(), 0);
+  for (int i = 0; i < static_cast<int>(pairs_.size()); i++) {
+    const int *lags = &lag_table[static_cast<size_t>(i) * point_count];
+    std::vector<int> &distinct = tables->pair_lags[i];
+    distinct.assign(lags, lags + point_count);
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                   distinct.end());
+    for (int point = 0; point < point_count; ++point) {
+      tables->lag_slots[static_cast<size_t>(i) * point_count + point] =
+          static_cast<int>(std::lower_bound(distinct.begin(), distinct.end(),
+                                            lags[point]) - distinct.begin());
+    }
+  }
+  const double kPI = 3.141592653589793238460;
+  tables->lag_cosine.resize(fft_length_);
+  tables->lag_sine.resize(fft_length_);
+  for (size_t n = 0; n < fft_length_; ++n) {
+    tables->lag_cosine[n] = cos(2 * kPI * n / fft_length_);
+    tables->lag_sine[n] = sin(2 * kPI * n / fft_length_);
+  }
+
+  // e^(-2 pi i k frame_size / fft_length), exactly +-1 for two full frames
+  tables->tail_phases.resize(fft_length_);
+  for (size_t k = 0; k < fft_length_; ++k) {
+    size_t phase = (k * static_cast<size_t>(frame_size_)) & (fft_length_ - 1);
+    if (phase == 0)
+      tables->tail_phases[k] = Complex(1.0, 0.0);
+    else if (phase == fft_length_ / 2)
+      tables->tail_phases[k] = Complex(-1.0, 0.0);
+    else
+      tables->tail_phases[k] = Complex(tables->lag_cosine[phase],
+                                       -tables->lag_sine[phase]);
+  }
+  return tables;
+}
+
+std::vector<std::vector<std::vector<double>>> SrpPhat::get_delay_tensor(
+    double height) {
   std::vector<std::vector<std::vector<double>>> delay_tensor;
   std::vector<double> xAxisValues = get_axis_values(true);
   std::vector<double> yAxisValues = get_axis_values(false);
@@ -222,12 +749,13 @@ std::vector<std::vector<std::vector<double>>> SrpPhat::get_delay_tensor() {
       // iterating over microphone pairs
       for (int i = 0; i < static_cast<int>(pairs.size()); i++) {
         //
-        RArray point(2);
-        RArray microphone1(2);
-        RArray microphone2(2);
+        RArray point(3);
+        RArray microphone1(3);
+        RArray microphone2(3);
         // assigning the current point in the grid
         point[0] = xAxisValues[x];
         point[1] = yAxisValues[y];
+        point[2] = height;
         // assigning the microphone values
         int index1 = std::get<0>(pairs[i]);
         int index2 = std::get<1>(pairs[i]);
@@ -235,6 +763,8 @@ std::vector<std::vector<std::vector<double>>> SrpPhat::get_delay_tensor() {
         microphone1[1] = y_dim_mics_[index1];
         microphone2[0] = x_dim_mics_[index2];
         microphone2[1] = y_dim_mics_[index2];
+        microphone1[2] = z_dim_mics_.size() > 0 ? z_dim_mics_[index1] : 0.0;
+        microphone2[2] = z_dim_mics_.size() > 0 ? z_dim_mics_[index2] : 0.0;
         double delay =
             inter_microphone_time_delay(point, microphone1, microphone2);
         delay_tensor[x][y][i] = delay;
@@ -246,42 +776,200 @@ std::vector<std::vector<std::vector<double>>> SrpPhat::get_delay_tensor() {
 }
 
 RArray SrpPhat::get_microphone_signal(const std::string &filepath_name) {
-  std::vector<double> temporary_vector;
-  std::ifstream infile(filepath_name);
-  std::string line = "";
-  while (std::getline(infile, line)) {
-    std::istringstream string_stream(line);
-    double temporary_value;
-    if (!(string_stream >> temporary_value))
-      break;
-    temporary_vector.push_back(temporary_value);
-  }
-  infile.close();
-  RArray signal(temporary_vector.size());
-  for (int i = 0; i < static_cast<int>(temporary_vector.size()); i++) {
-    signal[i] = temporary_vector[i];
-  }
+  utils::TextSampleReader reader(filepath_name.c_str());
+  if (!reader.is_valid())
+    return RArray();
+  // every line holds at most one value, so the signal is allocated once
+  RArray signal(static_cast<size_t>(reader.get_line_count()));
+  int64_t samples = reader.read_samples(&signal[0], static_cast<int64_t>(signal.size()));
+  if (samples < static_cast<int64_t>(signal.size()))
+    return RArray(&signal[0], static_cast<size_t>(samples));
   return signal;
 }
+
+std::vector<RArray> SrpPhat::get_microphone_signals(const std::vector<std::string> &filepath_names) {
+  std::vector<RArray> signals(filepath_names.size());
+  auto load = [&](int i) {
+    signals[i] = get_microphone_signal(filepath_names[i]);
+  };
+  int count = static_cast<int>(signals.size());
+  // parsing waits for the disk, so the files are loaded in parallel independent of the subbands
+  std::shared_ptr<utils::ThreadPool> pool = engine_ ? engine_->get_pool() : pool_;
+  if (pool) {
+    pool->parallel_for(count, load);
+  } else {
+    // one thread per file, the calling thread loads the first one
+    utils::ThreadPool file_pool(count);
+    file_pool.parallel_for(count, load);
+  }
+  return signals;
+}
+
 void SrpPhat::calculate_position_and_distribution(
     const std::vector<RArray> &signals) {
-  std::vector<std::vector<double>> gcc_grid =
-      get_generalized_cross_correlation(signals);
-  RArray degree_values(360);
-  std::vector<double> xAxisValues = get_axis_values(true);
-  std::vector<double> yAxisValues = get_axis_values(false);
+  bool windowed = prepare_search_window();
+  std::vector<int> frame_pairs = schedule_frame_pairs();
+  transform_frame(signals, frame_pairs);
+  // silence skips the inverse transforms and the projection
+  if (!detect_voice(frame_pairs, static_cast<int64_t>(signals[0].size())))
+    return;
+  finish_frame(accumulate_grid(frame_pairs, windowed), windowed, true);
+}
+
+void SrpPhat::calculate_position_and_distribution(
+    const utils::SignalView &frame) {
+  bool windowed = prepare_search_window();
+  std::vector<int> frame_pairs = schedule_frame_pairs();
+  transform_frame(frame, frame_pairs);
+  if (!detect_voice(frame_pairs, frame.length))
+    return;
+  finish_frame(accumulate_grid(frame_pairs, windowed), windowed, true);
+}
 
-  for (int i = 0; i < static_cast<int>(xAxisValues.size()); i++) {
-    for (int j = 0; j < static_cast<int>(yAxisValues.size()); j++) {
-      int degree = point_to_degree(xAxisValues[i], yAxisValues[j]);
-      if (degree == 360)
-        degree = 0;
-      degree_values[degree] += gcc_grid[i][j];
+int SrpPhat::get_lag_vector_size() const {
+  size_t size = 0;
+  for (const std::vector<int> &lags : tables_->pair_lags)
+    size += lags.size();
+  return static_cast<int>(size);
+}
+
+std::vector<double> SrpPhat::get_lag_vectors(const utils::SignalView &frame) {
+  // always every pair, the receiving side does not follow the schedule
+  std::vector<int> all_pairs(pairs_.size());
+  std::iota(all_pairs.begin(), all_pairs.end(), 0);
+  transform_frame(frame, all_pairs);
+  std::vector<const std::vector<int> *> lags;
+  for (int pair : all_pairs)
+    lags.push_back(&tables_->pair_lags[pair]);
+  std::vector<size_t> offsets;
+  return evaluate_lags(all_pairs, lags, &offsets);
+}
+
+bool SrpPhat::calculate_from_lag_vectors(
+    const std::vector<double> &lag_values) {
+  if (static_cast<int>(lag_values.size()) != get_lag_vector_size())
+    return false;
+  int point_count = point_count_;
+  std::vector<double> grid(static_cast<size_t>(point_count), 0.0);
+  const double *values = lag_values.data();
+  for (size_t pair = 0; pair < pairs_.size(); ++pair) {
+    const int *slots = &tables_->lag_slots[pair * point_count];
+    for (int point = 0; point < point_count; ++point)
+      grid[point] += values[slots[point]];
+    values += tables_->pair_lags[pair].size();
+  }
+  finish_frame(grid, false, false);
+  return true;
+}
+
+void SrpPhat::finish_frame(const std::vector<double> &grid, bool windowed,
+                           bool spectra) {
+  store_result(get_degree_values(grid));
+  store_elevation();
+  // the heatmap is only materialized while someone asks for it
+  if (heatmap_enabled_)
+    store_heatmap(grid);
+  update_tracker(windowed);
+  if (beamforming_ && spectra)
+    beamform();
+}
+
+void SrpPhat::store_heatmap(const std::vector<double> &grid) {
+  std::vector<double> plane = sum_slices(grid);
+  int decimation = std::max(1, heatmap_decimation_);
+  int size = get_heatmap_size();
+  last_heatmap_.assign(static_cast<size_t>(size) * size, 0.0f);
+  // averaging blocks of decimation x decimation grid points
+  for (int x = 0; x < size; ++x) {
+    int x_end = std::min(grid_size_, (x + 1) * decimation);
+    for (int y = 0; y < size; ++y) {
+      int y_end = std::min(grid_size_, (y + 1) * decimation);
+      double sum = 0.0;
+      int count = 0;
+      for (int grid_x = x * decimation; grid_x < x_end; ++grid_x) {
+        for (int grid_y = y * decimation; grid_y < y_end; ++grid_y) {
+          sum += plane[grid_x * grid_size_ + grid_y];
+          ++count;
+        }
+      }
+      last_heatmap_[x * size + y] = static_cast<float>(sum / count);
     }
   }
+}
+
+void SrpPhat::beamform() {
+  size_t microphones = x_dim_mics_.size();
+  double angle = last_position_ * kPI / 180.0;
+  double elevation = last_elevation_ * kPI / 180.0;
+  // far field delays in samples towards the speaker, the microphone reached
+  // last gets no delay so all delays stay causal
+  std::vector<double> delays(microphones);
+  for (size_t m = 0; m < microphones; ++m)
+    delays[m] = ((x_dim_mics_[m] * cos(angle) + y_dim_mics_[m] * sin(angle))
+        * cos(elevation) + z_dim_mics_[m] * sin(elevation))
+        / kSpeedOfSound * samplerate_;
+  double latest = *std::min_element(delays.begin(), delays.end());
+  // phase rotation per bin of each delay
+  std::vector<Complex> rotations(microphones);
+  std::vector<Complex> phases(microphones, Complex(1.0, 0.0));
+  for (size_t m = 0; m < microphones; ++m)
+    rotations[m] = std::polar(1.0, -2 * kPI * (delays[m] - latest) / fft_length_);
+
+  // the frames are real, so only the non negative frequencies are summed up
+  beam_spectrum_.resize(fft_length_);
+  size_t half = fft_length_ / 2;
+  for (size_t k = 0; k <= half; ++k) {
+    Complex sum(0.0, 0.0);
+    for (size_t m = 0; m < microphones; ++m) {
+      sum += channel_spectra_[m][k] * phases[m];
+      phases[m] *= rotations[m];
+    }
+    beam_spectrum_[k] = sum / static_cast<double>(microphones);
+    if (k > 0 && k < half)
+      beam_spectrum_[fft_length_ - k] = std::conj(beam_spectrum_[k]);
+  }
+  beam_spectrum_[half] = beam_spectrum_[half].real();
+  fft_plan_->ifft(beam_spectrum_);
+
+  // overlap add with the tails of the previous frames
+  beam_overlap_.resize(fft_length_, 0.0);
+  beam_frame_.resize(static_cast<size_t>(frame_size_));
+  for (size_t n = 0; n < beam_frame_.size(); ++n)
+    beam_frame_[n] = beam_spectrum_[n].real() + beam_overlap_[n];
+  for (size_t n = beam_frame_.size(); n < fft_length_; ++n)
+    beam_overlap_[n - beam_frame_.size()] =
+        beam_spectrum_[n].real() + beam_overlap_[n];
+  std::fill(beam_overlap_.end() - beam_frame_.size(), beam_overlap_.end(), 0.0);
+}
+
+void SrpPhat::continue_from(const SrpPhat &previous) {
+  tracker_ = previous.tracker_;
+  frames_since_sweep_ = previous.frames_since_sweep_;
+  sweep_requested_ = previous.sweep_requested_;
+  last_distribution_ = previous.last_distribution_;
+  last_position_ = previous.last_position_;
+  last_degree_values_ = previous.last_degree_values_;
+  last_elevation_ = previous.last_elevation_;
+  last_voice_ = previous.last_voice_;
+  vad_ = previous.vad_;
+  heatmap_enabled_ = previous.heatmap_enabled_;
+  // the grid of the other settings may have another size, the next frame stores a new one
+  last_heatmap_.clear();
+  if (previous.beam_overlap_.size() == fft_length_)
+    beam_overlap_ = previous.beam_overlap_;
+  else
+    reset_beamformer();
+}
+
+void SrpPhat::store_result(const RArray &degree_values) {
+  last_degree_values_ = degree_values;
   // get maximum for normalization of values
   double normalization = degree_values.sum();
-  last_distribution_ = degree_values / normalization;
+  // silent frames sum up to zero, they prefer no direction
+  if (normalization != 0.0)
+    last_distribution_ = degree_values / normalization;
+  else
+    last_distribution_ = RArray(1.0 / degree_values.size(), degree_values.size());
   double maximum_position = degree_values.max();
   last_position_ = find_value(degree_values, maximum_position);
 }
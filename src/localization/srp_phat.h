@@ -29,14 +29,23 @@ SOFTWARE.
 */
 #ifndef TAYLORTRACK_LOCALIZATION_SRPPHAT_H_
 #define TAYLORTRACK_LOCALIZATION_SRPPHAT_H_
+#include <algorithm>
 #include <complex>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <valarray>
 #include <vector>
+#include "localization/azimuth_tracker.h"
 #include "localization/localizer.h"
+#include "localization/srp_engine.h"
 #include "utils/config_parser.h"
+#include "utils/fft_plan.h"
+#include "utils/signal_view.h"
+#include "utils/thread_pool.h"
+#include "utils/vad_spectral.h"
 
 namespace taylortrack {
 namespace localization {
@@ -116,6 +125,13 @@ class SrpPhat : public Localizer {
   */
   void calculate_position_and_distribution(const std::vector<RArray> &signals);
 
+  /**
+  * @brief Gets most likely position of the recorded speaker in degrees and a probability distribution
+  * over angles and stores those values in appropiate class variables
+  * @param  frame a view on an interleaved frame containing one channel per microphone
+  */
+  void calculate_position_and_distribution(const utils::SignalView &frame);
+
   /**
   * @brief Gets most likely position of the recorded speaker in degrees
   * @param  signals a vector of all microphone signals with each being a RArray
@@ -130,6 +146,13 @@ class SrpPhat : public Localizer {
   */
   RArray get_position_distribution(const std::vector<RArray> &signals) override;
 
+  /**
+  * @brief Returns a probability distribution for the position of the speaker over all degrees
+  * @param  frame a view on an interleaved frame containing one channel per microphone
+  * @return A RArray with all probability values
+  */
+  RArray get_position_distribution(const utils::SignalView &frame) override;
+
   /**
   * @brief Returns an RAarray filled with values from a given filepath_name. Only works for one value per column
   * @param  filepath_name A string with the path to the file containing the values
@@ -137,19 +160,45 @@ class SrpPhat : public Localizer {
   */
   RArray get_microphone_signal(const std::string &filepath_name);
 
+  /**
+  * @brief Loads one signal per file like get_microphone_signal(), the files are parsed in parallel
+  *
+  * The pool of the engine or of the subbands is used if there is one, otherwise one thread per file.
+  * @param  filepath_names paths to the files containing the values, usually one per microphone
+  * @return RArrays with all values of the files in the same order
+  */
+  std::vector<RArray> get_microphone_signals(const std::vector<std::string> &filepath_names);
+
   /**
   * @brief Returns a tensor containing all delays for all possible microphone pairs.
   * @details Returns a (X,Y,Z) tensor with matrices modelling the room(X,Y) with each entry containing the appropriate delay for that point given a certain microphone pair. The third dimension(Z) of the tensor models all the possible microphone pairs.
+  * @param height height of the modelled horizontal slice of the room
   * @return Returns the delay tensor modelled by a 3 dimensional vector
   */
-  std::vector<std::vector<std::vector<double>>> get_delay_tensor();
+  std::vector<std::vector<std::vector<double>>> get_delay_tensor(double height = 0.0);
 
   /**
-  * @brief Returns a vector of tuples containing all possible microphone pairs indices
+  * @brief Returns a vector of tuples containing the microphone pair indices chosen by the pair selection policy
+  * @details With the round robin policy all pairs are returned, the subset evaluated per frame is
+  * chosen by schedule_frame_pairs().
   * @return vector of microphone pair tuples
   */
   std::vector<std::tuple<int, int>> get_microphone_pairs();
 
+  /**
+  * @brief Returns the indices into get_microphone_pairs() of the pairs to evaluate for the next frame
+  * @details Advances the rotation if the round robin policy is used.
+  * @return indices of the microphone pairs to evaluate
+  */
+  std::vector<int> schedule_frame_pairs();
+
+  /**
+  * @brief Returns the distance between the two microphones of a pair
+  * @param pair tuple containing the indices of both microphones
+  * @return baseline length in meters
+  */
+  double get_baseline(const std::tuple<int, int> &pair) const;
+
   /**
   * @brief converts a 2 dimensional point in space to degree
   * @param x_coordinate x coordinate of a point in x y grid
@@ -187,6 +236,14 @@ class SrpPhat : public Localizer {
   std::vector<std::vector<double>>
       get_generalized_cross_correlation(const std::vector<RArray> &signals);
 
+  /**
+  * @brief Returns a x-y grid with the summed up gcc values for each point and each microphone pair
+  * @param frame a view on an interleaved frame containing one channel per microphone
+  * @return The GccGrid Matrix modeled as two nested vectors that contains every point of the room(grid) and the corresponding cross correlation value.
+  */
+  std::vector<std::vector<double>>
+      get_generalized_cross_correlation(const utils::SignalView &frame);
+
   /**
    * @brief Returns values for a given axis
    * @param xaxis defines which axis you want values for xaxis=true means x axis and xaxis=false returns values for the y axis
@@ -313,6 +370,165 @@ class SrpPhat : public Localizer {
   void set_beta(double beta) {
     beta_ = beta;
   }
+  /**
+    * @brief Gets the policy used to select the evaluated microphone pairs.
+    * @return Returns the pair selection policy.
+    */
+  utils::PairSelectionPolicy get_pair_selection() const {
+    return pair_selection_;
+  }
+  /**
+    * @brief Sets the policy used to select the evaluated microphone pairs.
+    * @param pair_selection for setting the pair selection policy
+    */
+  void set_pair_selection(utils::PairSelectionPolicy pair_selection) {
+    pair_selection_ = pair_selection;
+  }
+  /**
+    * @brief Gets the maximum number of microphone pairs evaluated per frame.
+    * @return Returns the pair budget, 0 means no limit.
+    */
+  int get_max_pairs() const {
+    return max_pairs_;
+  }
+  /**
+    * @brief Sets the maximum number of microphone pairs evaluated per frame.
+    * @param max_pairs for setting the pair budget, 0 means no limit
+    */
+  void set_max_pairs(int max_pairs) {
+    max_pairs_ = max_pairs;
+  }
+  /**
+    * @brief Gets the minimum baseline used by the minimum baseline policy.
+    * @return Returns the minimum baseline in meters.
+    */
+  double get_min_baseline() const {
+    return min_baseline_;
+  }
+  /**
+    * @brief Sets the minimum baseline used by the minimum baseline policy.
+    * @param min_baseline for setting the minimum baseline in meters
+    */
+  void set_min_baseline(double min_baseline) {
+    min_baseline_ = min_baseline;
+  }
+  /**
+    * @brief Gets the lowest frequency contributing to the cross correlation.
+    * @return Returns the lower band limit in Hz.
+    */
+  double get_band_low() const {
+    return band_low_;
+  }
+  /**
+    * @brief Gets the highest frequency contributing to the cross correlation.
+    * @return Returns the upper band limit in Hz, 0 means up to the Nyquist frequency.
+    */
+  double get_band_high() const {
+    return band_high_;
+  }
+  /**
+    * @brief Gets the number of subbands the frequency band is split into.
+    * @return Returns the number of subbands evaluated in parallel.
+    */
+  int get_subbands() const {
+    return subbands_;
+  }
+  /**
+    * @brief Checks whether frames are restricted to a window around the tracked speaker.
+    * @return true if tracking gated search is enabled, false otherwise.
+    */
+  bool is_tracking() const {
+    return tracking_;
+  }
+  /**
+    * @brief Gets the half width of the search window.
+    * @return Returns the half width in degrees.
+    */
+  double get_tracking_window() const {
+    return tracking_window_;
+  }
+  /**
+    * @brief Gets the maximum number of windowed frames between two full sweeps.
+    * @return Returns the full sweep interval in frames.
+    */
+  int get_full_sweep_interval() const {
+    return full_sweep_interval_;
+  }
+  /**
+    * @brief Gets the tracker following the speaker.
+    * @return Returns the azimuth tracker.
+    */
+  const AzimuthTracker &get_tracker() const {
+    return tracker_;
+  }
+  /**
+    * @brief Checks whether a beamformed stream is produced.
+    * @return true if delay and sum beamforming is enabled, false otherwise.
+    */
+  bool is_beamforming() const {
+    return beamforming_;
+  }
+  /**
+   * @brief Returns the beamformed mono samples of the last calculated frame.
+   *
+   * Delay and sum towards the last position, computed from the spectra the localization already transformed.
+   * Consecutive frames join with overlap add, the stream lags behind the input by the largest steering delay.
+   * @return frame_size samples, empty if beamforming is disabled
+   */
+  const std::vector<double> &get_beamformed_frame() const {
+    return beam_frame_;
+  }
+  /**
+   * @brief Clears the overlap add state, needed when frames of the stream were skipped.
+   */
+  void reset_beamformer() {
+    std::fill(beam_overlap_.begin(), beam_overlap_.end(), 0.0);
+  }
+  /**
+   * @brief Continues the stream of another instance, used when switching between precomputed settings.
+   *
+   * Takes over the tracked speaker, the results of the last frame, the beamformer overlap and the voice activity
+   * state, so neither the tracked azimuth nor the beamformed stream jump. Both instances need the same microphones
+   * and frame size.
+   * @param previous instance that processed the frames so far
+   */
+  void continue_from(const SrpPhat &previous);
+  /**
+   * @brief Enables or disables storing the power map of each frame.
+   *
+   * Meant to be switched on only while a consumer is connected, otherwise only the 360 degree bins are computed.
+   * @param enabled true to store the power map of the following frames
+   */
+  void set_heatmap_enabled(bool enabled) {
+    heatmap_enabled_ = enabled;
+    if (!enabled)
+      last_heatmap_.clear();
+  }
+  /**
+   * @brief Checks whether the power map of each frame is stored.
+   * @return true if the heatmap is enabled, false otherwise.
+   */
+  bool is_heatmap_enabled() const {
+    return heatmap_enabled_;
+  }
+  /**
+   * @brief Returns the number of heatmap values along each axis.
+   * @return grid points per axis divided by the heatmap decimation, rounded up
+   */
+  int get_heatmap_size() const {
+    int decimation = std::max(1, heatmap_decimation_);
+    return (grid_size_ + decimation - 1) / decimation;
+  }
+  /**
+   * @brief Returns the decimated power map of the last frame.
+   *
+   * Value [x * get_heatmap_size() + y] averages the grid points of one block, x running from -grid_x / 2 upwards
+   * and y from grid_y / 2 downwards, like get_generalized_cross_correlation().
+   * @return the power map of the last frame, empty if the heatmap is disabled
+   */
+  const std::vector<float> &get_last_heatmap() const {
+    return last_heatmap_;
+  }
   /**
    * @brief Checks whether the algorithm has been properly initialized
    * by the config setter
@@ -335,6 +551,111 @@ class SrpPhat : public Localizer {
   int get_last_position() const {
     return last_position_;
   }
+  /**
+   * @brief Returns the elevation of the speaker in the last frame.
+   *
+   * Elevations are measured in degrees from the horizontal plane through the centre of the array, negative values
+   * lie below the array. Planar setups always return 0, the fixed point path does not estimate elevations.
+   * @return elevation of the strongest grid region at the azimuth of get_last_position()
+   */
+  int get_last_elevation() const {
+    return last_elevation_;
+  }
+  /**
+   * @brief Checks whether frames are checked for speech before they are localized.
+   * @return true if the spectral voice activity detection is enabled, false otherwise.
+   */
+  bool is_spectral_vad() const {
+    return spectral_vad_;
+  }
+  /**
+   * @brief Returns whether the last frame contained speech.
+   *
+   * Only the spectral voice activity detection may reject frames, silent frames skip the inverse transforms and
+   * the projection and keep position and distribution of the previous frame.
+   * @return false if the last frame was classified as silence
+   */
+  bool get_last_voice() const {
+    return last_voice_;
+  }
+  /**
+   * @brief Returns the number of values get_lag_vectors() produces per frame.
+   * @return number of distinct grid lags summed over all microphone pairs
+   */
+  int get_lag_vector_size() const;
+  /**
+   * @brief Computes the cross correlation of every microphone pair at the lags reachable from the grid.
+   *
+   * Meant for capture nodes: the lag vectors are far smaller than the frame and calculate_from_lag_vectors()
+   * turns them into a localization on a host using the same audio settings.
+   * @param frame a view on an interleaved frame containing one channel per microphone
+   * @return the lag values of all pairs one after another, in the order of get_microphone_pairs()
+   */
+  std::vector<double> get_lag_vectors(const utils::SignalView &frame);
+  /**
+   * @brief Projects lag vectors of get_lag_vectors() onto the grid and stores position and distribution.
+   *
+   * The frame itself is not available, so the beamformed frame is not updated.
+   * @param lag_values lag vectors of all pairs
+   * @return false if the number of values does not match get_lag_vector_size()
+   */
+  bool calculate_from_lag_vectors(const std::vector<double> &lag_values);
+  /**
+   * @brief Returns the summed up grid values of each degree of the last frame before normalization.
+   *
+   * The sums of several shards of the same frame add up to the sums of the whole frame.
+   * @return 360 unnormalized degree values of the last frame
+   */
+  const RArray &get_last_degree_values() const {
+    return last_degree_values_;
+  }
+  /**
+   * @brief Stores position and distribution of degree values computed elsewhere.
+   *
+   * Used by the coordinator of a distributed localization after adding up the values of all shards.
+   * @param degree_values 360 unnormalized degree values
+   */
+  void set_degree_values(const RArray &degree_values) {
+    store_result(degree_values);
+  }
+  /**
+   * @brief Restricts the evaluated microphone pairs to one of several shards.
+   *
+   * Shard s evaluates the scheduled pairs whose index modulo shard_count equals s. Windowed search and
+   * beamforming need all pairs and channels and should be disabled for sharded localizers.
+   * @param shard index of the shard, from 0 up to shard_count - 1
+   * @param shard_count number of shards, 1 evaluates all pairs
+   */
+  void set_shard(int shard, int shard_count) {
+    shard_ = shard;
+    shard_count_ = std::max(1, shard_count);
+  }
+  /**
+   * @brief Places the next frame in the round robin rotation by its number.
+   *
+   * Shards may miss frames, so instead of counting the frames they evaluated they derive the scheduled pairs from
+   * the sequence number of the frame. All shards of a frame then agree on its pairs.
+   * @param frame number of the next frame, frame 0 starts with the first pair
+   */
+  void set_frame_number(int64_t frame) {
+    int64_t pair_count = static_cast<int64_t>(pairs_.size());
+    if (pair_count > 0 && max_pairs_ > 0) {
+      int64_t rotation = frame % pair_count;
+      if (rotation < 0)
+        rotation += pair_count;
+      round_robin_offset_ = static_cast<int>(rotation * max_pairs_ % pair_count);
+    }
+  }
+
+  /**
+   * @brief Shares thread pool, FFT plans and lookup tables with the localizers of other microphone arrays.
+   *
+   * Has to be called before set_config().
+   * @param engine resources shared by all arrays of the process
+   */
+  void set_engine(const std::shared_ptr<SrpEngine> &engine) {
+    engine_ = engine;
+  }
 
   /**
   * @brief Sets all relevant parameters of the srp phat algorithm.
@@ -348,20 +669,90 @@ class SrpPhat : public Localizer {
     stepsize_ = audioConfig.interval;
     x_dim_mics_ = audioConfig.mic_x;
     y_dim_mics_ = audioConfig.mic_y;
+    z_dim_mics_ = audioConfig.mic_z.size() == audioConfig.mic_x.size() ?
+        audioConfig.mic_z : RArray(0.0, audioConfig.mic_x.size());
+    z_slices_ = audioConfig.grid_z.size() > 0 ?
+        audioConfig.grid_z : RArray(0.0, 1);
     frame_size_ = audioConfig.frame_size;
+    if (audioConfig.decimated_rate > 0 &&
+        audioConfig.decimated_rate < audioConfig.sample_rate) {
+      // frames arrive decimated, delays and frame length follow the new rate
+      frame_size_ = static_cast<int>(static_cast<int64_t>(frame_size_) *
+          audioConfig.decimated_rate / audioConfig.sample_rate);
+      samplerate_ = audioConfig.decimated_rate;
+    }
     beta_ = audioConfig.beta;
-    delay_tensor_ = get_delay_tensor();
+    pair_selection_ = audioConfig.pair_selection;
+    max_pairs_ = audioConfig.max_pairs;
+    min_baseline_ = audioConfig.min_baseline;
+    band_low_ = audioConfig.band_low;
+    band_high_ = audioConfig.band_high;
+    subbands_ = std::max(1, audioConfig.subbands);
+    pairs_ = get_microphone_pairs();
+    round_robin_offset_ = 0;
+    tracking_ = audioConfig.tracking;
+    tracking_window_ = audioConfig.tracking_window;
+    full_sweep_interval_ = audioConfig.full_sweep_interval;
+    tracker_ = AzimuthTracker(audioConfig.tracking_alpha,
+                              audioConfig.tracking_beta);
+    frames_since_sweep_ = 0;
+    sweep_requested_ = true;
+    beamforming_ = audioConfig.beamforming;
+    heatmap_decimation_ = audioConfig.heatmap_decimation;
+    spectral_vad_ = audioConfig.vad == utils::VadMode::kSpectral;
+    vad_ = utils::VadSpectral(audioConfig.vad_threshold, samplerate_);
+    last_voice_ = true;
+    build_lookup_tables();
+    pool_.reset();
+    if (subbands_ > 1 && engine_) {
+      pool_ = engine_->get_pool();
+    } else if (subbands_ > 1) {
+      int threads = std::min(subbands_, static_cast<int>(
+          std::max(1u, std::thread::hardware_concurrency())));
+      pool_ = std::make_shared<utils::ThreadPool>(threads);
+    }
     intialized_ = true;
   }
 
+ protected:
+  // microphone pairs chosen by the pair selection policy
+  std::vector<std::tuple<int, int>> pairs_;
+  // number of grid points along each axis
+  int grid_size_ = 0;
+  // number of grid points of all slices, point (slice * grid_size_ + x) * grid_size_ + y
+  int point_count_ = 0;
+  // length of the zero padded frames used for the cross correlation,
+  // the smallest power of two holding two frames
+  size_t fft_length_ = 0;
+  // lookup tables of the current geometry, possibly shared with other arrays
+  std::shared_ptr<const SrpTables> tables_;
+  // first positive frequency bin inside the configured band
+  size_t band_first_ = 0;
+  // last positive frequency bin inside the configured band
+  size_t band_last_ = 0;
+  // returns whether bin k or its positive frequency counterpart is in the band
+  bool in_band(size_t k) const {
+    size_t bin = k <= fft_length_ / 2 ? k : fft_length_ - k;
+    return bin >= band_first_ && bin <= band_last_;
+  }
+  // returns the phase transformed cross spectrum of a pair at bin k
+  Complex weighted_cross_spectrum(int pair, size_t k) const;
+  // returns which channels are used by the given pairs
+  std::vector<bool> get_used_channels(const std::vector<int> &frame_pairs) const;
+  // stores position and normalized distribution of a frame
+  void store_result(const RArray &degree_values);
+
  private:
   // last computed position distribution of the speaker;
   RArray last_distribution_ = RArray(360);
   // last computed position of the speaker
   int last_position_ = 0;
-  // nested vector containing delays for each
-  // point in the considered space considering each microphone pair
-  std::vector<std::vector<std::vector<double>>> delay_tensor_;
+  // unnormalized degree values of the last frame
+  RArray last_degree_values_ = RArray(360);
+  // shard of the scheduled pairs evaluated by this instance
+  int shard_ = 0;
+  // number of shards the scheduled pairs are split into
+  int shard_count_ = 1;
   // audio sample rate the algorithm should work with
   int samplerate_ = 0;
   // size of the grids x axis to consider for the estimation
@@ -375,11 +766,154 @@ class SrpPhat : public Localizer {
   RArray x_dim_mics_;
   // Y coordinates of the microphones in the grid
   RArray y_dim_mics_;
+  // Z coordinates of the microphones in the grid
+  RArray z_dim_mics_;
+  // heights of the evaluated horizontal grid slices
+  RArray z_slices_;
+  // elevation of the speaker in the last frame
+  int last_elevation_ = 0;
+  // summed up grid values of each azimuth and elevation bin of the last frame
+  std::vector<double> bin_values_;
   // steps The amount of sampled points an audio signal has
   // that needs to be evaluated.
   int frame_size_ = 0;
   // beta The exponent of the weighting term of the cross correlation.
   double beta_ = 0.0;
+  // policy deciding which microphone pairs are evaluated
+  utils::PairSelectionPolicy pair_selection_ = utils::PairSelectionPolicy::kAll;
+  // maximum number of pairs evaluated per frame, 0 means no limit
+  int max_pairs_ = 0;
+  // minimum distance between two microphones of an evaluated pair
+  double min_baseline_ = 0.0;
+  // index of the first pair evaluated in the next round robin frame
+  int round_robin_offset_ = 0;
+  // lower limit of the evaluated frequency band in Hz
+  double band_low_ = 0.0;
+  // upper limit of the evaluated frequency band in Hz, 0 means Nyquist
+  double band_high_ = 0.0;
+  // number of subbands evaluated in parallel
+  int subbands_ = 1;
+  // workers evaluating the subbands, only created for more than one subband
+  std::shared_ptr<utils::ThreadPool> pool_;
+  // optional resources shared with the localizers of other arrays
+  std::shared_ptr<SrpEngine> engine_;
+  // transform of the zero padded frames
+  std::shared_ptr<utils::FftPlan> fft_plan_;
+  // partial lag values of every subband for the scheduled pairs
+  std::vector<std::vector<double>> subband_values_;
+  // whether frames are restricted to a window around the tracked speaker
+  bool tracking_ = false;
+  // half width of the search window in degrees
+  double tracking_window_ = 30.0;
+  // maximum number of windowed frames between two full sweeps
+  int full_sweep_interval_ = 25;
+  // follows the azimuth of the speaker over the frames
+  AzimuthTracker tracker_;
+  // windowed frames since the last full sweep
+  int frames_since_sweep_ = 0;
+  // forces a full sweep in the next frame
+  bool sweep_requested_ = true;
+  // grid points inside the search window of the current frame
+  std::vector<int> search_points_;
+  // distinct lags of each scheduled pair within the search window
+  std::vector<std::vector<int>> window_lags_;
+  // position in window_lags_ for each scheduled pair and window point
+  std::vector<int> window_slots_;
+  // position of each lag in window_lags_ while collecting, -1 otherwise
+  std::vector<int> lag_marks_;
+  // whether a beamformed stream is produced, needs the spectra of all channels
+  bool beamforming_ = false;
+  // spectrum of the beamformed frame
+  CArray beam_spectrum_;
+  // beamformed samples of the last frame
+  std::vector<double> beam_frame_;
+  // part of the previous beamformed frames reaching into the next ones
+  std::vector<double> beam_overlap_;
+  // steers the cached channel spectra towards last_position_ and adds them
+  void beamform();
+  // whether the power map of each frame is stored
+  bool heatmap_enabled_ = false;
+  // grid points per heatmap value along each axis
+  int heatmap_decimation_ = 1;
+  // decimated power map of the last frame
+  std::vector<float> last_heatmap_;
+  // whether frames are checked for speech on their spectra before localizing
+  bool spectral_vad_ = false;
+  // voice activity detection on the spectrum of the first transformed channel
+  utils::VadSpectral vad_;
+  // whether the last frame contained speech
+  bool last_voice_ = true;
+  // decimates and stores the power map of a frame
+  void store_heatmap(const std::vector<double> &grid);
+  // stores all results of a frame and updates the tracker, the beamformer
+  // only if the channel spectra belong to the frame
+  void finish_frame(const std::vector<double> &grid, bool windowed,
+                    bool spectra);
+  // returns the pairs reaching the minimum baseline, longest first if over budget
+  std::vector<std::tuple<int, int>> select_minimum_baseline(
+      const std::vector<std::tuple<int, int>> &pairs) const;
+  // greedily picks the pairs whose baselines differ most in orientation
+  std::vector<std::tuple<int, int>> select_diverse_pairs(
+      const std::vector<std::tuple<int, int>> &pairs) const;
+  // spectrum of the zero padded frame of each channel
+  std::vector<CArray> channel_spectra_;
+  // sample following the frame of each channel, the first signal of a pair
+  // is one sample longer than the second one
+  std::vector<double> channel_tails_;
+  // precomputes the lag and degree lookup tables for the current settings
+  void build_lookup_tables();
+  // builds the tables depending on the geometry only
+  std::shared_ptr<const SrpTables> build_tables();
+  // describes everything build_tables() depends on
+  std::string get_table_key() const;
+  // transforms a single channel into channel_spectra_ and channel_tails_
+  void transform_channel(int channel, const double *samples,
+                         int64_t stride, int64_t length);
+  // sums up the cross correlations of the given pairs for each grid point,
+  // only the points of the search window if windowed is set
+  std::vector<double> accumulate_grid(const std::vector<int> &frame_pairs,
+                                      bool windowed);
+  // evaluates the given lags of each scheduled pair from the in-band bins,
+  // one subband per task, the values of slot s start at offsets[s]
+  std::vector<double> evaluate_lags(
+      const std::vector<int> &frame_pairs,
+      const std::vector<const std::vector<int> *> &lags,
+      std::vector<size_t> *offsets);
+  // like accumulate_grid, but evaluates only the lags needed by the grid
+  std::vector<double> accumulate_subbands(const std::vector<int> &frame_pairs);
+  // like accumulate_subbands, restricted to the points of the search window
+  std::vector<double> accumulate_window(const std::vector<int> &frame_pairs);
+  // decides whether the next frame only searches the predicted window and
+  // collects the grid points of that window
+  bool prepare_search_window();
+  // feeds the position of the last frame to the tracker
+  void update_tracker(bool windowed);
+  // transforms the channels used by the given pairs of a frame given as one
+  // RArray per channel
+  void transform_frame(const std::vector<RArray> &signals,
+                       const std::vector<int> &frame_pairs);
+  // transforms the channels used by the given pairs of an interleaved frame
+  void transform_frame(const utils::SignalView &frame,
+                       const std::vector<int> &frame_pairs);
+  // runs the spectral voice activity detection on the transformed frame,
+  // always true if it is disabled
+  bool detect_voice(const std::vector<int> &frame_pairs, int64_t length);
+  // computes the flat gcc grid of a frame given as one RArray per channel
+  std::vector<double> get_gcc_grid(const std::vector<RArray> &signals,
+                                   bool windowed = false);
+  // computes the flat gcc grid of an interleaved frame
+  std::vector<double> get_gcc_grid(const utils::SignalView &frame,
+                                   bool windowed = false);
+  // sums up the grid values belonging to each degree, fills bin_values_
+  // when several elevations are possible
+  RArray get_degree_values(const std::vector<double> &grid);
+  // picks the strongest elevation at the azimuth of the last frame
+  void store_elevation();
+  // adds up the values of all slices at each x-y position
+  std::vector<double> sum_slices(const std::vector<double> &grid) const;
+  // converts the flat gcc grid into nested vectors, summing up the slices
+  std::vector<std::vector<double>> unflatten_grid(
+      const std::vector<double> &grid) const;
   // boolean to check if an object has been initialized
   bool intialized_ = false;
 };
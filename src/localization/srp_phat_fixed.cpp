@@ -0,0 +1,218 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * @brief Implementation of srp_phat_fixed.h
+ */
+#include "localization/srp_phat_fixed.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace taylortrack {
+namespace localization {
+namespace {
+// marks bins without any energy
+const int32_t kNoEnergy = INT32_MIN;
+
+// index of the highest set bit, value has to be greater than zero
+int highest_bit(uint64_t value) {
+  return 63 - __builtin_clzll(value);
+}
+
+// log2 in Q10, linear interpolation between powers of two
+int32_t log2_q10(uint64_t value) {
+  int msb = highest_bit(value);
+  uint64_t mantissa = msb >= 10 ? value >> (msb - 10) : value << (10 - msb);
+  return (msb << 10) + static_cast<int32_t>(mantissa & 1023);
+}
+
+// 2^(exponent / 1024), linear interpolation between powers of two,
+// values below one are rounded down to zero
+int32_t pow2_q10(int32_t exponent) {
+  if (exponent < 0)
+    return 0;
+  return ((1024 + (exponent & 1023)) << (exponent >> 10)) >> 10;
+}
+
+// alpha max plus beta min approximation of sqrt(a^2 + b^2)
+uint64_t approximate_magnitude(uint64_t a, uint64_t b) {
+  uint64_t larger = std::max(a, b);
+  uint64_t smaller = std::min(a, b);
+  return larger - (larger >> 4) + (smaller >> 1) - (smaller >> 5);
+}
+}  // namespace
+
+void SrpPhatFixed::set_config(const taylortrack::utils::ConfigParser &config) {
+  SrpPhat::set_config(config);
+  fft_ = utils::FftFixed(fft_length_);
+  beta_q10_ = static_cast<int32_t>(std::lround(get_beta() * 1024));
+  size_t microphones = get_x_dim_mics().size();
+  fixed_spectra_.assign(microphones, utils::FixedCArray(fft_length_));
+  fixed_exponents_.assign(microphones, 0);
+  fixed_tails_.assign(microphones, 0);
+  cross_correlation_.resize(fft_length_);
+  fixed_tail_phases_.resize(fft_length_);
+  for (size_t k = 0; k < fft_length_; ++k) {
+    fixed_tail_phases_[k].real =
+        static_cast<int32_t>(std::lround(tables_->tail_phases[k].real() * 32768.0));
+    fixed_tail_phases_[k].imag =
+        static_cast<int32_t>(std::lround(tables_->tail_phases[k].imag() * 32768.0));
+  }
+}
+
+void SrpPhatFixed::cross_spectrum(int pair, size_t k,
+                                  int64_t *real, int64_t *imag) const {
+  int index1 = std::get<0>(pairs_[pair]);
+  const utils::FixedComplex &first = fixed_spectra_[index1][k];
+  const utils::FixedComplex &second =
+      fixed_spectra_[std::get<1>(pairs_[pair])][k];
+  // the first signal is one sample longer, see SrpPhat::weighted_cross_spectrum
+  int64_t tail = fixed_tails_[index1];
+  int64_t first_real = first.real + ((tail * fixed_tail_phases_[k].real) >> 15);
+  int64_t first_imag = first.imag + ((tail * fixed_tail_phases_[k].imag) >> 15);
+  *real = first_real * second.real + first_imag * second.imag;
+  *imag = first_imag * second.real - first_real * second.imag;
+}
+
+std::vector<int64_t> SrpPhatFixed::get_degree_sums(
+    const utils::Pcm16View &frame) {
+  std::vector<int> frame_pairs = schedule_frame_pairs();
+  std::vector<bool> used_channels = get_used_channels(frame_pairs);
+  int frame_size = get_steps();
+  int64_t frame_length = std::min(frame.length,
+                                  static_cast<int64_t>(frame_size));
+  for (int channel = 0; channel < static_cast<int>(used_channels.size());
+       ++channel) {
+    if (!used_channels[channel])
+      continue;
+    utils::FixedCArray &spectrum = fixed_spectra_[channel];
+    for (int64_t n = 0; n < frame_length; ++n) {
+      spectrum[n].real = frame.at(channel, n);
+      spectrum[n].imag = 0;
+    }
+    for (size_t n = static_cast<size_t>(frame_length); n < fft_length_; ++n)
+      spectrum[n] = utils::FixedComplex();
+    fixed_exponents_[channel] = fft_.fft(spectrum);
+    fixed_tails_[channel] = frame.length > frame_size ?
+        frame.at(channel, frame_size) >> fixed_exponents_[channel] : 0;
+  }
+
+  // first pass: logarithmic magnitude of every cross spectrum bin
+  log_magnitudes_.resize(frame_pairs.size() * fft_length_);
+  int32_t maximum = kNoEnergy;
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+    int pair = frame_pairs[slot];
+    int exponent = fixed_exponents_[std::get<0>(pairs_[pair])] +
+        fixed_exponents_[std::get<1>(pairs_[pair])];
+    for (size_t k = 0; k < fft_length_; ++k) {
+      // bins outside of the configured band stay empty
+      int32_t log_magnitude = kNoEnergy;
+      int64_t real = 0, imag = 0;
+      if (in_band(k))
+        cross_spectrum(pair, k, &real, &imag);
+      if (real != 0 || imag != 0) {
+        log_magnitude = log2_q10(approximate_magnitude(
+            static_cast<uint64_t>(std::llabs(real)),
+            static_cast<uint64_t>(std::llabs(imag)))) + (exponent << 10);
+      }
+      log_magnitudes_[slot * fft_length_ + k] = log_magnitude;
+      maximum = std::max(maximum, log_magnitude);
+    }
+  }
+
+  // second pass: weighting, inverse transformation and projection to degrees
+  std::vector<int64_t> degree_sums(360, 0);
+  int point_count = point_count_;
+  for (size_t slot = 0; slot < frame_pairs.size(); ++slot) {
+    int pair = frame_pairs[slot];
+    for (size_t k = 0; k < fft_length_; ++k) {
+      int32_t log_magnitude = log_magnitudes_[slot * fft_length_ + k];
+      cross_correlation_[k] = utils::FixedComplex();
+      if (log_magnitude == kNoEnergy)
+        continue;
+      int64_t real, imag;
+      cross_spectrum(pair, k, &real, &imag);
+      // reduce to 15 bits, enough to get the direction of the bin
+      uint64_t larger = static_cast<uint64_t>(
+          std::max(std::llabs(real), std::llabs(imag)));
+      int shift = std::max(0, highest_bit(larger) - 14);
+      int32_t reduced_real = static_cast<int32_t>(real / (INT64_C(1) << shift));
+      int32_t reduced_imag = static_cast<int32_t>(imag / (INT64_C(1) << shift));
+      int32_t reduced_magnitude = static_cast<int32_t>(approximate_magnitude(
+          static_cast<uint64_t>(std::abs(reduced_real)),
+          static_cast<uint64_t>(std::abs(reduced_imag))));
+      if (reduced_magnitude == 0)
+        continue;
+      // PHAT weighting leaves |C|^(1 - beta), taken relative to the
+      // strongest bin of the frame with a peak amplitude of 2^14
+      int32_t amplitude = pow2_q10(static_cast<int32_t>(
+          static_cast<int64_t>(1024 - beta_q10_) *
+              (log_magnitude - maximum) / 1024) + (14 << 10));
+      int32_t unit_real = reduced_real * (1 << 15) / reduced_magnitude;
+      int32_t unit_imag = reduced_imag * (1 << 15) / reduced_magnitude;
+      cross_correlation_[k].real = static_cast<int32_t>(
+          (static_cast<int64_t>(unit_real) * amplitude) >> 15);
+      cross_correlation_[k].imag = static_cast<int32_t>(
+          (static_cast<int64_t>(unit_imag) * amplitude) >> 15);
+    }
+    int exponent = fft_.ifft(cross_correlation_);
+    const int *lags = &tables_->lag_table[static_cast<size_t>(pair) * point_count];
+    for (int point = 0; point < point_count; ++point) {
+      degree_sums[tables_->point_degrees[point]] +=
+          static_cast<int64_t>(cross_correlation_[lags[point]].real)
+              * (INT64_C(1) << exponent);
+    }
+  }
+  return degree_sums;
+}
+
+void SrpPhatFixed::calculate_position_and_distribution(
+    const utils::Pcm16View &frame) {
+  std::vector<int64_t> degree_sums = get_degree_sums(frame);
+  RArray degree_values(degree_sums.size());
+  for (size_t degree = 0; degree < degree_sums.size(); ++degree)
+    degree_values[degree] = static_cast<double>(degree_sums[degree]);
+  store_result(degree_values);
+}
+
+RArray SrpPhatFixed::get_position_distribution(
+    const utils::Pcm16View &frame) {
+  std::vector<int64_t> degree_sums = get_degree_sums(frame);
+  int64_t total = 0;
+  for (int64_t sum : degree_sums)
+    total += sum;
+  // digital silence correlates nowhere, no direction is preferred
+  if (total == 0)
+    return RArray(1.0 / degree_sums.size(), degree_sums.size());
+  RArray distribution(degree_sums.size());
+  for (size_t degree = 0; degree < degree_sums.size(); ++degree)
+    distribution[degree] = static_cast<double>(degree_sums[degree]) / total;
+  return distribution;
+}
+}  // namespace localization
+}  // namespace taylortrack
@@ -0,0 +1,115 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implements the SRP PHAT algorithm in fixed point arithmetic
+*/
+#ifndef TAYLORTRACK_LOCALIZATION_SRP_PHAT_FIXED_H_
+#define TAYLORTRACK_LOCALIZATION_SRP_PHAT_FIXED_H_
+#include <cstdint>
+#include <vector>
+#include "localization/srp_phat.h"
+#include "utils/fft_fixed.h"
+#include "utils/signal_view.h"
+
+namespace taylortrack {
+namespace localization {
+/**
+* @class SrpPhatFixed
+* @brief SrpPhat variant working on raw 16 bit PCM frames with integer arithmetic only.
+*
+* Intended for small boards without a fast double precision floating point unit.
+* Uses the geometry tables of SrpPhat, a Q15 FftFixed, an integer cross spectrum and an
+* approximate PHAT weighting based on logarithm and power approximations.
+* Only the final 360 bin distribution is converted to double.
+* @code
+*  //Example usage:
+*  // configure the algorithm just like SrpPhat
+*  taylortrack::localization::SrpPhatFixed srp;
+*  srp.set_config(config);
+*
+*  // interleaved 16 bit samples as stored in a wave file
+*  std::vector<int16_t> samples(4 * 2049);
+*  taylortrack::utils::Pcm16View frame(samples.data(), 4, 4, 2049);
+*  srp.calculate_position_and_distribution(frame);
+*  int position = srp.get_last_position();
+* @endcode
+*/
+class SrpPhatFixed : public SrpPhat {
+ public:
+  using SrpPhat::calculate_position_and_distribution;
+  using SrpPhat::get_position_distribution;
+
+  /**
+   * @brief Standard constructor
+   */
+  SrpPhatFixed() = default;
+
+  /**
+  * @brief Sets all relevant parameters of the srp phat algorithm and prepares the fixed point transformation.
+  * @param config object containing the configuration from a config file
+  */
+  void set_config(const taylortrack::utils::ConfigParser &config) override;
+
+  /**
+  * @brief Gets most likely position of the recorded speaker in degrees and a probability distribution
+  * over angles and stores those values in appropiate class variables
+  * @param frame a view on an interleaved 16 bit PCM frame containing one channel per microphone
+  */
+  void calculate_position_and_distribution(const utils::Pcm16View &frame);
+
+  /**
+  * @brief Returns a probability distribution for the position of the speaker over all degrees
+  * @param frame a view on an interleaved 16 bit PCM frame containing one channel per microphone
+  * @return A RArray with all probability values
+  */
+  RArray get_position_distribution(const utils::Pcm16View &frame);
+
+ private:
+  // fixed point transformation of fft_length_ values
+  utils::FftFixed fft_;
+  // beta exponent in Q10
+  int32_t beta_q10_ = 0;
+  // spectrum of the zero padded frame of each channel
+  std::vector<utils::FixedCArray> fixed_spectra_;
+  // right shifts applied while transforming each channel
+  std::vector<int> fixed_exponents_;
+  // sample following the frame of each channel, scaled like its spectrum
+  std::vector<int32_t> fixed_tails_;
+  // Q15 version of the tail phases of SrpPhat
+  utils::FixedCArray fixed_tail_phases_;
+  // Q10 logarithm of the cross spectrum magnitude for each scheduled pair and bin
+  std::vector<int32_t> log_magnitudes_;
+  // buffer for the weighted cross spectrum of one pair
+  utils::FixedCArray cross_correlation_;
+  // sums up the weighted cross correlations for each degree
+  std::vector<int64_t> get_degree_sums(const utils::Pcm16View &frame);
+  // returns the cross spectrum of a pair at bin k
+  void cross_spectrum(int pair, size_t k, int64_t *real, int64_t *imag) const;
+};
+}  // namespace localization
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_LOCALIZATION_SRP_PHAT_FIXED_H_
@@ -30,6 +30,8 @@ SOFTWARE.
 #define TAYLORTRACK_SIM_DATA_RECEIVER_H_
 
 #include <yarp/os/all.h>
+#include <vector>
+#include "sim/frame_protocol.h"
 #include "utils/config.h"
 
 namespace taylortrack {
@@ -95,6 +97,27 @@ template <typename T> class DataReceiver {
     }
   }
 
+  /**
+   * @brief Reads a frame of samples from the YARP port
+   *
+   * Accepts packed frames as well as one double per sample, only available for DataReceiver<yarp::os::Bottle>.
+   * @param samples receives the interleaved samples
+   * @param blocking Determines whether the read call for the buffered port should be blocking or non-blocking
+   * @return false if nothing was read or the message holds no samples
+   */
+  bool read_samples(std::vector<double> *samples, bool blocking = true) const {
+    T *input = read_data(blocking);
+    return input && sim::read_samples(*input, samples);
+  }
+
+  /**
+   * @brief Returns the number of received messages not read yet
+   * @return number of queued messages, 0 if object has not been initialized
+   */
+  int get_pending_reads() const {
+    return buffered_port_ ? buffered_port_->getPendingReads() : 0;
+  }
+
  private:
   taylortrack::utils::CommunicationSettings in_settings_;
   yarp::os::Network yarp_;
@@ -0,0 +1,188 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Messages carrying frames of samples from the input modules to the audio tracking module.
+*/
+#ifndef TAYLORTRACK_SIM_FRAME_PROTOCOL_H_
+#define TAYLORTRACK_SIM_FRAME_PROTOCOL_H_
+
+#include <yarp/os/all.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "utils/config.h"
+
+namespace taylortrack {
+namespace sim {
+/**
+ * @brief Packs a frame of samples.
+ *
+ * The bottle holds the tag "frame", the sample format, the number of channels and the interleaved samples as one
+ * blob of 32 bit floats or 16 bit integers, instead of one tagged double per sample.
+ * @param samples interleaved samples, nominally between -1 and 1
+ * @param count number of samples of all channels
+ * @param channels number of interleaved channels
+ * @param format SampleTransport::kFloat32 or SampleTransport::kInt16, which clips samples beyond +-1
+ * @param payload scratch buffer for the packed samples, owned by the caller so that its allocation is reused
+ * @param bottle bottle receiving the message, cleared first
+ */
+inline void write_packed_frame(const double *samples, size_t count, int channels,
+                               utils::SampleTransport format, std::vector<char> *payload,
+                               yarp::os::Bottle *bottle) {
+  bottle->clear();
+  bottle->addString("frame");
+  bottle->addInt(static_cast<int>(format));
+  bottle->addInt(channels);
+  // copied value by value, the byte buffer carries no alignment guarantee
+  if (format == utils::SampleTransport::kInt16) {
+    payload->resize(count * sizeof(int16_t));
+    for (size_t sample = 0; sample < count; ++sample) {
+      double scaled = std::max(-1.0, std::min(1.0, samples[sample])) * 32767.0;
+      int16_t value = static_cast<int16_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+      std::memcpy(payload->data() + sample * sizeof(int16_t), &value, sizeof(int16_t));
+    }
+  } else {
+    payload->resize(count * sizeof(float));
+    for (size_t sample = 0; sample < count; ++sample) {
+      float value = static_cast<float>(samples[sample]);
+      std::memcpy(payload->data() + sample * sizeof(float), &value, sizeof(float));
+    }
+  }
+  bottle->add(yarp::os::Value(payload->data(), static_cast<int>(payload->size())));
+}
+
+/**
+ * @brief Checks whether a bottle was written by write_packed_frame().
+ * @param bottle received message
+ * @return true for packed frames
+ */
+inline bool is_packed_frame(const yarp::os::Bottle &bottle) {
+  return bottle.size() == 4 && bottle.get(0).isString() &&
+      bottle.get(0).asString() == "frame" && bottle.get(3).isBlob();
+}
+
+/**
+ * @brief Unpacks a frame written by write_packed_frame().
+ * @param bottle received message
+ * @param channels receives the number of channels, may be nullptr
+ * @param samples receives the interleaved samples
+ * @return false if the bottle is no packed frame
+ */
+inline bool read_packed_frame(const yarp::os::Bottle &bottle, int *channels,
+                              std::vector<double> *samples) {
+  if (!is_packed_frame(bottle))
+    return false;
+  int format = bottle.get(1).asInt();
+  const yarp::os::Value &blob = bottle.get(3);
+  const char *payload = blob.asBlob();
+  size_t length = blob.asBlobLength();
+  // copied value by value, the blob carries no alignment guarantee
+  if (format == static_cast<int>(utils::SampleTransport::kInt16)) {
+    samples->resize(length / sizeof(int16_t));
+    for (size_t sample = 0; sample < samples->size(); ++sample) {
+      int16_t value;
+      std::memcpy(&value, payload + sample * sizeof(int16_t), sizeof(int16_t));
+      (*samples)[sample] = value / 32767.0;
+    }
+  } else if (format == static_cast<int>(utils::SampleTransport::kFloat32)) {
+    samples->resize(length / sizeof(float));
+    for (size_t sample = 0; sample < samples->size(); ++sample) {
+      float value;
+      std::memcpy(&value, payload + sample * sizeof(float), sizeof(float));
+      (*samples)[sample] = value;
+    }
+  } else {
+    return false;
+  }
+  if (channels)
+    *channels = bottle.get(2).asInt();
+  return true;
+}
+
+/**
+ * @brief Copies the payload of an int16 frame written by write_packed_frame() without converting it.
+ *
+ * The fixed point localization works on these samples directly, see utils::Pcm16View.
+ * @param bottle received message
+ * @param channels receives the number of channels, may be nullptr
+ * @param samples receives the interleaved 16 bit samples
+ * @return false if the bottle is no packed frame of 16 bit samples
+ */
+inline bool read_packed_pcm16(const yarp::os::Bottle &bottle, int *channels,
+                              std::vector<int16_t> *samples) {
+  if (!is_packed_frame(bottle) ||
+      bottle.get(1).asInt() != static_cast<int>(utils::SampleTransport::kInt16))
+    return false;
+  const yarp::os::Value &blob = bottle.get(3);
+  samples->resize(blob.asBlobLength() / sizeof(int16_t));
+  // a single copy, the blob carries no alignment guarantee
+  std::memcpy(samples->data(), blob.asBlob(), samples->size() * sizeof(int16_t));
+  if (channels)
+    *channels = bottle.get(2).asInt();
+  return true;
+}
+
+/**
+ * @brief Writes a frame of samples in the configured transport format.
+ * @param samples interleaved samples
+ * @param count number of samples of all channels
+ * @param channels number of interleaved channels
+ * @param transport one double per sample or a packed frame
+ * @param payload scratch buffer for packed frames, see write_packed_frame()
+ * @param bottle bottle receiving the message, cleared first
+ */
+inline void write_samples(const double *samples, size_t count, int channels,
+                          utils::SampleTransport transport, std::vector<char> *payload,
+                          yarp::os::Bottle *bottle) {
+  if (transport != utils::SampleTransport::kBottle) {
+    write_packed_frame(samples, count, channels, transport, payload, bottle);
+    return;
+  }
+  bottle->clear();
+  for (size_t sample = 0; sample < count; ++sample)
+    bottle->addDouble(samples[sample]);
+}
+
+/**
+ * @brief Reads a frame of samples in any transport format.
+ * @param bottle received message, a packed frame or one double per sample
+ * @param samples receives the interleaved samples
+ * @return false if the bottle holds other values, like lag vectors
+ */
+inline bool read_samples(const yarp::os::Bottle &bottle, std::vector<double> *samples) {
+  if (read_packed_frame(bottle, nullptr, samples))
+    return true;
+  if (bottle.size() > 0 && !bottle.get(0).isDouble())
+    return false;
+  samples->resize(static_cast<size_t>(bottle.size()));
+  for (int sample = 0; sample < bottle.size(); ++sample)
+    (*samples)[sample] = bottle.get(sample).asDouble();
+  return true;
+}
+}  // namespace sim
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_SIM_FRAME_PROTOCOL_H_
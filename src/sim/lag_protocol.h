@@ -0,0 +1,86 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Messages carrying the cross correlation lag vectors computed on a capture node.
+*/
+#ifndef TAYLORTRACK_SIM_LAG_PROTOCOL_H_
+#define TAYLORTRACK_SIM_LAG_PROTOCOL_H_
+
+#include <yarp/os/all.h>
+#include <cstring>
+#include <vector>
+
+namespace taylortrack {
+namespace sim {
+/**
+ * @brief Packs the lag vectors of a frame.
+ *
+ * The bottle holds the tag "lags", the voice activity of the frame and the lag values as one blob of doubles,
+ * so receivers can tell it apart from frames of raw samples.
+ * @param voice whether voice activity was detected in the frame
+ * @param lag_values lag vectors of all microphone pairs
+ * @param bottle bottle receiving the message, cleared first
+ */
+inline void write_lag_vectors(bool voice, const std::vector<double> &lag_values,
+                              yarp::os::Bottle *bottle) {
+  bottle->clear();
+  bottle->addString("lags");
+  bottle->addInt(voice ? 1 : 0);
+  bottle->add(yarp::os::Value(lag_values.data(), static_cast<int>(
+      lag_values.size() * sizeof(double))));
+}
+
+/**
+ * @brief Checks whether a bottle was written by write_lag_vectors().
+ * @param bottle received message
+ * @return true for lag vector messages, false for raw frames
+ */
+inline bool is_lag_message(const yarp::os::Bottle &bottle) {
+  return bottle.size() == 3 && bottle.get(0).isString() &&
+      bottle.get(0).asString() == "lags" && bottle.get(2).isBlob();
+}
+
+/**
+ * @brief Unpacks the lag vectors of a message written by write_lag_vectors().
+ * @param bottle received message
+ * @param voice receives the voice activity of the frame
+ * @param lag_values receives the lag vectors of all microphone pairs
+ * @return false if the bottle is no lag vector message
+ */
+inline bool read_lag_vectors(const yarp::os::Bottle &bottle, bool *voice,
+                             std::vector<double> *lag_values) {
+  if (!is_lag_message(bottle))
+    return false;
+  *voice = bottle.get(1).asInt() != 0;
+  // copied, the blob carries no alignment guarantee
+  lag_values->resize(bottle.get(2).asBlobLength() / sizeof(double));
+  std::memcpy(lag_values->data(), bottle.get(2).asBlob(),
+              lag_values->size() * sizeof(double));
+  return true;
+}
+}  // namespace sim
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_SIM_LAG_PROTOCOL_H_
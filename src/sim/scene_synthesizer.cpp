@@ -0,0 +1,213 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the scene_synthesizer.h
+*/
+#include "sim/scene_synthesizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace taylortrack {
+namespace sim {
+namespace {
+const double kPI = 3.14159265358979323846;
+
+// splitmix64 finalizer, turns consecutive integers into independent random bits
+uint64_t mix(uint64_t value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+}  // namespace
+
+const double SceneSynthesizer::kSpeedOfSound = 340.42;
+const double SceneSynthesizer::kMinDistance = 0.1;
+
+SceneSynthesizer::SceneSynthesizer(const utils::AudioSettings &audio_settings,
+                                   const utils::SyntheticInputSettings &settings)
+    : sources_(settings.sources),
+      sample_rate_(audio_settings.sample_rate),
+      samples_per_meter_(audio_settings.sample_rate / kSpeedOfSound),
+      half_width_(audio_settings.grid_x / 2.0),
+      half_depth_(audio_settings.grid_y / 2.0),
+      reflection_(settings.reflection),
+      noise_(settings.noise),
+      seed_(mix(static_cast<uint64_t>(settings.seed))),
+      noise_engine_(static_cast<uint32_t>(settings.seed)),
+      noise_distribution_(0.0, 1.0) {
+  for (size_t microphone = 0; microphone < audio_settings.mic_x.size(); ++microphone) {
+    Microphone position;
+    position.x = audio_settings.mic_x[microphone];
+    position.y = audio_settings.mic_y[microphone];
+    position.z = audio_settings.mic_z.size() == audio_settings.mic_x.size() ?
+        audio_settings.mic_z[microphone] : 0.0;
+    microphones_.push_back(position);
+  }
+  // the interpolation reads one sample before and two after the delayed position
+  max_delay_ = static_cast<int64_t>(std::ceil(get_max_distance() * samples_per_meter_)) + 2;
+}
+
+void SceneSynthesizer::synthesize(size_t frames, double *output) {
+  size_t channels = microphones_.size();
+  std::fill(output, output + frames * channels, 0.0);
+
+  // sample j of source s is signal_[s * length + j], the sample emitted at position_ - max_delay_ + j
+  size_t length = frames + static_cast<size_t>(max_delay_) + 3;
+  signal_.resize(length * sources_.size());
+  for (size_t source = 0; source < sources_.size(); ++source) {
+    for (size_t sample = 0; sample < length; ++sample)
+      signal_[source * length + sample] =
+          source_sample(source, position_ - max_delay_ + static_cast<int64_t>(sample));
+  }
+
+  for (size_t frame = 0; frame < frames; ++frame) {
+    double *frame_output = output + frame * channels;
+    double time = static_cast<double>(position_ + static_cast<int64_t>(frame)) / sample_rate_;
+    double read_position = static_cast<double>(frame + static_cast<size_t>(max_delay_));
+    for (size_t source = 0; source < sources_.size(); ++source) {
+      const double *signal = signal_.data() + source * length;
+      double x = 0.0;
+      double y = 0.0;
+      get_source_position(source, time, &x, &y);
+      add_emitter(x, y, 1.0, signal, read_position, frame_output);
+      if (reflection_ > 0.0) {
+        // mirror sources behind the four walls
+        add_emitter(2.0 * half_width_ - x, y, reflection_, signal, read_position, frame_output);
+        add_emitter(-2.0 * half_width_ - x, y, reflection_, signal, read_position, frame_output);
+        add_emitter(x, 2.0 * half_depth_ - y, reflection_, signal, read_position, frame_output);
+        add_emitter(x, -2.0 * half_depth_ - y, reflection_, signal, read_position, frame_output);
+      }
+    }
+    if (noise_ > 0.0) {
+      for (size_t channel = 0; channel < channels; ++channel)
+        frame_output[channel] += noise_ * noise_distribution_(noise_engine_);
+    }
+  }
+  position_ += static_cast<int64_t>(frames);
+}
+
+void SceneSynthesizer::get_source_position(size_t source, double time, double *x, double *y) const {
+  const utils::SyntheticSource &description = sources_[source];
+  double cycle = time / description.period - std::floor(time / description.period);
+  switch (description.trajectory) {
+    case utils::TrajectoryType::kLine: {
+      // there during the first half of the period, back during the second
+      double progress = cycle < 0.5 ? 2.0 * cycle : 2.0 - 2.0 * cycle;
+      *x = description.x + (description.x_end - description.x) * progress;
+      *y = description.y + (description.y_end - description.y) * progress;
+      break;
+    }
+    case utils::TrajectoryType::kCircle: {
+      double angle = 2.0 * kPI * cycle;
+      *x = description.x + description.radius * std::cos(angle);
+      *y = description.y + description.radius * std::sin(angle);
+      break;
+    }
+    default:
+      *x = description.x;
+      *y = description.y;
+      break;
+  }
+}
+
+double SceneSynthesizer::source_sample(size_t source, int64_t index) const {
+  uint64_t bits = mix(seed_ + mix(static_cast<uint64_t>(source)) + static_cast<uint64_t>(index));
+  // 53 random bits scaled to [-1, 1)
+  return static_cast<double>(bits >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+void SceneSynthesizer::add_emitter(double x, double y, double gain, const double *signal,
+                                   double read_position, double *output) const {
+  for (size_t channel = 0; channel < microphones_.size(); ++channel) {
+    const Microphone &microphone = microphones_[channel];
+    double delta_x = x - microphone.x;
+    double delta_y = y - microphone.y;
+    double distance = std::sqrt(delta_x * delta_x + delta_y * delta_y + microphone.z * microphone.z);
+
+    double delayed = read_position - distance * samples_per_meter_;
+    double index = std::floor(delayed);
+    double t = delayed - index;
+    const double *samples = signal + static_cast<ptrdiff_t>(index) - 1;
+    // cubic Lagrange interpolation between samples[1] and samples[2]
+    double value = -t * (t - 1.0) * (t - 2.0) / 6.0 * samples[0]
+        + (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0 * samples[1]
+        - (t + 1.0) * t * (t - 2.0) / 2.0 * samples[2]
+        + (t + 1.0) * t * (t - 1.0) / 6.0 * samples[3];
+    output[channel] += gain / std::max(distance, kMinDistance) * value;
+  }
+}
+
+double SceneSynthesizer::get_max_distance() const {
+  // a trajectory stays within its bounding box, the farthest point of a box is one of its corners
+  std::vector<double> corners_x;
+  std::vector<double> corners_y;
+  for (const utils::SyntheticSource &source : sources_) {
+    double min_x = source.x;
+    double max_x = source.x;
+    double min_y = source.y;
+    double max_y = source.y;
+    if (source.trajectory == utils::TrajectoryType::kLine) {
+      min_x = std::min(source.x, source.x_end);
+      max_x = std::max(source.x, source.x_end);
+      min_y = std::min(source.y, source.y_end);
+      max_y = std::max(source.y, source.y_end);
+    } else if (source.trajectory == utils::TrajectoryType::kCircle) {
+      min_x -= source.radius;
+      max_x += source.radius;
+      min_y -= source.radius;
+      max_y += source.radius;
+    }
+    for (double corner_x : {min_x, max_x}) {
+      for (double corner_y : {min_y, max_y}) {
+        corners_x.push_back(corner_x);
+        corners_y.push_back(corner_y);
+        if (reflection_ > 0.0) {
+          corners_x.push_back(2.0 * half_width_ - corner_x);
+          corners_y.push_back(corner_y);
+          corners_x.push_back(-2.0 * half_width_ - corner_x);
+          corners_y.push_back(corner_y);
+          corners_x.push_back(corner_x);
+          corners_y.push_back(2.0 * half_depth_ - corner_y);
+          corners_x.push_back(corner_x);
+          corners_y.push_back(-2.0 * half_depth_ - corner_y);
+        }
+      }
+    }
+  }
+
+  double max_distance = 0.0;
+  for (const Microphone &microphone : microphones_) {
+    for (size_t corner = 0; corner < corners_x.size(); ++corner) {
+      double delta_x = corners_x[corner] - microphone.x;
+      double delta_y = corners_y[corner] - microphone.y;
+      max_distance = std::max(max_distance, std::sqrt(
+          delta_x * delta_x + delta_y * delta_y + microphone.z * microphone.z));
+    }
+  }
+  return max_distance;
+}
+}  // namespace sim
+}  // namespace taylortrack
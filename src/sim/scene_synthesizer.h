@@ -0,0 +1,157 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Synthesizes the microphone signals of moving sound sources.
+*/
+#ifndef TAYLORTRACK_SIM_SCENE_SYNTHESIZER_H_
+#define TAYLORTRACK_SIM_SCENE_SYNTHESIZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "utils/config.h"
+
+namespace taylortrack {
+namespace sim {
+/**
+* @class SceneSynthesizer
+* @brief Computes what the configured microphone array records from moving white noise sources.
+*
+* Every source signal reaches every microphone delayed by the travel time of the sound and attenuated by the
+* distance. The delays are fractional and change with every sample while a source moves, the delayed signal is
+* interpolated by a cubic Lagrange polynomial. With a reflection coefficient the four walls around the grid add
+* first order mirror sources, a cheap stand-in for reverberation. Independent gaussian noise is added to every
+* microphone. The source signals are derived from the seed and the sample index alone, so a scene is
+* reproducible and the positions returned by get_source_position() are its exact ground truth.
+* @code
+*  //Example usage:
+*  taylortrack::sim::SceneSynthesizer synthesizer(audio_settings, synthetic_settings);
+*  std::vector<double> frame(2048 * synthesizer.get_channels());
+*  // the next 2048 interleaved frames of all microphones
+*  synthesizer.synthesize(2048, frame.data());
+* @endcode
+*/
+class SceneSynthesizer {
+ public:
+  /**
+   * @brief Constructor
+   * @param audio_settings microphone positions, grid size and sample rate of the scene
+   * @param settings sources, noise, reflection coefficient and seed of the scene
+   */
+  SceneSynthesizer(const utils::AudioSettings &audio_settings,
+                   const utils::SyntheticInputSettings &settings);
+
+  /**
+   * @brief Synthesizes the next frames.
+   * @param frames number of frames per microphone
+   * @param output frames * get_channels() values, microphone c of frame i is written to output[i * get_channels() + c]
+   */
+  void synthesize(size_t frames, double *output);
+
+  /**
+   * @brief Computes where a source is at a point in time.
+   * @param source index of the source
+   * @param time seconds since the first synthesized frame
+   * @param x receives the x coordinate in meters
+   * @param y receives the y coordinate in meters
+   */
+  void get_source_position(size_t source, double time, double *x, double *y) const;
+
+  /**
+   * @brief Returns the number of sources.
+   * @return number of configured sources
+   */
+  size_t get_source_count() const {
+    return sources_.size();
+  }
+
+  /**
+   * @brief Returns the number of microphones.
+   * @return number of interleaved channels per frame
+   */
+  int get_channels() const {
+    return static_cast<int>(microphones_.size());
+  }
+
+  /**
+   * @brief Returns the sample rate of the scene.
+   * @return samples per second and microphone
+   */
+  int get_sample_rate() const {
+    return sample_rate_;
+  }
+
+  /**
+   * @brief Returns the number of frames synthesized so far.
+   * @return index of the next frame
+   */
+  int64_t get_position() const {
+    return position_;
+  }
+
+ private:
+  struct Microphone {
+    double x;
+    double y;
+    double z;
+  };
+
+  // speed of sound in meters per second, the same SrpPhat assumes
+  static const double kSpeedOfSound;
+  // distance below which the attenuation stops growing
+  static const double kMinDistance;
+
+  std::vector<Microphone> microphones_;
+  std::vector<utils::SyntheticSource> sources_;
+  int sample_rate_;
+  // travel time of the sound per meter in samples
+  double samples_per_meter_;
+  // walls at +-half_width_ and +-half_depth_, matching the grid of the localization
+  double half_width_;
+  double half_depth_;
+  double reflection_;
+  double noise_;
+  uint64_t seed_;
+  // longest travel time of any source or mirror source in samples, including the interpolation margin
+  int64_t max_delay_ = 0;
+  int64_t position_ = 0;
+  // source signals covering the current frames and their longest delay
+  std::vector<double> signal_;
+  std::mt19937 noise_engine_;
+  std::normal_distribution<double> noise_distribution_;
+
+  // value of a source signal at a sample index, uniform in [-1, 1)
+  double source_sample(size_t source, int64_t index) const;
+  // adds the signal arriving from an emitter at x, y with gain to all microphones of one frame
+  void add_emitter(double x, double y, double gain, const double *signal, double read_position,
+                   double *output) const;
+  // largest distance between any microphone and any place a source or its mirror sources reach
+  double get_max_distance() const;
+};
+}  // namespace sim
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_SIM_SCENE_SYNTHESIZER_H_
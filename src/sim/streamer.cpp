@@ -28,6 +28,7 @@ SOFTWARE.
 
 #include "sim/streamer.h"
 #include <unistd.h>
+#include <chrono>
 
 namespace taylortrack {
 namespace sim {
@@ -48,15 +49,30 @@ bool Streamer::start_streaming(const char *inport) {
 
     yarp.connect(out_port.getName(), yarp::os::ConstString(inport));
     while (!strategy_->is_done()) {
-      usleep(200000);
+      // paced strategies block in read() until their data is due
+      if (!strategy_->is_paced())
+        usleep(200000);
       yarp::os::Bottle &output = out_port.prepare();
       output.clear();
       strategy_->read(&output);
+      double timestamp = std::chrono::duration<double>(
+          std::chrono::system_clock::now().time_since_epoch()).count();
+      bool streamed = output.size() > 0;
       out_port.write(true);  // blocking statement
+      // recorded once the frame is on its way, from the samples the strategy still holds
+      if (recorder_ && streamed)
+        record(timestamp);
+      ++sequence_;
     }  // while
     return true;
   }  // if
 }
 
+void Streamer::record(double timestamp) {
+  const std::vector<double> *samples = strategy_->get_last_samples();
+  if (samples)
+    recorder_->record(sequence_, timestamp, samples->data(), samples->size());
+}
+
 }  // namespace sim
 }  // namespace taylortrack
@@ -28,7 +28,9 @@ SOFTWARE.
 #ifndef TAYLORTRACK_SIM_STREAMER_H_
 #define TAYLORTRACK_SIM_STREAMER_H_
 #include <stdbool.h>
+#include <cstdint>
 #include "input/input_strategy.h"
+#include "utils/capture_recorder.h"
 
 namespace taylortrack {
 namespace sim {
@@ -65,11 +67,30 @@ class Streamer {
    */
   bool start_streaming(const char *inport);
 
+  /**
+   * @brief Records every streamed frame of samples
+   *
+   * Frames are numbered in streaming order and stamped with the time they are streamed. After a frame was
+   * written to the port, the recorder copies the samples the strategy read, before any transport packing, and
+   * writes the file in the background. Strategies without samples, and frames of lag vectors, are numbered but
+   * not recorded.
+   * @param recorder recorder receiving the frames, nullptr stops recording
+   */
+  void set_recorder(taylortrack::utils::CaptureRecorder *recorder) {
+    recorder_ = recorder;
+  }
+
  private:
   // an implementation of the input strategy
   taylortrack::input::InputStrategy *strategy_;
   // the yarp port to which the data has to be streamed
   const char *outport_;
+  // receives the streamed frames if set
+  taylortrack::utils::CaptureRecorder *recorder_ = nullptr;
+  // number of the next streamed frame
+  uint64_t sequence_ = 0;
+  // hands the samples of the last streamed frame to the recorder
+  void record(double timestamp);
   // the default copy constructor
   Streamer(const Streamer &that) = delete;
 };
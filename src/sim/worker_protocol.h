@@ -0,0 +1,116 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Messages exchanged between the audio receiver and its localization workers.
+*/
+#ifndef TAYLORTRACK_SIM_WORKER_PROTOCOL_H_
+#define TAYLORTRACK_SIM_WORKER_PROTOCOL_H_
+
+#include <yarp/os/all.h>
+#include <cstring>
+#include <valarray>
+#include <vector>
+#include "utils/signal_view.h"
+
+namespace taylortrack {
+namespace sim {
+/**
+ * @brief Packs a frame for the workers.
+ *
+ * The bottle holds the sequence number, the number of channels and the interleaved samples as one blob of doubles.
+ * @param sequence number identifying the frame, also places it in the round robin pair schedule of the workers
+ * @param frame plain interleaved frame, stride and channels have to be equal
+ * @param bottle bottle receiving the message, cleared first
+ */
+inline void write_worker_frame(int sequence, const utils::SignalView &frame,
+                               yarp::os::Bottle *bottle) {
+  bottle->clear();
+  bottle->addInt(sequence);
+  bottle->addInt(frame.channels);
+  bottle->add(yarp::os::Value(frame.data, static_cast<int>(
+      frame.length * frame.channels * sizeof(double))));
+}
+
+/**
+ * @brief Unpacks a frame written by write_worker_frame().
+ * @param bottle received message
+ * @param sequence receives the sequence number
+ * @param channels receives the number of channels
+ * @param samples receives the interleaved samples
+ * @return false if the bottle is no frame message
+ */
+inline bool read_worker_frame(const yarp::os::Bottle &bottle, int *sequence,
+                              int *channels, std::vector<double> *samples) {
+  if (bottle.size() != 3 || !bottle.get(2).isBlob())
+    return false;
+  *sequence = bottle.get(0).asInt();
+  *channels = bottle.get(1).asInt();
+  // copied, the blob carries no alignment guarantee
+  samples->resize(bottle.get(2).asBlobLength() / sizeof(double));
+  std::memcpy(samples->data(), bottle.get(2).asBlob(),
+              samples->size() * sizeof(double));
+  return *channels > 0;
+}
+
+/**
+ * @brief Packs the partial degree values of a worker.
+ * @param sequence number of the frame the values belong to
+ * @param shard index of the worker
+ * @param degree_values 360 unnormalized degree values
+ * @param bottle bottle receiving the message, cleared first
+ */
+inline void write_worker_result(int sequence, int shard,
+                                const std::valarray<double> &degree_values,
+                                yarp::os::Bottle *bottle) {
+  bottle->clear();
+  bottle->addInt(sequence);
+  bottle->addInt(shard);
+  bottle->add(yarp::os::Value(&degree_values[0], static_cast<int>(
+      degree_values.size() * sizeof(double))));
+}
+
+/**
+ * @brief Adds the partial degree values of a message written by write_worker_result() to a sum.
+ * @param bottle received message
+ * @param sequence number of the expected frame, messages of other frames are ignored
+ * @param degree_sums sums of the values of all workers so far
+ * @return true if the values were added
+ */
+inline bool add_worker_result(const yarp::os::Bottle &bottle, int sequence,
+                              std::valarray<double> *degree_sums) {
+  if (bottle.size() != 3 || !bottle.get(2).isBlob() ||
+      bottle.get(0).asInt() != sequence ||
+      bottle.get(2).asBlobLength() != degree_sums->size() * sizeof(double))
+    return false;
+  std::valarray<double> values(degree_sums->size());
+  std::memcpy(&values[0], bottle.get(2).asBlob(),
+              values.size() * sizeof(double));
+  *degree_sums += values;
+  return true;
+}
+}  // namespace sim
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_SIM_WORKER_PROTOCOL_H_
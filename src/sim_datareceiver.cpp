@@ -4,67 +4,414 @@
  */
 
 #include "sim/data_receiver.h"
+#include "sim/frame_protocol.h"
+#include "sim/lag_protocol.h"
+#include "sim/worker_protocol.h"
 #include <yarp/os/all.h>
 #include <utils/vad_simple.h>
-#include "localization/srp_phat.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "localization/compute_governor.h"
+#include "localization/srp_engine.h"
+#include "localization/srp_phat_fixed.h"
+#include "utils/blocking_spsc_queue.h"
 #include "utils/config_parser.h"
 #include "utils/fft_strategy.h"
+#include "utils/polyphase_resampler.h"
+#include "utils/signal_view.h"
+#include "utils/vad_streaming.h"
+
+namespace {
+// number of frames in flight between receiving, computing and publishing
+const int kPipelineDepth = 4;
+// number of frames between two printed latency reports of a session
+const int kLatencyReportInterval = 500;
+// frame periods to wait for the results of the workers
+const double kWorkerTimeoutFrames = 4.0;
+
+// everything the publish stage needs to know about one frame
+struct PipelineResult {
+  bool voice = false;
+  std::vector<double> distribution;
+  std::vector<float> heatmap;
+  int heatmap_size = 0;
+  std::vector<double> beam;
+};
+
+// adds up the answers of the workers to a frame until all answered or the
+// timeout passed, late answers to older frames are dropped
+int collect_worker_results(yarp::os::BufferedPort<yarp::os::Bottle> *port, int sequence,
+                           int workers, double timeout,
+                           taylortrack::utils::RArray *degree_sums) {
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(timeout));
+  int answers = 0;
+  while (answers < workers && std::chrono::steady_clock::now() < deadline) {
+    yarp::os::Bottle *message = port->read(false);
+    if (!message) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      continue;
+    }
+    if (taylortrack::sim::add_worker_result(*message, sequence, degree_sums))
+      ++answers;
+  }
+  return answers;
+}
+}  // namespace
 
 /**
- * @brief receiving data main method
+ * @brief Serves one microphone array until the process is stopped.
  *
- * Initialize and open a port, wait for input from input bottle, and print positive message if successful
+ * Receiving, computing and publishing run on their own threads, so network transfers overlap the localization.
+ * @param yarp network all sessions are connected to
+ * @param session settings and ports of the array
+ * @param engine resources shared with the other arrays
+ * @return EXIT_FAILURE if the incoming port could not be opened
  */
-int main(int argc, char *argv[]) {
-    yarp::os::Network yarp;
-    taylortrack::utils::ConfigParser config("../conf/real_config.conf");
-    taylortrack::utils::CommunicationSettings out;
-    out = config.get_audio_communication_out();
+int run_session(yarp::os::Network &yarp, const taylortrack::utils::AudioSession &session,
+                const std::shared_ptr<taylortrack::localization::SrpEngine> &engine) {
     taylortrack::sim::DataReceiver<yarp::os::Bottle> rec;
-    bool data_receiver_initialized = rec.init(config.get_audio_communication_in());
-    if(data_receiver_initialized) {
-        taylortrack::utils::AudioSettings audio = config.get_audio_configuration();
-        taylortrack::localization::SrpPhat algorithm;// = taylortrack::localization::SrpPhat(audio.sample_rate, audio.mic_x, audio.mic_y, audio.grid_x, audio.grid_y, audio.interval, (int) audio.frame_size, audio.beta);
-        algorithm.set_config(config);
-        int microphones = static_cast<int>(audio.mic_x.size());
-        yarp::os::BufferedPort<yarp::os::Bottle> outport;
-        outport.open(out.port);
-        //yarp.connect(outport.getName(),yarp::os::ConstString(config.get_visualizer_communication_in().port));
-        yarp.connect(outport.getName(),yarp::os::ConstString(config.get_audio_communication_destination().port));
-
-        while (true) {
-            std::vector<taylortrack::utils::RArray> signals;
-            yarp::os::Bottle *new_data = rec.read_data(true);
-
-            for (int i = 0; i < microphones; ++i) {
-                taylortrack::utils::RArray volume(static_cast<size_t>(new_data->size()) / microphones);
-                int c = 0;
-                for (int j = i; j < new_data->size(); j += microphones) {
-                    volume[c] = new_data->get(j).asDouble();
-                    ++c;
-                }
-                signals.push_back(volume);
+    if (!rec.init(session.communication_in)) {
+        std::cout << "Error initializing incoming communication of " << session.name << "..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    int session_index = engine->add_session(session.name);
+    const taylortrack::utils::AudioSettings &audio = session.settings;
+    // optionally the microphone pairs are split across worker processes
+    bool distributed = audio.workers > 0;
+    // the workers always compute with the configured settings, so only local localization is governed
+    bool governed = audio.governor && !distributed;
+    // one algorithm per governor level with precomputed tables, level 0 uses the configured settings
+    taylortrack::localization::ComputeGovernor governor(audio, audio.governor_budget);
+    int levels = governed ? governor.get_level_count() : 1;
+    std::vector<taylortrack::localization::SrpPhatFixed> ladder(static_cast<size_t>(levels));
+    for (int level = 0; level < levels; ++level) {
+      taylortrack::utils::ConfigParser level_config;
+      level_config.set_audio_settings(governor.get_level_settings(level));
+      ladder[level].set_engine(engine);
+      ladder[level].set_config(level_config);
+    }
+    int microphones = static_cast<int>(audio.mic_x.size());
+    yarp::os::BufferedPort<yarp::os::Bottle> outport;
+    outport.open(session.communication_out.port);
+    //yarp.connect(outport.getName(),yarp::os::ConstString(config.get_visualizer_communication_in().port));
+    yarp.connect(outport.getName(),yarp::os::ConstString(session.communication_destination.port));
+    yarp::os::BufferedPort<yarp::os::Bottle> worker_outport;
+    yarp::os::BufferedPort<yarp::os::Bottle> worker_inport;
+    if (distributed) {
+      worker_outport.open(session.worker_communication_out.port);
+      worker_inport.open(session.worker_communication_in.port);
+    }
+    // number of the last frame sent to the workers
+    int sequence = 0;
+    double frame_period = static_cast<double>(audio.frame_size) / audio.sample_rate;
+    // the double precision path checks its spectra for speech, everything else the mean power
+    bool spectral_vad = audio.vad == taylortrack::utils::VadMode::kSpectral &&
+        !audio.fixed_point && !distributed;
+    taylortrack::utils::VadSimple vad(audio.vad_threshold);
+    // the streaming detection runs in the receive stage on each block as it is converted
+    bool streaming_vad = audio.vad == taylortrack::utils::VadMode::kStreaming;
+    taylortrack::utils::VadStreaming streaming(audio.vad_threshold, audio.vad_block_size,
+                                               audio.vad_hangover);
+    // enhanced mono stream towards the speaker, reuses the double precision spectra
+    bool beamforming = audio.beamforming && !audio.fixed_point && !distributed;
+    yarp::os::BufferedPort<yarp::os::Bottle> beam_outport;
+    if (beamforming)
+      beam_outport.open(session.beamform_communication_out.port);
+    // power map for debugging, only computed while someone is connected
+    yarp::os::BufferedPort<yarp::os::Bottle> heatmap_outport;
+    heatmap_outport.open(session.heatmap_communication_out.port);
+    // optional decimation ahead of the localization, keeps its state between frames
+    bool decimate = audio.decimated_rate > 0 && audio.decimated_rate < audio.sample_rate;
+    // int16 frames reach the fixed point localization unconverted, unless they are decimated or distributed
+    bool direct_pcm = audio.fixed_point && !decimate && !distributed;
+
+    // preallocated buffers cycling between the stages, the queues only pass their indices
+    std::vector<std::vector<double>> frame_buffers(kPipelineDepth);
+    for (std::vector<double> &buffer : frame_buffers)
+      buffer.reserve(static_cast<size_t>(audio.frame_size * microphones));
+    std::vector<std::vector<int16_t>> pcm_buffers(kPipelineDepth);
+    // frames kept as 16 bit samples in the pcm buffer instead of the frame buffer
+    std::vector<char> pcm_frames(kPipelineDepth, 0);
+    // capture nodes with edge_gcc send lag vectors instead of samples, kept in the frame buffer
+    std::vector<char> lag_frames(kPipelineDepth, 0);
+    // voice activity decided before the compute stage, by the capture node or the streaming detection
+    std::vector<char> frame_voices(kPipelineDepth, 0);
+    std::vector<PipelineResult> results(kPipelineDepth);
+    taylortrack::utils::BlockingSpscQueue<int> free_frames(kPipelineDepth);
+    taylortrack::utils::BlockingSpscQueue<int> received_frames(kPipelineDepth);
+    taylortrack::utils::BlockingSpscQueue<int> free_results(kPipelineDepth);
+    taylortrack::utils::BlockingSpscQueue<int> computed_results(kPipelineDepth);
+    for (int slot = 0; slot < kPipelineDepth; ++slot) {
+      free_frames.try_push(slot);
+      free_results.try_push(slot);
+    }
+    std::atomic<bool> running(true);
+    // written by the compute stage, read by the receive stage
+    std::atomic<bool> saturated(false);
+    // written by the publish stage, read by the compute stage
+    std::atomic<bool> heatmap_wanted(false);
+
+    // receive stage: blocking network reads and conversion into a free frame buffer
+    std::thread receive_thread([&]() {
+      // slot of a dropped frame is kept for the next one, only the compute stage returns slots
+      int slot = -1;
+      while (running) {
+        yarp::os::Bottle *new_data = rec.read_data(true);
+        if (!new_data)
+          continue;
+        if (saturated) {
+          // even the cheapest level falls behind, skip to the newest frame
+          while (rec.get_pending_reads() > 0) {
+            yarp::os::Bottle *newer_data = rec.read_data(false);
+            if (newer_data)
+              new_data = newer_data;
+          }
+        }
+        if (slot < 0)
+          slot = free_frames.pop();
+        std::vector<double> &frame_buffer = frame_buffers[slot];
+        bool voice = false;
+        lag_frames[slot] = taylortrack::sim::read_lag_vectors(*new_data, &voice, &frame_buffer);
+        if (!lag_frames[slot]) {
+          // int16 frames for the fixed point localization are copied as they are, other packed frames
+          // are unpacked in one pass, one double per sample is converted below
+          int channels = microphones;
+          pcm_frames[slot] = direct_pcm &&
+              taylortrack::sim::read_packed_pcm16(*new_data, &channels, &pcm_buffers[slot]);
+          bool packed = pcm_frames[slot] ||
+              taylortrack::sim::read_packed_frame(*new_data, &channels, &frame_buffer);
+          int values = pcm_frames[slot] ? static_cast<int>(pcm_buffers[slot].size()) :
+              packed ? static_cast<int>(frame_buffer.size()) : new_data->size();
+          if (channels != microphones || values % microphones != 0) {
+            std::cout << session.name << ": dropped a frame of " << values << " samples in "
+                      << channels << " channels, expected " << microphones << " channels" << std::endl;
+            continue;
+          }
+          if (!pcm_frames[slot])
+            frame_buffer.resize(static_cast<size_t>(values));
+          // converted block by block, each block is classified while it is still cached
+          int block_values = streaming_vad ? streaming.get_block_size() * microphones : values;
+          for (int begin = 0; begin < values; begin += block_values) {
+            int end = std::min(values, begin + block_values);
+            int64_t length = (end - begin) / microphones;
+            if (!packed) {
+              for (int j = begin; j < end; ++j) {
+                  frame_buffer[j] = new_data->get(j).asDouble();
+              }
             }
+            if (streaming_vad && pcm_frames[slot])
+              voice = streaming.process_block(taylortrack::utils::Pcm16View(
+                  &pcm_buffers[slot][begin], microphones, microphones, length)) || voice;
+            else if (streaming_vad)
+              voice = streaming.process_block(taylortrack::utils::SignalView(
+                  &frame_buffer[begin], microphones, microphones, length)) || voice;
+          }
+        } else {
+          pcm_frames[slot] = 0;
+        }
+        frame_voices[slot] = voice;
+        received_frames.push(slot);
+        slot = -1;
+      }
+    });
 
-            taylortrack::utils::VadSimple test_vad = taylortrack::utils::VadSimple(0.0000007);
-            if(test_vad.detect(signals[0])) {
-              algorithm.calculate_position_and_distribution(signals);
+    // publish stage: blocking writes of the results of the compute stage
+    std::thread publish_thread([&]() {
+      while (running) {
+        heatmap_wanted = heatmap_outport.getOutputCount() > 0;
+        int slot = computed_results.pop();
+        PipelineResult &result = results[slot];
+        if (result.voice) {
+          yarp::os::Bottle& bottle = outport.prepare();
+          bottle.clear();
 
-              taylortrack::utils::RArray result = algorithm.get_last_distribution();
-              yarp::os::Bottle& bottle = outport.prepare();
-              bottle.clear();
+          for (double value : result.distribution) {
+            bottle.addDouble(value);
+          }
 
-              for (int k = 0; k < static_cast<int>(result.size()); ++k) {
-                bottle.addDouble(result[k]);
-              }
+          outport.write(true);
+
+          if (!result.heatmap.empty()) {
+            // size per axis followed by the packed float values
+            yarp::os::Bottle& heatmap_bottle = heatmap_outport.prepare();
+            heatmap_bottle.clear();
+            heatmap_bottle.addInt(result.heatmap_size);
+            heatmap_bottle.add(yarp::os::Value(result.heatmap.data(),
+                                               static_cast<int>(result.heatmap.size() * sizeof(float))));
+            heatmap_outport.write(true);
+          }
+        } else {
+          std::cout << "No voice activity detected." << std::endl;
+        }
+        if (beamforming) {
+          // silence without voice keeps the beamformed stream continuous
+          yarp::os::Bottle& beam_bottle = beam_outport.prepare();
+          beam_bottle.clear();
+          for (double sample : result.beam)
+            beam_bottle.addDouble(sample);
+          beam_outport.write(true);
+        }
+        free_results.push(slot);
+      }
+    });
 
-              outport.write(true);
-            } else {
-              std::cout << "No voice activity detected." << std::endl;
+    // compute stage on the thread of the session
+    // 16 bit copy of frames that arrived in another format, for the fixed point pipeline
+    std::vector<int16_t> pcm_buffer;
+    taylortrack::utils::PolyphaseResampler resampler(
+        audio.sample_rate, decimate ? audio.decimated_rate : audio.sample_rate, microphones);
+    std::vector<double> decimated_buffer;
+    // level of the instance that processed the last frame
+    int active_level = 0;
+
+    while (running) {
+        int frame_slot = received_frames.pop();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        // lag vectors were computed with the configured settings, only level 0 shares their tables
+        bool lag_frame = lag_frames[frame_slot] != 0;
+        int level = governed && !lag_frame ? governor.get_level() : 0;
+        taylortrack::localization::SrpPhatFixed &algorithm = ladder[level];
+        if (level != active_level) {
+          // the tracked speaker and the beamformed stream continue across the switch
+          algorithm.continue_from(ladder[active_level]);
+          active_level = level;
+        }
+
+        bool pcm_frame = pcm_frames[frame_slot] != 0;
+        const std::vector<int16_t> &pcm_input = pcm_frame ? pcm_buffers[frame_slot] : pcm_buffer;
+        taylortrack::utils::Pcm16View pcm(pcm_input.data(), microphones, microphones,
+                                          pcm_frame ? pcm_input.size() / microphones : 0);
+        std::vector<double> &frame_buffer = frame_buffers[frame_slot];
+        taylortrack::utils::SignalView frame(frame_buffer.data(), microphones, microphones,
+                                             pcm_frame ? 0 : frame_buffer.size() / microphones);
+        if (decimate && !lag_frame) {
+          resampler.process(frame, &decimated_buffer);
+          frame = taylortrack::utils::SignalView(decimated_buffer.data(), microphones, microphones,
+                                                 decimated_buffer.size() / microphones);
+        }
+
+        int result_slot = free_results.pop();
+        PipelineResult &result = results[result_slot];
+        if (lag_frame || streaming_vad)
+          result.voice = frame_voices[frame_slot] != 0;
+        else
+          result.voice = spectral_vad || (pcm_frame ? vad.detect(pcm) : vad.detect(frame));
+        if (result.voice && lag_frame) {
+          // the capture node did the transforms, only the projection is left
+          algorithm.set_heatmap_enabled(heatmap_wanted);
+          if (!algorithm.calculate_from_lag_vectors(frame_buffer)) {
+            std::cout << session.name << ": received " << frame_buffer.size() << " lag values instead of "
+                      << algorithm.get_lag_vector_size() << ", check the settings of the capture node" << std::endl;
+            result.voice = false;
+          }
+        } else if (result.voice && distributed) {
+          // the workers evaluate the pairs, only their sums are combined here
+          taylortrack::sim::write_worker_frame(++sequence, frame, &worker_outport.prepare());
+          worker_outport.write(true);
+          taylortrack::utils::RArray degree_sums(0.0, 360);
+          int answers = collect_worker_results(&worker_inport, sequence, audio.workers,
+                                               kWorkerTimeoutFrames * frame_period, &degree_sums);
+          if (answers < audio.workers)
+            std::cout << session.name << ": " << answers << " of " << audio.workers
+                      << " workers answered frame " << sequence << std::endl;
+          if (answers > 0) {
+            algorithm.set_degree_values(degree_sums);
+          } else {
+            result.voice = false;
+          }
+        } else if (result.voice) {
+          if (pcm_frame) {
+            // the transported 16 bit samples as they are
+            algorithm.calculate_position_and_distribution(pcm);
+          } else if (audio.fixed_point) {
+            // quantize once, everything after this works on integers
+            pcm_buffer.resize(static_cast<size_t>(frame.length * microphones));
+            for (size_t j = 0; j < pcm_buffer.size(); ++j) {
+              double sample = std::max(-1.0, std::min(1.0, frame.data[j]));
+              pcm_buffer[j] = static_cast<int16_t>(std::lround(sample * 32767.0));
             }
+            algorithm.calculate_position_and_distribution(
+                taylortrack::utils::Pcm16View(pcm_buffer.data(), microphones, microphones,
+                                              frame.length));
+          } else {
+            algorithm.set_heatmap_enabled(heatmap_wanted);
+            algorithm.calculate_position_and_distribution(frame);
+            result.voice = algorithm.get_last_voice();
+          }
         }
-    } else {
-        std::cout << "Error initializing incoming communication..." << std::endl;
-        return EXIT_FAILURE;
+        // the input buffer is not needed anymore, hand it back to the receive stage
+        free_frames.push(frame_slot);
+
+        if (result.voice) {
+          const taylortrack::utils::RArray &distribution = algorithm.get_last_distribution();
+          result.distribution.assign(std::begin(distribution), std::end(distribution));
+          result.heatmap = algorithm.get_last_heatmap();
+          result.heatmap_size = algorithm.get_heatmap_size();
+        }
+        if (beamforming && result.voice && !lag_frame) {
+          result.beam = algorithm.get_beamformed_frame();
+        } else if (beamforming) {
+          algorithm.reset_beamformer();
+          result.beam.assign(static_cast<size_t>(algorithm.get_steps()), 0.0);
+        }
+        computed_results.push(result_slot);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        engine->report_latency(session_index, elapsed.count());
+        taylortrack::localization::LatencyStats latency = engine->get_latency(session_index);
+        if (latency.frames % kLatencyReportInterval == 0)
+          std::cout << session.name << ": " << latency.mean * 1000.0 << " ms mean, "
+                    << latency.maximum * 1000.0 << " ms max processing time" << std::endl;
+        if (governed) {
+          if (governor.report(elapsed.count()))
+            std::cout << session.name << ": switched to compute level " << governor.get_level() << std::endl;
+          saturated = governor.is_saturated();
+        }
+    }
+    receive_thread.join();
+    publish_thread.join();
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief receiving data main method
+ *
+ * Initialize and open a port, wait for input from input bottle, and print positive message if successful.
+ * Each [audio.<name>] section of the config is served by its own session, all sessions share one engine.
+ * With workers configured, the localization of each frame is split across srp_worker processes.
+ * Lag vectors sent by capture nodes with edge_gcc enabled are projected directly, see sim/lag_protocol.h.
+ */
+int main(int argc, char *argv[]) {
+    yarp::os::Network yarp;
+    taylortrack::utils::ConfigParser config("../conf/real_config.conf");
+    std::vector<taylortrack::utils::AudioSession> sessions = config.get_audio_sessions();
+    std::shared_ptr<taylortrack::localization::SrpEngine> engine =
+        std::make_shared<taylortrack::localization::SrpEngine>(
+            static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+    if (sessions.size() == 1)
+        return run_session(yarp, sessions[0], engine);
+
+    std::vector<int> exit_codes(sessions.size(), EXIT_SUCCESS);
+    std::vector<std::thread> session_threads;
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        session_threads.emplace_back([&, i]() {
+            exit_codes[i] = run_session(yarp, sessions[i], engine);
+        });
+    }
+    for (std::thread &session_thread : session_threads)
+        session_thread.join();
+    for (int exit_code : exit_codes) {
+        if (exit_code != EXIT_SUCCESS)
+            return exit_code;
     }
+    return EXIT_SUCCESS;
 }
@@ -26,13 +26,17 @@ SOFTWARE.
  * @file
  * @brief General data streamer main file
  */
+#include <memory>
 #include "input/dummy_input_strategy.h"
 #include "input/input_strategy.h"
 #include "input/microphone_input_strategy.h"
 #include "input/opencv_input_strategy.h"
 #include "input/read_file_input_strategy.h"
+#include "input/replay_input_strategy.h"
+#include "input/synthetic_input_strategy.h"
 #include "input/wave_input_strategy.h"
 #include "sim/streamer.h"
+#include "utils/capture_recorder.h"
 #include "utils/parameter_parser.h"
 #include "utils/config_parser.h"
 
@@ -40,6 +44,8 @@ SOFTWARE.
  * @brief streaming data main method
  *
  * Reads a file with the Read_File_Input strategy and starts streaming the file
+ *
+ * With -r <file> every streamed frame is recorded, see taylortrack::utils::CaptureRecorder.
  */
 int main(int argc, const char *argv[]) {
     taylortrack::utils::Parameters parameters =
@@ -54,6 +60,10 @@ int main(int argc, const char *argv[]) {
         taylortrack::input::ReadFileInputStrategy strategy;
 #elif defined INPUT_WAVE_FILE
         taylortrack::input::WaveInputStrategy strategy;
+#elif defined INPUT_REPLAY
+        taylortrack::input::ReplayInputStrategy strategy;
+#elif defined INPUT_SYNTHETIC
+        taylortrack::input::SyntheticInputStrategy strategy;
 #elif defined INPUT_OPENCV
         taylortrack::input::OpenCVInputStrategy strategy;
 #elif defined INPUT_MICROPHONE
@@ -66,6 +76,15 @@ int main(int argc, const char *argv[]) {
           strategy.set_parameters(parameters);
           strategy.set_config(parser);
           taylortrack::sim::Streamer streamer(&strategy, parameters.outport);
+          std::unique_ptr<taylortrack::utils::CaptureRecorder> recorder;
+          if (parameters.record) {
+            recorder.reset(new taylortrack::utils::CaptureRecorder(parameters.record));
+            if (!recorder->is_open()) {
+              std::cout << "Recording file could not be created!" << std::endl;
+              return EXIT_FAILURE;
+            }
+            streamer.set_recorder(recorder.get());
+          }
           streamer.start_streaming(parameters.inport);
           return EXIT_SUCCESS;
         } else {
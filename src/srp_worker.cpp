@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief Localization worker evaluating one shard of the microphone pairs for the audio receiver
+ */
+
+#include <yarp/os/all.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "localization/srp_phat.h"
+#include "sim/worker_protocol.h"
+#include "utils/config_parser.h"
+#include "utils/signal_view.h"
+
+/**
+ * @brief worker main method
+ *
+ * Usage: srp_worker <shard> [session]. Receives the frames broadcast by sim_datareceiver on worker_outport,
+ * evaluates every workers-th microphone pair starting at the shard index and sends the unnormalized degree
+ * values back to worker_inport. Port names are looked up at the YARP name server, so workers may run on
+ * other hosts than the receiver. Workers may also start before the receiver, they retry connecting until
+ * its ports exist.
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: srp_worker <shard> [session]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    int shard = std::atoi(argv[1]);
+    yarp::os::Network yarp;
+    taylortrack::utils::ConfigParser config("../conf/real_config.conf");
+    std::vector<taylortrack::utils::AudioSession> sessions = config.get_audio_sessions();
+    const taylortrack::utils::AudioSession *session = &sessions[0];
+    for (const taylortrack::utils::AudioSession &candidate : sessions) {
+        if (argc > 2 && candidate.name.compare(argv[2]) == 0)
+            session = &candidate;
+    }
+    taylortrack::utils::AudioSettings audio = session->settings;
+    if (shard < 0 || shard >= audio.workers) {
+        std::cout << "Shard " << shard << " is outside of the " << audio.workers
+                  << " configured workers of " << session->name << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // the windowed search and the beamformer need all pairs, the receiver only uses the sums
+    audio.tracking = false;
+    audio.beamforming = false;
+    // the receiver decides about voice activity, silent frames never reach the workers
+    audio.vad = taylortrack::utils::VadMode::kEnergy;
+    taylortrack::utils::ConfigParser worker_config;
+    worker_config.set_audio_settings(audio);
+    taylortrack::localization::SrpPhat algorithm;
+    algorithm.set_config(worker_config);
+    algorithm.set_shard(shard, audio.workers);
+
+    std::string suffix = "/" + std::to_string(shard);
+    yarp::os::BufferedPort<yarp::os::Bottle> inport;
+    yarp::os::BufferedPort<yarp::os::Bottle> outport;
+    if (!inport.open(session->worker_communication_out.port + suffix) ||
+        !outport.open(session->worker_communication_in.port + suffix)) {
+        std::cout << "Error opening the worker ports..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    bool frames_connected = false;
+    bool results_connected = false;
+    while (true) {
+        frames_connected = frames_connected ||
+            yarp.connect(yarp::os::ConstString(session->worker_communication_out.port), inport.getName());
+        results_connected = results_connected ||
+            yarp.connect(outport.getName(), yarp::os::ConstString(session->worker_communication_in.port));
+        if (frames_connected && results_connected)
+            break;
+        std::cout << "Waiting for the worker ports of " << session->name << "..." << std::endl;
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    std::vector<double> samples;
+    while (true) {
+        yarp::os::Bottle *frame_message = inport.read(true);
+        int sequence = 0;
+        int channels = 0;
+        if (!frame_message ||
+            !taylortrack::sim::read_worker_frame(*frame_message, &sequence, &channels, &samples))
+            continue;
+        taylortrack::utils::SignalView frame(samples.data(), channels, channels,
+                                             samples.size() / channels);
+        // frames dropped on the way must not shift the round robin schedule of this worker
+        algorithm.set_frame_number(sequence);
+        algorithm.calculate_position_and_distribution(frame);
+        taylortrack::sim::write_worker_result(sequence, shard, algorithm.get_last_degree_values(),
+                                              &outport.prepare());
+        outport.write(true);
+    }
+}
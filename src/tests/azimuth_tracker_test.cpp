@@ -0,0 +1,33 @@
+#include "gtest/gtest.h"
+#include "localization/azimuth_tracker.h"
+
+TEST(AzimuthTrackerTest, AngleDifferenceTest) {
+  ASSERT_DOUBLE_EQ(20.0, taylortrack::localization::angle_difference(10.0, 350.0));
+  ASSERT_DOUBLE_EQ(-20.0, taylortrack::localization::angle_difference(350.0, 10.0));
+  ASSERT_DOUBLE_EQ(180.0, taylortrack::localization::angle_difference(180.0, 0.0));
+  ASSERT_DOUBLE_EQ(0.0, taylortrack::localization::angle_difference(720.0, 0.0));
+}
+
+TEST(AzimuthTrackerTest, FirstMeasurementTest) {
+  taylortrack::localization::AzimuthTracker tracker;
+  ASSERT_FALSE(tracker.is_initialized());
+  tracker.update(-90.0);
+  ASSERT_TRUE(tracker.is_initialized());
+  ASSERT_DOUBLE_EQ(270.0, tracker.predict());
+  tracker.reset();
+  ASSERT_FALSE(tracker.is_initialized());
+}
+
+TEST(AzimuthTrackerTest, WrapAroundTest) {
+  // a speaker moving 2 degrees per frame across 0 degrees
+  taylortrack::localization::AzimuthTracker tracker(0.5, 0.2);
+  double angle = 300.0;
+  for (int frame = 0; frame < 60; ++frame) {
+    tracker.update(angle);
+    angle += 2.0;
+    if (angle >= 360.0)
+      angle -= 360.0;
+  }
+  ASSERT_NEAR(2.0, tracker.get_rate(), 0.1);
+  ASSERT_NEAR(0.0, taylortrack::localization::angle_difference(tracker.predict(), angle), 0.5);
+}
@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include "utils/blocking_spsc_queue.h"
+
+TEST(BlockingSpscQueueTest, ThreadedOrderTest) {
+  // a small queue makes both sides wait for each other many times
+  taylortrack::utils::BlockingSpscQueue<int> queue(2);
+  ASSERT_EQ(2u, queue.get_capacity());
+  const int count = 20000;
+  std::thread producer([&]() {
+    for (int i = 0; i < count; ++i)
+      queue.push(i);
+  });
+  for (int i = 0; i < count; ++i)
+    ASSERT_EQ(i, queue.pop());
+  producer.join();
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(BlockingSpscQueueTest, WaitingSleepsTest) {
+  taylortrack::utils::BlockingSpscQueue<int> queue(1);
+  std::clock_t cpu_start = std::clock();
+  std::thread producer([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    queue.push(1);
+    // the second value has to wait until the consumer took the first one
+    queue.push(2);
+  });
+  ASSERT_EQ(1, queue.pop());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(2, queue.pop());
+  producer.join();
+  // a spinning consumer would have used a whole core while waiting
+  double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  ASSERT_LT(cpu_seconds, 0.1);
+}
+
+TEST(BlockingSpscQueueTest, TryTest) {
+  taylortrack::utils::BlockingSpscQueue<int> queue(1);
+  int value = 0;
+  ASSERT_FALSE(queue.try_pop(&value));
+  ASSERT_TRUE(queue.try_push(3));
+  ASSERT_FALSE(queue.try_push(4));
+  ASSERT_TRUE(queue.try_pop(&value));
+  ASSERT_EQ(3, value);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/capture_reader.h"
+#include "utils/capture_recorder.h"
+
+namespace {
+const char kCaptureFile[] = "capture_recorder_test.ttcap";
+
+// frame number frame holds frame + value / 8 for each of its values
+std::vector<double> make_frame(int frame, size_t values) {
+  std::vector<double> samples(values);
+  for (size_t value = 0; value < values; ++value)
+    samples[value] = frame + value / 8.0;
+  return samples;
+}
+
+void record_frames(int frames, size_t values, size_t buffer_size) {
+  taylortrack::utils::CaptureRecorder recorder(kCaptureFile, buffer_size);
+  ASSERT_TRUE(recorder.is_open());
+  for (int frame = 0; frame < frames; ++frame) {
+    std::vector<double> samples = make_frame(frame, values);
+    ASSERT_TRUE(recorder.record(100 + frame, 1000.0 + frame * 0.5, samples.data(), samples.size()));
+    // frames arrive paced like a stream, giving the writer time for each buffer
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(static_cast<uint64_t>(frames), recorder.get_recorded());
+}
+}  // namespace
+
+TEST(CaptureRecorderTest, RecordsAndReadsFrames) {
+  // a small buffer makes the frames go through several hand overs
+  record_frames(50, 64, 1024);
+
+  taylortrack::utils::CaptureReader reader(kCaptureFile);
+  ASSERT_TRUE(reader.is_valid());
+  ASSERT_TRUE(reader.is_complete());
+  ASSERT_EQ(50u, reader.get_frame_count());
+  std::vector<double> samples;
+  for (int frame = 0; frame < 50; ++frame) {
+    ASSERT_EQ(static_cast<uint64_t>(100 + frame), reader.get_sequence(frame));
+    ASSERT_DOUBLE_EQ(1000.0 + frame * 0.5, reader.get_timestamp(frame));
+    reader.read_frame(frame, &samples);
+    ASSERT_EQ(make_frame(frame, 64), samples);
+  }
+  std::remove(kCaptureFile);
+}
+
+TEST(CaptureRecorderTest, SeeksTimestamps) {
+  record_frames(10, 4, 1 << 16);
+
+  taylortrack::utils::CaptureReader reader(kCaptureFile);
+  ASSERT_EQ(0u, reader.seek(0.0));
+  ASSERT_EQ(0u, reader.seek(1000.0));
+  ASSERT_EQ(3u, reader.seek(1001.2));
+  ASSERT_EQ(4u, reader.seek(1002.0));
+  ASSERT_EQ(10u, reader.seek(1010.0));
+  std::remove(kCaptureFile);
+}
+
+TEST(CaptureRecorderTest, RebuildsIndexOfCutRecording) {
+  record_frames(10, 16, 1 << 16);
+  // cut the index and half of the last frame, like a crash while writing would
+  std::string content;
+  {
+    std::ifstream file(kCaptureFile, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  size_t record_size = sizeof(taylortrack::utils::CaptureRecordHeader) + 16 * sizeof(float);
+  content.resize(sizeof(taylortrack::utils::CaptureFileHeader) + 9 * record_size + record_size / 2);
+  {
+    std::ofstream file(kCaptureFile, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  taylortrack::utils::CaptureReader reader(kCaptureFile);
+  ASSERT_TRUE(reader.is_valid());
+  ASSERT_FALSE(reader.is_complete());
+  ASSERT_EQ(9u, reader.get_frame_count());
+  std::vector<double> samples;
+  reader.read_frame(8, &samples);
+  ASSERT_EQ(make_frame(8, 16), samples);
+  ASSERT_EQ(108u, reader.get_sequence(8));
+  std::remove(kCaptureFile);
+}
+
+TEST(CaptureRecorderTest, DropsInsteadOfWaiting) {
+  {
+    // every frame fills a buffer, the writer cannot keep up with a burst
+    taylortrack::utils::CaptureRecorder recorder(kCaptureFile, 64);
+    std::vector<double> samples = make_frame(0, 1024);
+    for (int frame = 0; frame < 200; ++frame)
+      recorder.record(frame, frame, samples.data(), samples.size());
+    ASSERT_EQ(200u, recorder.get_recorded() + recorder.get_dropped());
+  }
+
+  // the sequence numbers show the gaps
+  taylortrack::utils::CaptureReader reader(kCaptureFile);
+  ASSERT_TRUE(reader.is_complete());
+  ASSERT_GT(reader.get_frame_count(), 0u);
+  for (size_t frame = 1; frame < reader.get_frame_count(); ++frame)
+    ASSERT_LT(reader.get_sequence(frame - 1), reader.get_sequence(frame));
+  std::remove(kCaptureFile);
+}
+
+TEST(CaptureRecorderTest, InvalidFiles) {
+  taylortrack::utils::CaptureReader missing("../Testdata/Missing.ttcap");
+  ASSERT_FALSE(missing.is_valid());
+  taylortrack::utils::CaptureReader wave("../Testdata/Test.wav");
+  ASSERT_FALSE(wave.is_valid());
+  ASSERT_EQ(0u, wave.get_frame_count());
+
+  taylortrack::utils::CaptureRecorder recorder("../Testdata/missing/directory.ttcap");
+  ASSERT_FALSE(recorder.is_open());
+  double value = 0.0;
+  ASSERT_FALSE(recorder.record(0, 0.0, &value, 1));
+}
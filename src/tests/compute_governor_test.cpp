@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "localization/compute_governor.h"
+#include "localization/srp_phat.h"
+#include "utils/config_parser.h"
+
+namespace {
+taylortrack::utils::AudioSettings make_settings() {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = std::valarray<double>(mx, 4);
+  settings.mic_y = std::valarray<double>(my, 4);
+  settings.sample_rate = 44100;
+  settings.frame_size = 4410;
+  return settings;
+}
+}  // namespace
+
+TEST(ComputeGovernorTest, LadderTest) {
+  taylortrack::localization::ComputeGovernor governor(make_settings());
+  ASSERT_EQ(4, governor.get_level_count());
+  ASSERT_DOUBLE_EQ(0.1, governor.get_frame_period());
+  ASSERT_DOUBLE_EQ(0.1, governor.get_level_settings(0).interval);
+  ASSERT_DOUBLE_EQ(0.2, governor.get_level_settings(1).interval);
+  ASSERT_EQ(3, governor.get_level_settings(2).max_pairs);
+  ASSERT_EQ(4000.0, governor.get_level_settings(3).band_high);
+  ASSERT_EQ(300.0, governor.get_level_settings(3).band_low);
+
+  // every level can be used to configure the algorithm
+  for (int level = 0; level < governor.get_level_count(); ++level) {
+    taylortrack::utils::ConfigParser config;
+    config.set_audio_settings(governor.get_level_settings(level));
+    taylortrack::localization::SrpPhat srp;
+    srp.set_config(config);
+    ASSERT_TRUE(srp.is_initialized());
+  }
+}
+
+TEST(ComputeGovernorTest, StepDownAndUpTest) {
+  taylortrack::localization::ComputeGovernor governor(make_settings(), 0.8);
+  // frames taking longer than the budget lower the level one step at a time
+  int changes = 0;
+  for (int frame = 0; frame < 100; ++frame)
+    changes += governor.report(0.15) ? 1 : 0;
+  ASSERT_EQ(3, changes);
+  ASSERT_EQ(3, governor.get_level());
+  ASSERT_TRUE(governor.is_saturated());
+
+  // fast frames raise the level again
+  for (int frame = 0; frame < 1000; ++frame)
+    governor.report(0.001);
+  ASSERT_EQ(0, governor.get_level());
+  ASSERT_FALSE(governor.is_saturated());
+}
+
+TEST(ComputeGovernorTest, HysteresisTest) {
+  taylortrack::localization::ComputeGovernor governor(make_settings(), 0.8);
+  // frames within the budget but without much headroom keep the level
+  for (int frame = 0; frame < 500; ++frame)
+    ASSERT_FALSE(governor.report(0.05));
+  ASSERT_EQ(0, governor.get_level());
+}
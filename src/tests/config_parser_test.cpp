@@ -44,6 +44,14 @@ TEST(ConfigParserTest, ValidParsing) {
   // New not yet deprecated method
   ASSERT_STREQ("/test_audio_inport", audio_in.port.c_str());
   ASSERT_STREQ("/test_audio_outport", audio_out.port.c_str());
+  ASSERT_STREQ("/test_audio_beamform_outport",
+               parser.get_audio_beamform_communication_out().port.c_str());
+  ASSERT_STREQ("/test_audio_heatmap_outport",
+               parser.get_audio_heatmap_communication_out().port.c_str());
+  ASSERT_STREQ("/test_audio_worker_frames",
+               parser.get_audio_worker_communication_out().port.c_str());
+  ASSERT_STREQ("/test_audio_worker_results",
+               parser.get_audio_worker_communication_in().port.c_str());
 
   ASSERT_EQ(53242342, audio.sample_rate);
   ASSERT_TRUE(mic_x_eq);
@@ -53,6 +61,31 @@ TEST(ConfigParserTest, ValidParsing) {
   ASSERT_EQ(12, audio.grid_y);
   ASSERT_EQ(0.98765543123, audio.interval);
   ASSERT_EQ(8765, audio.frame_size);
+  ASSERT_EQ(taylortrack::utils::PairSelectionPolicy::kTopK, audio.pair_selection);
+  ASSERT_EQ(5, audio.max_pairs);
+  ASSERT_EQ(0.25, audio.min_baseline);
+  ASSERT_EQ(300.0, audio.band_low);
+  ASSERT_EQ(8000.0, audio.band_high);
+  ASSERT_EQ(4, audio.subbands);
+  ASSERT_EQ(16000, audio.decimated_rate);
+  ASSERT_TRUE(audio.tracking);
+  ASSERT_EQ(20.0, audio.tracking_window);
+  ASSERT_EQ(10, audio.full_sweep_interval);
+  ASSERT_EQ(0.6, audio.tracking_alpha);
+  ASSERT_EQ(0.1, audio.tracking_beta);
+  ASSERT_TRUE(audio.governor);
+  ASSERT_EQ(0.6, audio.governor_budget);
+  ASSERT_TRUE(audio.beamforming);
+  ASSERT_EQ(3, audio.heatmap_decimation);
+  ASSERT_EQ(4, audio.workers);
+  ASSERT_EQ(taylortrack::utils::VadMode::kSpectral, audio.vad);
+  ASSERT_EQ(0.00002, audio.vad_threshold);
+  ASSERT_EQ(128, audio.vad_block_size);
+  ASSERT_EQ(5, audio.vad_hangover);
+  ASSERT_EQ(8u, audio.mic_z.size());
+  ASSERT_DOUBLE_EQ(2.4, audio.mic_z[7]);
+  ASSERT_EQ(2u, audio.grid_z.size());
+  ASSERT_DOUBLE_EQ(1.5, audio.grid_z[1]);
 
   // Old deprecated method
   ASSERT_STREQ("/test_video_inport", video.inport.c_str());
@@ -69,6 +102,48 @@ TEST(ConfigParserTest, ValidParsing) {
   ASSERT_STREQ("/test_visualizer_inport", visualizer_in.port.c_str());
 
   ASSERT_STREQ("/test_input_outport", input_out.port.c_str());
+  ASSERT_EQ(taylortrack::utils::SampleTransport::kInt16,
+            parser.get_input_configuration().transport);
+
+  taylortrack::utils::MicrophoneInputSettings microphone_input =
+      parser.get_microphone_input_configuration();
+  ASSERT_EQ(2u, microphone_input.devices.size());
+  ASSERT_EQ(3, microphone_input.devices[1].microphone_id);
+  ASSERT_EQ(128, microphone_input.period_size);
+  ASSERT_FALSE(microphone_input.align);
+  ASSERT_TRUE(microphone_input.edge_gcc);
+
+  taylortrack::utils::WaveInputSettings wave_input =
+      parser.get_wave_input_configuration();
+  ASSERT_EQ(4096, wave_input.frame_size);
+  ASSERT_EQ(2.5, wave_input.speed);
+
+  taylortrack::utils::SyntheticInputSettings synthetic_input =
+      parser.get_synthetic_input_configuration();
+  ASSERT_EQ(512, synthetic_input.frame_size);
+  ASSERT_EQ(0.0, synthetic_input.speed);
+  ASSERT_EQ(2.5, synthetic_input.duration);
+  ASSERT_EQ(3u, synthetic_input.sources.size());
+  ASSERT_EQ(taylortrack::utils::TrajectoryType::kStatic, synthetic_input.sources[0].trajectory);
+  ASSERT_EQ(1.0, synthetic_input.sources[0].x);
+  ASSERT_EQ(-0.5, synthetic_input.sources[0].y);
+  ASSERT_EQ(taylortrack::utils::TrajectoryType::kLine, synthetic_input.sources[1].trajectory);
+  ASSERT_EQ(-1.0, synthetic_input.sources[1].x);
+  ASSERT_EQ(1.0, synthetic_input.sources[1].x_end);
+  ASSERT_EQ(1.0, synthetic_input.sources[1].y_end);
+  ASSERT_EQ(4.0, synthetic_input.sources[1].period);
+  ASSERT_EQ(taylortrack::utils::TrajectoryType::kCircle, synthetic_input.sources[2].trajectory);
+  ASSERT_EQ(1.5, synthetic_input.sources[2].radius);
+  ASSERT_EQ(10.0, synthetic_input.sources[2].period);
+  ASSERT_EQ(0.01, synthetic_input.noise);
+  ASSERT_EQ(0.3, synthetic_input.reflection);
+  ASSERT_EQ(7, synthetic_input.seed);
+  ASSERT_EQ("truth.txt", synthetic_input.ground_truth);
+
+  taylortrack::utils::ReplayInputSettings replay_input =
+      parser.get_replay_input_configuration();
+  ASSERT_EQ(12.5, replay_input.start);
+  ASSERT_EQ(0.5, replay_input.speed);
 }
 
 TEST(ConfigParserTest, UnequalMicNumber) {
@@ -90,3 +165,48 @@ TEST(ConfigParserTest, DoubleEquals) {
   taylortrack::utils::ConfigParser parser("../Testdata/taylortrack4.conf");
   ASSERT_FALSE(parser.is_valid());
 }
+
+TEST(ConfigParserTest, AudioSessions) {
+  taylortrack::utils::ConfigParser parser("../Testdata/taylortrack5.conf");
+  ASSERT_TRUE(parser.is_valid());
+  std::vector<taylortrack::utils::AudioSession> sessions =
+      parser.get_audio_sessions();
+  ASSERT_EQ(2u, sessions.size());
+  ASSERT_STREQ("kitchen", sessions[0].name.c_str());
+  ASSERT_STREQ("hall", sessions[1].name.c_str());
+  ASSERT_STREQ("/kitchen_inport", sessions[0].communication_in.port.c_str());
+  ASSERT_STREQ("/hall_outport", sessions[1].communication_out.port.c_str());
+  // values of the [audio] section are inherited unless overridden
+  ASSERT_STREQ("/test_audio_destination",
+               sessions[1].communication_destination.port.c_str());
+  // ports opened by the sessions themselves get the session name appended
+  ASSERT_STREQ("/test_audio_heatmap/kitchen", sessions[0].heatmap_communication_out.port.c_str());
+  ASSERT_STREQ("/test_audio_heatmap/hall", sessions[1].heatmap_communication_out.port.c_str());
+  ASSERT_EQ(44100, sessions[1].settings.sample_rate);
+  ASSERT_EQ(2048, sessions[0].settings.frame_size);
+  ASSERT_EQ(1024, sessions[1].settings.frame_size);
+  ASSERT_EQ(4u, sessions[1].settings.mic_x.size());
+  ASSERT_DOUBLE_EQ(-0.055, sessions[1].settings.mic_y[3]);
+  // the [audio] section itself is not changed by the sessions
+  ASSERT_EQ(0u, parser.get_audio_configuration().mic_x.size());
+}
+
+TEST(ConfigParserTest, SingleAudioSession) {
+  taylortrack::utils::ConfigParser parser("../Testdata/taylortrack.conf");
+  std::vector<taylortrack::utils::AudioSession> sessions =
+      parser.get_audio_sessions();
+  ASSERT_EQ(1u, sessions.size());
+  ASSERT_STREQ("audio", sessions[0].name.c_str());
+  ASSERT_STREQ("/test_audio_inport", sessions[0].communication_in.port.c_str());
+  ASSERT_EQ(53242342, sessions[0].settings.sample_rate);
+}
+
+TEST(ConfigParserTest, SharedSessionPort) {
+  taylortrack::utils::ConfigParser parser("../Testdata/taylortrack7.conf");
+  ASSERT_FALSE(parser.is_valid());
+}
+
+TEST(ConfigParserTest, InvalidSource) {
+  taylortrack::utils::ConfigParser parser("../Testdata/taylortrack6.conf");
+  ASSERT_FALSE(parser.is_valid());
+}
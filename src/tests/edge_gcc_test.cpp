@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include <vector>
+#include "localization/edge_gcc.h"
+#include "localization/srp_phat.h"
+#include "utils/polyphase_resampler.h"
+
+TEST(EdgeGccTest, DecimatedTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  settings.decimated_rate = 16000;
+  settings.vad_threshold = 0.0;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::EdgeGcc edge;
+  edge.set_config(config);
+  // the receiver projects the lag vectors with the tables of the decimated rate
+  taylortrack::localization::SrpPhat host;
+  host.set_config(config);
+  ASSERT_EQ(host.get_lag_vector_size(), edge.get_lag_vector_size());
+  // and decimates sample frames itself before localizing them
+  taylortrack::localization::SrpPhat direct;
+  direct.set_config(config);
+  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 4);
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(host.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(host.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(host.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(host.get_microphone_signal("../Testdata/270-180_short.txt"));
+  std::vector<double> interleaved(4 * 3 * 2048);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < 3 * 2048; ++i)
+      interleaved[i * 4 + channel] = signals[channel][i];
+  }
+
+  std::vector<double> decimated;
+  for (int frame = 0; frame < 3; ++frame) {
+    // frames arrive at the capture rate
+    taylortrack::utils::SignalView view(interleaved.data() + frame * 2048 * 4, 4, 4, 2048);
+    const std::vector<double> &lag_values = edge.process(view);
+    ASSERT_TRUE(edge.get_last_voice());
+    ASSERT_TRUE(host.calculate_from_lag_vectors(lag_values));
+
+    resampler.process(view, &decimated);
+    direct.calculate_position_and_distribution(
+        taylortrack::utils::SignalView(decimated.data(), 4, 4, decimated.size() / 4));
+    for (int degree = 0; degree < 360; ++degree)
+      ASSERT_NEAR(direct.get_last_distribution()[degree],
+                  host.get_last_distribution()[degree], 1e-9);
+  }
+  ASSERT_EQ(180, host.get_last_position());
+}
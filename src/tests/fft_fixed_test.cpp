@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include <cmath>
+#include "utils/fft_fixed.h"
+#include "utils/fft_lib.h"
+
+TEST(FftFixedTest, FftTest) {
+  int samples[] = {1, 1, 1, 1, 0, 7, 2, 2};
+  taylortrack::utils::FftLib::CArray reference(8);
+  taylortrack::utils::FixedCArray vec(8);
+  for (int i = 0; i < 8; ++i) {
+    // scaled up to use the 16 bit range
+    reference[i] = samples[i] * 4096;
+    vec[i].real = samples[i] * 4096;
+  }
+  taylortrack::utils::FftLib().fft(reference);
+  taylortrack::utils::FftFixed fft(8);
+  int shifts = fft.fft(vec);
+  double scale = std::ldexp(1.0, shifts);
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_NEAR(reference[i].real(), vec[i].real * scale, 4.0 * scale);
+    ASSERT_NEAR(reference[i].imag(), vec[i].imag * scale, 4.0 * scale);
+  }
+}
+
+TEST(FftFixedTest, IfftTest) {
+  taylortrack::utils::FftFixed fft(1024);
+  ASSERT_EQ(1024u, fft.get_length());
+  taylortrack::utils::FixedCArray vec(1024);
+  for (int i = 0; i < 1024; ++i)
+    vec[i].real = static_cast<int32_t>(32767 * std::sin(0.05 * i * i));
+  taylortrack::utils::FixedCArray original = vec;
+
+  int shifts = fft.fft(vec);
+  shifts += fft.ifft(vec);
+  // the inverse transformation is unscaled
+  double scale = std::ldexp(1.0, shifts) / 1024.0;
+  for (int i = 0; i < 1024; ++i) {
+    ASSERT_NEAR(original[i].real, vec[i].real * scale, 64.0);
+    ASSERT_NEAR(0.0, vec[i].imag * scale, 64.0);
+  }
+}
+
+TEST(FftFixedTest, BlockScalingTest) {
+  // full scale input forces block scaling in the last stages
+  taylortrack::utils::FftFixed fft(65536);
+  taylortrack::utils::FixedCArray vec(65536);
+  for (int i = 0; i < 65536; ++i)
+    vec[i].real = 32767;
+  int shifts = fft.fft(vec);
+  ASSERT_GT(shifts, 0);
+  ASSERT_NEAR(32767.0 * 65536.0, std::ldexp(vec[0].real, shifts),
+              std::ldexp(1.0, shifts));
+  for (int i = 1; i < 65536; ++i) {
+    ASSERT_EQ(0, vec[i].real);
+    ASSERT_EQ(0, vec[i].imag);
+  }
+}
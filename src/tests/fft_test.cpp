@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
+#include <cstdlib>
 #include "utils/fft_lib.h"
+#include "utils/fft_plan.h"
 
 TEST(FftLibTest, FftTest) {
   taylortrack::utils::FftLib::CArray vec(8);
@@ -146,4 +148,27 @@ TEST(FftLibTest, Zeropadding_Test) {
   ASSERT_EQ(newvec[8].real(), 0);
   ASSERT_EQ(newvec[9].real(), 0);
   ASSERT_EQ(newvec[10].real(), 0);
-}
\ No newline at end of file
+}
+TEST(FftPlanTest, MatchesFftLibTest) {
+  taylortrack::utils::FftPlan plan(1024);
+  ASSERT_EQ(1024u, plan.get_length());
+  taylortrack::utils::FftLib fft_lib;
+  srand(3);
+  // the planned length and a different one falling back to FftLib
+  for (size_t length : {1024u, 64u}) {
+    taylortrack::utils::FftLib::CArray planned(length);
+    for (size_t n = 0; n < length; ++n)
+      planned[n] = taylortrack::utils::FftLib::ComplexDouble(
+          static_cast<double>(rand()) / RAND_MAX - 0.5,
+          static_cast<double>(rand()) / RAND_MAX - 0.5);
+    taylortrack::utils::FftLib::CArray original = planned;
+    taylortrack::utils::FftLib::CArray expected = planned;
+    plan.fft(planned);
+    fft_lib.fft(expected);
+    for (size_t k = 0; k < length; ++k)
+      ASSERT_LT(std::abs(planned[k] - expected[k]), 1e-10);
+    plan.ifft(planned);
+    for (size_t n = 0; n < length; ++n)
+      ASSERT_LT(std::abs(planned[n] - original[n]), 1e-12);
+  }
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "utils/fractional_resampler.h"
+
+TEST(FractionalResamplerTest, UnitStepPassesSamples) {
+  taylortrack::utils::FractionalResampler resampler(2);
+  double first[] = {1.0, -1.0};
+  resampler.prime(first);
+  ASSERT_EQ(4u, resampler.get_required(4, 1.0));
+
+  double input[] = {2.0, -2.0, 3.0, -3.0, 4.0, -4.0, 5.0, -5.0};
+  taylortrack::utils::SignalView view(input, 2, 2, 4);
+  std::vector<double> output(8);
+  ASSERT_EQ(4u, resampler.process(view, 4, 1.0, output.data(), 2));
+  // one sample behind, the last consumed sample is output first
+  double expected[] = {1.0, -1.0, 2.0, -2.0, 3.0, -3.0, 4.0, -4.0};
+  for (int i = 0; i < 8; ++i)
+    ASSERT_EQ(expected[i], output[i]);
+  ASSERT_EQ(0.0, resampler.get_phase());
+}
+
+TEST(FractionalResamplerTest, InterpolatesFractionalPositions) {
+  taylortrack::utils::FractionalResampler resampler(1);
+  double first = 0.0;
+  resampler.prime(&first, 0.25);
+
+  // a ramp is reproduced exactly by linear interpolation
+  std::vector<double> ramp;
+  for (int i = 1; i <= 100; ++i)
+    ramp.push_back(i);
+  double position = 0.25;
+  size_t offset = 0;
+  for (int call = 0; call < 5; ++call) {
+    double step = 1.0 + 0.01 * call;
+    size_t required = resampler.get_required(10, step);
+    ASSERT_LE(offset + required, ramp.size());
+    taylortrack::utils::SignalView view(ramp.data() + offset, 1, 1, static_cast<int64_t>(required));
+    std::vector<double> output(10);
+    size_t consumed = resampler.process(view, 10, step, output.data(), 1);
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_NEAR(position, output[i], 1e-9);
+      position += step;
+    }
+    offset += consumed;
+    ASSERT_NEAR(position - offset, resampler.get_phase(), 1e-9);
+  }
+}
+
+TEST(FractionalResamplerTest, StridedOutput) {
+  taylortrack::utils::FractionalResampler resampler(1);
+  double first = 0.0;
+  resampler.prime(&first);
+  double input[] = {2.0, 4.0, 6.0};
+  taylortrack::utils::SignalView view(input, 1, 1, 3);
+  // half steps into every third value
+  std::vector<double> output(9, -1.0);
+  ASSERT_EQ(2u, resampler.get_required(3, 0.5));
+  ASSERT_EQ(1u, resampler.process(view, 3, 0.5, output.data(), 3));
+  ASSERT_EQ(0.0, output[0]);
+  ASSERT_EQ(1.0, output[3]);
+  ASSERT_EQ(2.0, output[6]);
+  ASSERT_EQ(-1.0, output[1]);
+  ASSERT_EQ(0.5, resampler.get_phase());
+}
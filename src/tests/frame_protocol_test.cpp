@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "sim/frame_protocol.h"
+#include "sim/lag_protocol.h"
+
+TEST(FrameProtocolTest, Float32RoundTrip) {
+  std::vector<double> samples = {0.0, 0.25, -0.5, 1.0, -1.0, 0.123456789};
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 2,
+                                       taylortrack::utils::SampleTransport::kFloat32, &payload,
+                                       &bottle);
+  ASSERT_TRUE(taylortrack::sim::is_packed_frame(bottle));
+  ASSERT_EQ(samples.size() * sizeof(float), bottle.get(3).asBlobLength());
+
+  int channels = 0;
+  std::vector<double> decoded;
+  ASSERT_TRUE(taylortrack::sim::read_packed_frame(bottle, &channels, &decoded));
+  ASSERT_EQ(2, channels);
+  ASSERT_EQ(samples.size(), decoded.size());
+  for (size_t i = 0; i < samples.size(); ++i)
+    ASSERT_FLOAT_EQ(static_cast<float>(samples[i]), static_cast<float>(decoded[i]));
+}
+
+TEST(FrameProtocolTest, Int16QuantizesAndClips) {
+  std::vector<double> samples = {0.0, 0.5, -0.5, 1.0, -1.0, 1.5, -2.0, 1e-6};
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 1,
+                                       taylortrack::utils::SampleTransport::kInt16, &payload,
+                                       &bottle);
+  ASSERT_EQ(samples.size() * sizeof(int16_t), bottle.get(3).asBlobLength());
+
+  std::vector<double> decoded;
+  ASSERT_TRUE(taylortrack::sim::read_packed_frame(bottle, nullptr, &decoded));
+  ASSERT_EQ(samples.size(), decoded.size());
+  // half a quantization step at most
+  for (size_t i = 0; i < 5; ++i)
+    ASSERT_NEAR(samples[i], decoded[i], 0.5 / 32767.0);
+  ASSERT_DOUBLE_EQ(1.0, decoded[5]);
+  ASSERT_DOUBLE_EQ(-1.0, decoded[6]);
+  ASSERT_DOUBLE_EQ(0.0, decoded[7]);
+}
+
+TEST(FrameProtocolTest, BottleTransport) {
+  std::vector<double> samples = {0.1, -0.2, 0.3};
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  bottle.addDouble(42.0);
+  taylortrack::sim::write_samples(samples.data(), samples.size(), 1,
+                                  taylortrack::utils::SampleTransport::kBottle, &payload,
+                                  &bottle);
+  ASSERT_FALSE(taylortrack::sim::is_packed_frame(bottle));
+  ASSERT_EQ(3, bottle.size());
+
+  std::vector<double> decoded;
+  ASSERT_TRUE(taylortrack::sim::read_samples(bottle, &decoded));
+  ASSERT_EQ(samples, decoded);
+}
+
+TEST(FrameProtocolTest, ReadSamplesOfAnyTransport) {
+  std::vector<double> samples = {0.25, -0.75};
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  std::vector<double> decoded;
+
+  taylortrack::sim::write_samples(samples.data(), samples.size(), 2,
+                                  taylortrack::utils::SampleTransport::kInt16, &payload,
+                                  &bottle);
+  ASSERT_TRUE(taylortrack::sim::read_samples(bottle, &decoded));
+  ASSERT_EQ(2u, decoded.size());
+  ASSERT_NEAR(-0.75, decoded[1], 0.5 / 32767.0);
+
+  // an empty bottle is an empty frame
+  bottle.clear();
+  ASSERT_TRUE(taylortrack::sim::read_samples(bottle, &decoded));
+  ASSERT_TRUE(decoded.empty());
+}
+
+TEST(FrameProtocolTest, RejectsOtherMessages) {
+  std::vector<double> lags = {0.5, 1.0};
+  yarp::os::Bottle bottle;
+  taylortrack::sim::write_lag_vectors(true, lags, &bottle);
+
+  std::vector<double> decoded;
+  ASSERT_FALSE(taylortrack::sim::is_packed_frame(bottle));
+  ASSERT_FALSE(taylortrack::sim::read_packed_frame(bottle, nullptr, &decoded));
+  ASSERT_FALSE(taylortrack::sim::read_samples(bottle, &decoded));
+}
+
+TEST(FrameProtocolTest, ReusesPayload) {
+  std::vector<double> samples(64, 0.5);
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 2,
+                                       taylortrack::utils::SampleTransport::kFloat32, &payload,
+                                       &bottle);
+  const char *buffer = payload.data();
+
+  // a smaller frame is packed into the same buffer
+  samples.resize(32);
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 2,
+                                       taylortrack::utils::SampleTransport::kInt16, &payload,
+                                       &bottle);
+  ASSERT_EQ(buffer, payload.data());
+  ASSERT_EQ(samples.size() * sizeof(int16_t), payload.size());
+
+  std::vector<double> decoded;
+  ASSERT_TRUE(taylortrack::sim::read_packed_frame(bottle, nullptr, &decoded));
+  ASSERT_EQ(samples.size(), decoded.size());
+  ASSERT_NEAR(0.5, decoded.back(), 0.5 / 32767.0);
+}
+
+TEST(FrameProtocolTest, Pcm16WithoutConversion) {
+  std::vector<double> samples = {0.0, 0.5, -0.5, 1.0, -1.0, 2.0};
+  std::vector<char> payload;
+  yarp::os::Bottle bottle;
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 3,
+                                       taylortrack::utils::SampleTransport::kInt16, &payload,
+                                       &bottle);
+  int channels = 0;
+  std::vector<int16_t> pcm;
+  ASSERT_TRUE(taylortrack::sim::read_packed_pcm16(bottle, &channels, &pcm));
+  ASSERT_EQ(3, channels);
+  std::vector<int16_t> expected = {0, 16384, -16384, 32767, -32767, 32767};
+  ASSERT_EQ(expected, pcm);
+
+  // float frames and other messages need the conversion of read_samples()
+  taylortrack::sim::write_packed_frame(samples.data(), samples.size(), 3,
+                                       taylortrack::utils::SampleTransport::kFloat32, &payload,
+                                       &bottle);
+  ASSERT_FALSE(taylortrack::sim::read_packed_pcm16(bottle, &channels, &pcm));
+  taylortrack::sim::write_samples(samples.data(), samples.size(), 3,
+                                  taylortrack::utils::SampleTransport::kBottle, &payload,
+                                  &bottle);
+  ASSERT_FALSE(taylortrack::sim::read_packed_pcm16(bottle, &channels, &pcm));
+}
@@ -71,4 +71,13 @@ TEST(ParserTest, InvalidParameterName) {
 
   taylortrack::utils::Parameters parameters = taylortrack::utils::parameter_parser::parse_streamer(argc, testArguments);
   ASSERT_FALSE(parameters.valid);
-}
\ No newline at end of file
+}
+TEST(ParserTest, SetRecordTest) {
+  const char *testArguments[] = {"../sim_datastreamer", "-r", "session.ttcap", "path/to/file/file"};
+  int argc = 4;
+
+  taylortrack::utils::Parameters parameters = taylortrack::utils::parameter_parser::parse_streamer(argc, testArguments);
+  ASSERT_TRUE(parameters.valid);
+  ASSERT_STREQ("session.ttcap", parameters.record);
+  ASSERT_EQ(parameters.file, "path/to/file/file");
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "utils/pcm_decoder.h"
+
+using taylortrack::utils::SampleEncoding;
+
+TEST(PcmDecoderTest, Encodings) {
+  ASSERT_EQ(SampleEncoding::kPcm8, taylortrack::utils::get_sample_encoding(0x0001, 8));
+  ASSERT_EQ(SampleEncoding::kPcm16, taylortrack::utils::get_sample_encoding(0x0001, 16));
+  ASSERT_EQ(SampleEncoding::kPcm24, taylortrack::utils::get_sample_encoding(0x0001, 24));
+  ASSERT_EQ(SampleEncoding::kPcm32, taylortrack::utils::get_sample_encoding(0x0001, 32));
+  ASSERT_EQ(SampleEncoding::kFloat32, taylortrack::utils::get_sample_encoding(0x0003, 32));
+  ASSERT_EQ(SampleEncoding::kUnsupported, taylortrack::utils::get_sample_encoding(0x0003, 64));
+  ASSERT_EQ(SampleEncoding::kUnsupported, taylortrack::utils::get_sample_encoding(0x0001, 12));
+  ASSERT_EQ(SampleEncoding::kUnsupported, taylortrack::utils::get_sample_encoding(0x0055, 16));
+
+  ASSERT_EQ(3, taylortrack::utils::get_sample_size(SampleEncoding::kPcm24));
+  ASSERT_EQ(4, taylortrack::utils::get_sample_size(SampleEncoding::kFloat32));
+  ASSERT_EQ(0, taylortrack::utils::get_sample_size(SampleEncoding::kUnsupported));
+}
+
+TEST(PcmDecoderTest, FullScale) {
+  std::vector<double> output(3);
+
+  const unsigned char pcm8[] = {0x80, 0xFF, 0x01};
+  taylortrack::utils::decode_samples(SampleEncoding::kPcm8, pcm8, 3, output.data());
+  ASSERT_DOUBLE_EQ(0.0, output[0]);
+  ASSERT_DOUBLE_EQ(1.0, output[1]);
+  ASSERT_DOUBLE_EQ(-1.0, output[2]);
+
+  const unsigned char pcm16[] = {0x00, 0x00, 0xFF, 0x7F, 0x01, 0x80};
+  taylortrack::utils::decode_samples(SampleEncoding::kPcm16, pcm16, 3, output.data());
+  ASSERT_DOUBLE_EQ(0.0, output[0]);
+  ASSERT_DOUBLE_EQ(1.0, output[1]);
+  ASSERT_DOUBLE_EQ(-1.0, output[2]);
+
+  const unsigned char pcm24[] = {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x7F, 0x01, 0x00, 0x80};
+  taylortrack::utils::decode_samples(SampleEncoding::kPcm24, pcm24, 3, output.data());
+  ASSERT_DOUBLE_EQ(0.0, output[0]);
+  ASSERT_DOUBLE_EQ(1.0, output[1]);
+  ASSERT_DOUBLE_EQ(-1.0, output[2]);
+
+  const unsigned char pcm32[] = {0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x7F, 0x01, 0x00, 0x00, 0x80};
+  taylortrack::utils::decode_samples(SampleEncoding::kPcm32, pcm32, 3, output.data());
+  ASSERT_DOUBLE_EQ(0.0, output[0]);
+  ASSERT_DOUBLE_EQ(1.0, output[1]);
+  ASSERT_DOUBLE_EQ(-1.0, output[2]);
+}
+
+TEST(PcmDecoderTest, Unaligned24And32Bit) {
+  // the samples start at an odd address, -2 and 0.5
+  const unsigned char bytes[] = {0x00, 0xFE, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x3F};
+  std::vector<double> output(1);
+
+  taylortrack::utils::decode_samples(SampleEncoding::kPcm24, bytes + 1, 1, output.data());
+  ASSERT_DOUBLE_EQ(-2 / 8388607.0, output[0]);
+
+  taylortrack::utils::decode_samples(SampleEncoding::kFloat32, bytes + 4, 1, output.data());
+  ASSERT_DOUBLE_EQ(0.5, output[0]);
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "utils/polyphase_resampler.h"
+
+namespace {
+const double kPI = 3.141592653589793238460;
+
+// interleaved sine of the given frequency on every channel, channel c is delayed by c samples
+std::vector<double> make_sine(double frequency, int rate, int channels, int length) {
+  std::vector<double> samples(static_cast<size_t>(length * channels));
+  for (int n = 0; n < length; ++n) {
+    for (int c = 0; c < channels; ++c)
+      samples[n * channels + c] = sin(2 * kPI * frequency * (n - c) / rate);
+  }
+  return samples;
+}
+}  // namespace
+
+TEST(PolyphaseResamplerTest, RatioTest) {
+  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 4);
+  ASSERT_EQ(160, resampler.get_interpolation());
+  ASSERT_EQ(441, resampler.get_decimation());
+  ASSERT_EQ(4, resampler.get_channels());
+
+  std::vector<double> input(4 * 44100, 0.0);
+  std::vector<double> output;
+  resampler.process(taylortrack::utils::SignalView(input.data(), 4, 4, 44100), &output);
+  ASSERT_EQ(4u * 16000u, output.size());
+}
+
+TEST(PolyphaseResamplerTest, PassbandTest) {
+  // a 1 kHz tone passes with unit gain and the right frequency
+  std::vector<double> input = make_sine(1000.0, 44100, 1, 44100);
+  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 1);
+  std::vector<double> output;
+  resampler.process(taylortrack::utils::SignalView(input.data(), 1, 1, 44100), &output);
+
+  // the group delay of the filter in output samples
+  double delay = (160.0 * 32 - 1) / 2.0 / 441.0;
+  for (int m = 1000; m < 15000; ++m) {
+    double expected = sin(2 * kPI * 1000.0 * (m - delay) / 16000.0);
+    ASSERT_NEAR(expected, output[m], 1e-2);
+  }
+}
+
+TEST(PolyphaseResamplerTest, StopbandTest) {
+  // a 12 kHz tone is above the new nyquist frequency and gets removed
+  std::vector<double> input = make_sine(12000.0, 44100, 1, 44100);
+  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 1);
+  std::vector<double> output;
+  resampler.process(taylortrack::utils::SignalView(input.data(), 1, 1, 44100), &output);
+  double peak = 0.0;
+  for (int m = 1000; m < 15000; ++m)
+    peak = std::max(peak, std::abs(output[m]));
+  ASSERT_LT(peak, 1e-3);
+}
+
+TEST(PolyphaseResamplerTest, StreamingTest) {
+  // converting a stream frame by frame gives the same result as a single call
+  std::vector<double> input = make_sine(440.0, 44100, 2, 20000);
+  taylortrack::utils::PolyphaseResampler whole(44100, 16000, 2);
+  std::vector<double> expected;
+  whole.process(taylortrack::utils::SignalView(input.data(), 2, 2, 20000), &expected);
+
+  taylortrack::utils::PolyphaseResampler streamed(44100, 16000, 2);
+  std::vector<double> output;
+  std::vector<double> frame_output;
+  for (int start = 0; start < 20000; start += 2049) {
+    int length = std::min(2049, 20000 - start);
+    streamed.process(taylortrack::utils::SignalView(input.data() + start * 2, 2, 2, length),
+                     &frame_output);
+    output.insert(output.end(), frame_output.begin(), frame_output.end());
+  }
+  ASSERT_EQ(expected.size(), output.size());
+  for (size_t i = 0; i < output.size(); ++i)
+    ASSERT_DOUBLE_EQ(expected[i], output[i]);
+}
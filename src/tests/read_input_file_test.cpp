@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <fstream>
+#include <string>
 #include "zlib.h"
 #include "input/read_file_input_strategy.h"
 
@@ -149,4 +151,25 @@ TEST(InputFileTest, NoParamTest) {
   strategy.read(&bottle);
 
   ASSERT_EQ(0, bottle.size());
-}
\ No newline at end of file
+}
+TEST(InputFileTest, ChunksEndWithFile) {
+  taylortrack::utils::Parameters params;
+  params.file = "../Testdata/Test.txt";
+  params.size = 1000;
+  taylortrack::input::ReadFileInputStrategy strategy;
+  strategy.set_parameters(params);
+
+  std::ifstream file("../Testdata/Test.txt", std::ios::in | std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  // the last chunk only holds the remaining bytes
+  std::string streamed;
+  int chunks = 0;
+  while (!strategy.is_done()) {
+    yarp::os::Bottle bottle;
+    streamed += strategy.read(&bottle).pop().asString();
+    ++chunks;
+  }
+  ASSERT_EQ(4, chunks);
+  ASSERT_EQ(content, streamed);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "input/replay_input_strategy.h"
+#include "utils/capture_recorder.h"
+#include "utils/parameters.h"
+
+namespace {
+const char kReplayFile[] = "replay_input_test.ttcap";
+
+// ten frames of three samples recorded 20 ms apart
+void record_session() {
+  taylortrack::utils::CaptureRecorder recorder(kReplayFile);
+  for (int frame = 0; frame < 10; ++frame) {
+    std::vector<double> samples = {frame * 0.25, -frame * 0.25, 0.5};
+    recorder.record(frame, 5000.0 + frame * 0.02, samples.data(), samples.size());
+  }
+}
+}  // namespace
+
+TEST(ReplayInputTest, ReplaysFromTimestamp) {
+  record_session();
+  taylortrack::utils::Parameters parameter;
+  parameter.file = kReplayFile;
+  taylortrack::utils::ConfigParser config;
+  taylortrack::utils::ReplayInputSettings settings;
+  settings.start = 0.1;
+  config.set_replay_input_settings(settings);
+
+  taylortrack::input::ReplayInputStrategy input;
+  input.set_parameters(parameter);
+  input.set_config(config);
+  ASSERT_TRUE(input.is_paced());
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  int frame = 5;
+  while (!input.is_done()) {
+    yarp::os::Bottle bottle;
+    input.read(&bottle);
+    ASSERT_EQ(3, bottle.size());
+    ASSERT_DOUBLE_EQ(frame * 0.25, bottle.get(0).asDouble());
+    ASSERT_DOUBLE_EQ(-frame * 0.25, bottle.get(1).asDouble());
+    ++frame;
+  }
+  ASSERT_EQ(10, frame);
+  // the last frame is replayed 80 ms after the first like it was recorded
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_GE(elapsed.count(), 0.08);
+  std::remove(kReplayFile);
+}
+
+TEST(ReplayInputTest, InvalidRecording) {
+  taylortrack::utils::Parameters parameter;
+  parameter.file = "../Testdata/Test.wav";
+
+  taylortrack::input::ReplayInputStrategy input;
+  input.set_parameters(parameter);
+  ASSERT_TRUE(input.is_done());
+  yarp::os::Bottle bottle;
+  input.read(&bottle);
+  ASSERT_EQ(0, bottle.size());
+}
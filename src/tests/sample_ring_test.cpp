@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "utils/sample_ring.h"
+
+TEST(SampleRingTest, CapacityIsPowerOfTwo) {
+  taylortrack::utils::SampleRing ring(2, 1000);
+  ASSERT_EQ(1024u, ring.get_capacity());
+  ASSERT_EQ(2, ring.get_channels());
+  ASSERT_EQ(0u, ring.get_available());
+}
+
+TEST(SampleRingTest, InterleavesPeriods) {
+  taylortrack::utils::SampleRing ring(2, 8);
+  float left[] = {1.0f, 2.0f, 3.0f};
+  float right[] = {-1.0f, -2.0f, -3.0f};
+  const float *period[] = {left, right};
+  ASSERT_TRUE(ring.write(period, 3));
+  ASSERT_TRUE(ring.write(period, 3));
+  ASSERT_EQ(6u, ring.get_available());
+
+  // frames of another size than the periods, with room for a third channel of another device
+  std::vector<double> frame(3 * 4, 0.0);
+  ASSERT_TRUE(ring.read(4, frame.data(), 3));
+  ASSERT_EQ(2u, ring.get_available());
+  double expected[] = {1.0, -1.0, 0.0, 2.0, -2.0, 0.0, 3.0, -3.0, 0.0, 1.0, -1.0, 0.0};
+  for (int i = 0; i < 12; ++i)
+    ASSERT_EQ(expected[i], frame[i]);
+  ASSERT_FALSE(ring.read(4, frame.data(), 3));
+}
+
+TEST(SampleRingTest, CountsOverruns) {
+  taylortrack::utils::SampleRing ring(1, 4);
+  float samples[] = {1.0f, 2.0f, 3.0f};
+  const float *period[] = {samples};
+  ASSERT_TRUE(ring.write(period, 3));
+  // the second period does not fit and is dropped as a whole
+  ASSERT_FALSE(ring.write(period, 3));
+  ASSERT_EQ(1u, ring.get_overruns());
+  ASSERT_EQ(3u, ring.get_available());
+
+  double frame[3];
+  ASSERT_TRUE(ring.read(3, frame, 1));
+  ASSERT_TRUE(ring.write(period, 3));
+  ASSERT_EQ(1u, ring.get_overruns());
+}
+
+TEST(SampleRingTest, ProducerAndConsumerThreads) {
+  const int periods = 2000;
+  const int period_size = 64;
+  const int frame_size = 100;
+  taylortrack::utils::SampleRing ring(2, 1024);
+
+  std::thread producer([&]() {
+    std::vector<float> left(period_size);
+    std::vector<float> right(period_size);
+    const float *period[] = {left.data(), right.data()};
+    for (int i = 0; i < periods; ++i) {
+      for (int j = 0; j < period_size; ++j) {
+        left[j] = static_cast<float>(i * period_size + j);
+        right[j] = -left[j];
+      }
+      while (!ring.write(period, period_size))
+        std::this_thread::yield();
+    }
+  });
+
+  // every sample arrives once and in order
+  std::vector<double> frame(2 * frame_size);
+  int frames = periods * period_size / frame_size;
+  for (int i = 0; i < frames; ++i) {
+    while (!ring.read(frame_size, frame.data(), 2))
+      std::this_thread::yield();
+    for (int j = 0; j < frame_size; ++j) {
+      ASSERT_EQ(static_cast<double>(i * frame_size + j), frame[2 * j]);
+      ASSERT_EQ(-frame[2 * j], frame[2 * j + 1]);
+    }
+  }
+  producer.join();
+  ASSERT_EQ(static_cast<size_t>(periods * period_size - frames * frame_size), ring.get_available());
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "sim/scene_synthesizer.h"
+
+namespace {
+taylortrack::utils::AudioSettings make_array(int microphones) {
+  taylortrack::utils::AudioSettings audio;
+  audio.sample_rate = 44100;
+  audio.mic_x.resize(microphones);
+  audio.mic_y.resize(microphones);
+  // microphones on a circle of 10 cm radius
+  for (int microphone = 0; microphone < microphones; ++microphone) {
+    audio.mic_x[microphone] = 0.1 * std::cos(2.0 * M_PI * microphone / microphones);
+    audio.mic_y[microphone] = 0.1 * std::sin(2.0 * M_PI * microphone / microphones);
+  }
+  return audio;
+}
+
+taylortrack::utils::SyntheticSource make_static(double x, double y) {
+  taylortrack::utils::SyntheticSource source;
+  source.x = x;
+  source.y = y;
+  return source;
+}
+
+// lag of channel second behind channel first with the largest cross correlation
+int find_lag(const std::vector<double> &samples, int channels, int first, int second, int max_lag) {
+  size_t frames = samples.size() / channels;
+  int best_lag = 0;
+  double best = -1e300;
+  for (int lag = -max_lag; lag <= max_lag; ++lag) {
+    double sum = 0.0;
+    for (size_t frame = max_lag; frame + max_lag < frames; ++frame)
+      sum += samples[frame * channels + first] * samples[(frame + lag) * channels + second];
+    if (sum > best) {
+      best = sum;
+      best_lag = lag;
+    }
+  }
+  return best_lag;
+}
+}  // namespace
+
+TEST(SceneSynthesizerTest, DelaysFollowGeometry) {
+  taylortrack::utils::AudioSettings audio;
+  // sound travels exactly 100 samples per meter
+  audio.sample_rate = 34042;
+  audio.mic_x = {-0.5, 0.5};
+  audio.mic_y = {0.0, 0.0};
+  taylortrack::utils::SyntheticInputSettings settings;
+  settings.noise = 0.0;
+  settings.sources.push_back(make_static(-2.0, 0.0));
+  taylortrack::sim::SceneSynthesizer synthesizer(audio, settings);
+
+  std::vector<double> samples(8192 * 2);
+  synthesizer.synthesize(8192, samples.data());
+  // one meter further to the second microphone
+  ASSERT_EQ(100, find_lag(samples, 2, 0, 1, 200));
+  // and attenuated by the longer distance
+  for (size_t frame = 100; frame < 8192; ++frame)
+    ASSERT_NEAR(samples[(frame - 100) * 2] * 1.5 / 2.5, samples[frame * 2 + 1], 1e-9);
+}
+
+TEST(SceneSynthesizerTest, Trajectories) {
+  taylortrack::utils::SyntheticInputSettings settings;
+  taylortrack::utils::SyntheticSource line;
+  line.trajectory = taylortrack::utils::TrajectoryType::kLine;
+  line.x = -1.0;
+  line.y = 1.0;
+  line.x_end = 1.0;
+  line.y_end = 1.0;
+  line.period = 4.0;
+  settings.sources.push_back(line);
+  taylortrack::utils::SyntheticSource circle;
+  circle.trajectory = taylortrack::utils::TrajectoryType::kCircle;
+  circle.x = 0.5;
+  circle.radius = 2.0;
+  circle.period = 8.0;
+  settings.sources.push_back(circle);
+  taylortrack::sim::SceneSynthesizer synthesizer(make_array(4), settings);
+  ASSERT_EQ(2u, synthesizer.get_source_count());
+
+  double x = 0.0;
+  double y = 0.0;
+  synthesizer.get_source_position(0, 1.0, &x, &y);
+  ASSERT_NEAR(0.0, x, 1e-12);
+  ASSERT_NEAR(1.0, y, 1e-12);
+  // turns around at the end and is back after a period
+  synthesizer.get_source_position(0, 2.0, &x, &y);
+  ASSERT_NEAR(1.0, x, 1e-12);
+  synthesizer.get_source_position(0, 3.0, &x, &y);
+  ASSERT_NEAR(0.0, x, 1e-12);
+  synthesizer.get_source_position(0, 4.0, &x, &y);
+  ASSERT_NEAR(-1.0, x, 1e-12);
+
+  synthesizer.get_source_position(1, 0.0, &x, &y);
+  ASSERT_NEAR(2.5, x, 1e-12);
+  ASSERT_NEAR(0.0, y, 1e-12);
+  synthesizer.get_source_position(1, 2.0, &x, &y);
+  ASSERT_NEAR(0.5, x, 1e-12);
+  ASSERT_NEAR(2.0, y, 1e-12);
+}
+
+TEST(SceneSynthesizerTest, MovingSourceIsTracked) {
+  taylortrack::utils::AudioSettings audio;
+  audio.sample_rate = 16000;
+  audio.mic_x = {-0.5, 0.5};
+  audio.mic_y = {0.0, 0.0};
+  taylortrack::utils::SyntheticInputSettings settings;
+  settings.noise = 0.0;
+  taylortrack::utils::SyntheticSource line;
+  line.trajectory = taylortrack::utils::TrajectoryType::kLine;
+  line.x = -3.0;
+  line.y = 0.0;
+  line.x_end = 3.0;
+  line.y_end = 0.0;
+  line.period = 4.0;
+  settings.sources.push_back(line);
+  taylortrack::sim::SceneSynthesizer synthesizer(audio, settings);
+
+  // left of the array the sound reaches the left microphone first, right of it the right one
+  std::vector<double> samples(4096 * 2);
+  synthesizer.synthesize(4096, samples.data());
+  int expected = static_cast<int>(std::round(16000 / 340.42));
+  ASSERT_EQ(expected, find_lag(samples, 2, 0, 1, 100));
+  // skip to the end of the line
+  std::vector<double> skipped(16000 * 2 * 2 - 4096 * 2);
+  synthesizer.synthesize(skipped.size() / 2, skipped.data());
+  synthesizer.synthesize(4096, samples.data());
+  ASSERT_EQ(-expected, find_lag(samples, 2, 0, 1, 100));
+  ASSERT_EQ(2 * 16000 + 4096, synthesizer.get_position());
+}
+
+TEST(SceneSynthesizerTest, ContinuesAcrossFrames) {
+  taylortrack::utils::SyntheticInputSettings settings;
+  settings.noise = 0.0;
+  settings.reflection = 0.5;
+  taylortrack::utils::SyntheticSource circle;
+  circle.trajectory = taylortrack::utils::TrajectoryType::kCircle;
+  circle.radius = 1.0;
+  circle.period = 0.1;
+  settings.sources.push_back(circle);
+  settings.sources.push_back(make_static(1.0, -1.5));
+  taylortrack::sim::SceneSynthesizer whole(make_array(3), settings);
+  taylortrack::sim::SceneSynthesizer parts(make_array(3), settings);
+
+  std::vector<double> expected(1000 * 3);
+  whole.synthesize(1000, expected.data());
+  std::vector<double> samples(1000 * 3);
+  parts.synthesize(300, samples.data());
+  parts.synthesize(700, samples.data() + 300 * 3);
+  for (size_t sample = 0; sample < samples.size(); ++sample)
+    ASSERT_NEAR(expected[sample], samples[sample], 1e-12);
+}
+
+TEST(SceneSynthesizerTest, SensorNoise) {
+  taylortrack::utils::SyntheticInputSettings settings;
+  settings.noise = 0.05;
+  taylortrack::sim::SceneSynthesizer synthesizer(make_array(2), settings);
+
+  std::vector<double> samples(20000 * 2);
+  synthesizer.synthesize(20000, samples.data());
+  double power = 0.0;
+  double cross = 0.0;
+  for (size_t frame = 0; frame < 20000; ++frame) {
+    power += samples[frame * 2] * samples[frame * 2];
+    cross += samples[frame * 2] * samples[frame * 2 + 1];
+  }
+  ASSERT_NEAR(0.05, std::sqrt(power / 20000), 0.002);
+  // independent between the microphones
+  ASSERT_NEAR(0.0, cross / power, 0.05);
+}
+
+TEST(SceneSynthesizerTest, FasterThanRealTime) {
+  taylortrack::utils::SyntheticInputSettings settings;
+  taylortrack::utils::SyntheticSource circle;
+  circle.trajectory = taylortrack::utils::TrajectoryType::kCircle;
+  circle.radius = 1.5;
+  circle.period = 10.0;
+  settings.sources.push_back(circle);
+  settings.reflection = 0.3;
+  taylortrack::sim::SceneSynthesizer synthesizer(make_array(32), settings);
+  ASSERT_EQ(32, synthesizer.get_channels());
+
+  std::vector<double> samples(2048 * 32);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  // one second of a 32 channel array with a moving source and its four mirror sources
+  for (int frame = 0; frame < 22; ++frame)
+    synthesizer.synthesize(2048, samples.data());
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_LT(elapsed.count(), 1.0);
+}
@@ -0,0 +1,47 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "utils/spsc_queue.h"
+
+TEST(SpscQueueTest, CapacityTest) {
+  taylortrack::utils::SpscQueue<int> queue(3);
+  ASSERT_EQ(3u, queue.get_capacity());
+  ASSERT_TRUE(queue.empty());
+  ASSERT_TRUE(queue.try_push(1));
+  ASSERT_TRUE(queue.try_push(2));
+  ASSERT_TRUE(queue.try_push(3));
+  ASSERT_FALSE(queue.try_push(4));
+  int value = 0;
+  ASSERT_TRUE(queue.try_pop(&value));
+  ASSERT_EQ(1, value);
+  ASSERT_TRUE(queue.try_push(4));
+  for (int expected = 2; expected <= 4; ++expected) {
+    ASSERT_TRUE(queue.try_pop(&value));
+    ASSERT_EQ(expected, value);
+  }
+  ASSERT_FALSE(queue.try_pop(&value));
+  ASSERT_EQ(4, value);
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, ThreadedOrderTest) {
+  // a small queue forces both sides to wait for each other many times
+  taylortrack::utils::SpscQueue<std::vector<int>> queue(2);
+  const int count = 20000;
+  std::thread producer([&]() {
+    for (int i = 0; i < count; ++i) {
+      std::vector<int> item(1, i);
+      while (!queue.try_push(item))
+        std::this_thread::yield();
+    }
+  });
+  std::vector<int> item;
+  for (int i = 0; i < count; ++i) {
+    while (!queue.try_pop(&item))
+      std::this_thread::yield();
+    ASSERT_EQ(1u, item.size());
+    ASSERT_EQ(i, item[0]);
+  }
+  producer.join();
+  ASSERT_TRUE(queue.empty());
+}
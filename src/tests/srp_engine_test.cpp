@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "localization/srp_engine.h"
+#include "localization/srp_phat.h"
+
+namespace {
+taylortrack::utils::AudioSettings array_settings(double radius) {
+  double mx[] = {radius, 0.0, -radius, 0.0};
+  double my[] = {0.0, radius, 0.0, -radius};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 1024;
+  settings.subbands = 2;
+  return settings;
+}
+}  // namespace
+
+TEST(SrpEngineTest, SharedTablesTest) {
+  std::shared_ptr<taylortrack::localization::SrpEngine> engine =
+      std::make_shared<taylortrack::localization::SrpEngine>(3);
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(array_settings(0.055));
+  taylortrack::localization::SrpPhat first;
+  first.set_engine(engine);
+  first.set_config(config);
+  taylortrack::localization::SrpPhat second;
+  second.set_engine(engine);
+  second.set_config(config);
+  // identical geometry is built once
+  ASSERT_EQ(1u, engine->get_table_count());
+  taylortrack::localization::SrpPhat alone;
+  alone.set_config(config);
+
+  config.set_audio_settings(array_settings(0.08));
+  taylortrack::localization::SrpPhat other;
+  other.set_engine(engine);
+  other.set_config(config);
+  ASSERT_EQ(2u, engine->get_table_count());
+  ASSERT_EQ(engine->get_fft_plan(2048), engine->get_fft_plan(2048));
+
+  std::vector<double> interleaved(4 * 1025);
+  srand(11);
+  for (double &sample : interleaved)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  taylortrack::utils::SignalView view(interleaved.data(), 4, 4, 1025);
+  first.calculate_position_and_distribution(view);
+  second.calculate_position_and_distribution(view);
+  alone.calculate_position_and_distribution(view);
+  // sharing changes nothing about the results
+  ASSERT_EQ(alone.get_last_position(), first.get_last_position());
+  for (int degree = 0; degree < 360; ++degree) {
+    ASSERT_NEAR(alone.get_last_distribution()[degree],
+                first.get_last_distribution()[degree], 1e-12);
+    ASSERT_DOUBLE_EQ(first.get_last_distribution()[degree],
+                     second.get_last_distribution()[degree]);
+  }
+}
+
+TEST(SrpEngineTest, LatencyTest) {
+  taylortrack::localization::SrpEngine engine(1);
+  int kitchen = engine.add_session("kitchen");
+  int hall = engine.add_session("hall");
+  ASSERT_EQ(2, engine.get_session_count());
+  ASSERT_STREQ("hall", engine.get_session_name(hall).c_str());
+  engine.report_latency(kitchen, 0.01);
+  engine.report_latency(kitchen, 0.03);
+  engine.report_latency(hall, 0.5);
+  taylortrack::localization::LatencyStats stats = engine.get_latency(kitchen);
+  ASSERT_EQ(2, stats.frames);
+  ASSERT_DOUBLE_EQ(0.03, stats.last);
+  ASSERT_DOUBLE_EQ(0.02, stats.mean);
+  ASSERT_DOUBLE_EQ(0.03, stats.maximum);
+  ASSERT_EQ(1, engine.get_latency(hall).frames);
+}
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "localization/srp_phat_fixed.h"
+#include "utils/config_parser.h"
+
+TEST(SrpPhatFixedTest, Pcm16Test) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::localization::RArray(mx, 4);
+  settings.mic_y = taylortrack::localization::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  taylortrack::localization::SrpPhatFixed srp;
+  srp.set_config(config);
+
+  std::vector<taylortrack::localization::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+
+  // interleave and quantize the first 2049 samples of every channel
+  std::vector<double> interleaved(4 * 2049);
+  std::vector<int16_t> pcm(4 * 2049);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < 2049; ++i) {
+      double sample = signals[channel][i];
+      interleaved[i * 4 + channel] = sample;
+      pcm[i * 4 + channel] = static_cast<int16_t>(
+          std::lround(std::max(-1.0, std::min(1.0, sample)) * 32767.0));
+    }
+  }
+  taylortrack::utils::SignalView frame(interleaved.data(), 4, 4, 2049);
+  taylortrack::utils::Pcm16View pcm_frame(pcm.data(), 4, 4, 2049);
+
+  taylortrack::localization::RArray expected = srp.get_position_distribution(frame);
+  taylortrack::localization::RArray distribution =
+      srp.get_position_distribution(pcm_frame);
+  ASSERT_EQ(360, distribution.size());
+  double error = 0.0;
+  for (int degree = 0; degree < 360; ++degree)
+    error = std::max(error, std::abs(expected[degree] - distribution[degree]));
+  // the approximated PHAT weighting stays within a few percent of the peak
+  ASSERT_LT(error, 5e-4);
+
+  srp.calculate_position_and_distribution(pcm_frame);
+  ASSERT_EQ(180, srp.get_last_position());
+}
+
+TEST(SrpPhatFixedTest, SilenceTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::localization::RArray(mx, 4);
+  settings.mic_y = taylortrack::localization::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  taylortrack::localization::SrpPhatFixed srp;
+  srp.set_config(config);
+
+  // digital silence gives a uniform distribution instead of dividing by zero
+  std::vector<int16_t> pcm(4 * 2049, 0);
+  taylortrack::utils::Pcm16View pcm_frame(pcm.data(), 4, 4, 2049);
+  taylortrack::localization::RArray distribution = srp.get_position_distribution(pcm_frame);
+  ASSERT_EQ(360, distribution.size());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_DOUBLE_EQ(1.0 / 360, distribution[degree]);
+
+  srp.calculate_position_and_distribution(pcm_frame);
+  const taylortrack::localization::RArray &last = srp.get_last_distribution();
+  ASSERT_EQ(360, last.size());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_DOUBLE_EQ(1.0 / 360, last[degree]);
+}
+
+TEST(SrpPhatFixedTest, BandLimitTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::localization::RArray(mx, 4);
+  settings.mic_y = taylortrack::localization::RArray(my, 4);
+  settings.frame_size = 2048;
+  settings.band_low = 300.0;
+  settings.band_high = 8000.0;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  taylortrack::localization::SrpPhatFixed srp;
+  srp.set_config(config);
+
+  std::vector<taylortrack::localization::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+  std::vector<int16_t> pcm(4 * 2049);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < 2049; ++i)
+      pcm[i * 4 + channel] = static_cast<int16_t>(std::lround(
+          std::max(-1.0, std::min(1.0, signals[channel][i])) * 32767.0));
+  }
+  srp.calculate_position_and_distribution(
+      taylortrack::utils::Pcm16View(pcm.data(), 4, 4, 2049));
+  ASSERT_EQ(180, srp.get_last_position());
+}
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
+#include <cmath>
 #include <cstdlib>
 #include <fstream>
+#include "localization/azimuth_tracker.h"
 #include "localization/srp_phat.h"
 #include "utils/fft_lib.h"
 #include "utils/config.h"
+#include "utils/polyphase_resampler.h"
 
 TEST(SrpPhatTest, imtdfTest) {
   taylortrack::utils::RArray point(2);
@@ -436,3 +439,715 @@ TEST(SrpPhatTest, getPosandDistributionTest) {
   ASSERT_EQ(180, estimates[2]);
   ASSERT_EQ(360, srp.get_last_distribution().size());
 }
+
+TEST(SrpPhatTest, minimumBaselinePairsTest) {
+  double mx[] = {0.0, 0.1, 0.2, 0.0};
+  double my[] = {0.0, 0.0, 0.0, 0.1};
+  taylortrack::utils::RArray micsX(mx, 4);
+  taylortrack::utils::RArray micsY(my, 4);
+  taylortrack::localization::SrpPhat srp;
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = micsX;
+  settings.mic_y = micsY;
+  settings.pair_selection = taylortrack::utils::PairSelectionPolicy::kMinimumBaseline;
+  settings.min_baseline = 0.15;
+
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  srp.set_config(config);
+
+  std::vector<std::tuple<int, int>> micP = srp.get_microphone_pairs();
+  ASSERT_EQ(2, micP.size());
+  ASSERT_EQ(std::make_tuple(0, 2), micP[0]);
+  ASSERT_EQ(std::make_tuple(2, 3), micP[1]);
+  ASSERT_EQ(2, srp.get_delay_tensor()[0][0].size());
+
+  // budget keeps the longest baseline only
+  settings.max_pairs = 1;
+  config.set_audio_settings(settings);
+  srp.set_config(config);
+  micP = srp.get_microphone_pairs();
+  ASSERT_EQ(1, micP.size());
+  ASSERT_EQ(std::make_tuple(2, 3), micP[0]);
+}
+
+TEST(SrpPhatTest, diversePairsTest) {
+  // two parallel long pairs and a short perpendicular one
+  double mx[] = {0.0, 0.2, 0.0, 0.2, 0.0};
+  double my[] = {0.0, 0.0, 0.01, 0.01, 0.05};
+  taylortrack::utils::RArray micsX(mx, 5);
+  taylortrack::utils::RArray micsY(my, 5);
+  taylortrack::localization::SrpPhat srp;
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = micsX;
+  settings.mic_y = micsY;
+  settings.pair_selection = taylortrack::utils::PairSelectionPolicy::kTopK;
+  settings.max_pairs = 2;
+
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  srp.set_config(config);
+
+  std::vector<std::tuple<int, int>> micP = srp.get_microphone_pairs();
+  ASSERT_EQ(2, micP.size());
+  double first = atan2(srp.get_y_dim_mics()[std::get<1>(micP[0])] - srp.get_y_dim_mics()[std::get<0>(micP[0])],
+                       srp.get_x_dim_mics()[std::get<1>(micP[0])] - srp.get_x_dim_mics()[std::get<0>(micP[0])]);
+  double second = atan2(srp.get_y_dim_mics()[std::get<1>(micP[1])] - srp.get_y_dim_mics()[std::get<0>(micP[1])],
+                        srp.get_x_dim_mics()[std::get<1>(micP[1])] - srp.get_x_dim_mics()[std::get<0>(micP[1])]);
+  ASSERT_GT(std::abs(sin(first - second)), 0.1);
+}
+
+TEST(SrpPhatTest, roundRobinPairsTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::RArray micsX(mx, 4);
+  taylortrack::utils::RArray micsY(my, 4);
+  taylortrack::localization::SrpPhat srp;
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = micsX;
+  settings.mic_y = micsY;
+  settings.pair_selection = taylortrack::utils::PairSelectionPolicy::kRoundRobin;
+  settings.max_pairs = 4;
+
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  srp.set_config(config);
+
+  ASSERT_EQ(6, srp.get_microphone_pairs().size());
+  std::vector<int> frame1 = srp.schedule_frame_pairs();
+  std::vector<int> frame2 = srp.schedule_frame_pairs();
+  std::vector<int> frame3 = srp.schedule_frame_pairs();
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), frame1);
+  ASSERT_EQ(std::vector<int>({4, 5, 0, 1}), frame2);
+  ASSERT_EQ(std::vector<int>({2, 3, 4, 5}), frame3);
+
+  // the rotation can be placed by the frame number, like the workers do
+  srp.set_frame_number(1);
+  ASSERT_EQ(frame2, srp.schedule_frame_pairs());
+  srp.set_frame_number(5);
+  ASSERT_EQ(frame3, srp.schedule_frame_pairs());
+}
+
+TEST(SrpPhatTest, signalViewTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::RArray micsX(mx, 4);
+  taylortrack::utils::RArray micsY(my, 4);
+  taylortrack::localization::SrpPhat srp;
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = micsX;
+  settings.mic_y = micsY;
+  settings.frame_size = 2048;
+
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+
+  srp.set_config(config);
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+
+  // interleave the first 2049 samples of every channel
+  std::vector<double> interleaved(4 * 2049);
+  std::vector<taylortrack::utils::RArray> slices;
+  for (int channel = 0; channel < 4; ++channel) {
+    slices.push_back(signals[channel][std::slice(0, 2049, 1)]);
+    for (int i = 0; i < 2049; ++i)
+      interleaved[i * 4 + channel] = signals[channel][i];
+  }
+  taylortrack::utils::SignalView frame(interleaved.data(), 4, 4, 2049);
+
+  taylortrack::utils::RArray expected = srp.get_position_distribution(slices);
+  taylortrack::utils::RArray distribution = srp.get_position_distribution(frame);
+  ASSERT_EQ(360, distribution.size());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(expected[degree], distribution[degree], 1e-12);
+
+  srp.calculate_position_and_distribution(frame);
+  ASSERT_EQ(180, srp.get_last_position());
+}
+
+TEST(SrpPhatTest, subbandTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+  taylortrack::utils::RArray expected = srp.get_position_distribution(signals);
+
+  // evaluating single lags over the full band matches the inverse transformation
+  settings.subbands = 4;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat subband_srp;
+  subband_srp.set_config(config);
+  ASSERT_EQ(4, subband_srp.get_subbands());
+  taylortrack::utils::RArray distribution =
+      subband_srp.get_position_distribution(signals);
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(expected[degree], distribution[degree], 1e-9);
+
+  // limiting the band to speech frequencies keeps the position
+  settings.band_low = 300.0;
+  settings.band_high = 8000.0;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat band_srp;
+  band_srp.set_config(config);
+  ASSERT_EQ(300.0, band_srp.get_band_low());
+  ASSERT_EQ(8000.0, band_srp.get_band_high());
+  band_srp.calculate_position_and_distribution(signals);
+  ASSERT_EQ(180, band_srp.get_last_position());
+}
+
+TEST(SrpPhatTest, decimatedTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  settings.decimated_rate = 16000;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  ASSERT_EQ(16000, srp.get_samplerate());
+  ASSERT_EQ(743, srp.get_steps());
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+  int length = static_cast<int>(signals[0].size());
+  std::vector<double> interleaved(4 * length);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < length; ++i)
+      interleaved[i * 4 + channel] = signals[channel][i];
+  }
+
+  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 4);
+  std::vector<double> decimated;
+  resampler.process(taylortrack::utils::SignalView(interleaved.data(), 4, 4, length),
+                    &decimated);
+  // skipping the start up of the filter
+  int skip = 64;
+  taylortrack::utils::SignalView frame(decimated.data() + 4 * skip, 4, 4,
+                                       static_cast<int64_t>(decimated.size() / 4) - skip);
+  srp.calculate_position_and_distribution(frame);
+  ASSERT_EQ(180, srp.get_last_position());
+}
+
+TEST(SrpPhatTest, trackingTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat full_srp;
+  full_srp.set_config(config);
+
+  settings.tracking = true;
+  settings.tracking_window = 20.0;
+  settings.full_sweep_interval = 3;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  ASSERT_TRUE(srp.is_tracking());
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+  full_srp.calculate_position_and_distribution(signals);
+  taylortrack::utils::RArray full = full_srp.get_last_distribution();
+
+  // the first frame sweeps all degrees
+  srp.calculate_position_and_distribution(signals);
+  ASSERT_EQ(180, srp.get_last_position());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(full[degree], srp.get_last_distribution()[degree], 1e-12);
+
+  // the following frames only search around the tracked position
+  for (int frame = 0; frame < 3; ++frame) {
+    srp.calculate_position_and_distribution(signals);
+    ASSERT_EQ(180, srp.get_last_position());
+    const taylortrack::utils::RArray &windowed = srp.get_last_distribution();
+    ASSERT_EQ(0.0, windowed[0]);
+    ASSERT_EQ(0.0, windowed[90]);
+    // inside the window the values keep their proportions
+    ASSERT_NEAR(full[170] / full[180], windowed[170] / windowed[180], 1e-9);
+  }
+
+  // after the configured number of windowed frames all degrees are searched again
+  srp.calculate_position_and_distribution(signals);
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(full[degree], srp.get_last_distribution()[degree], 1e-12);
+}
+
+TEST(SrpPhatTest, beamformingTest) {
+  // microphones placed so that the delays are whole samples
+  double spacing = 5 * 340.42 / 44100;
+  double mx[] = {spacing, 0.0, -spacing, 0.0};
+  double my[] = {0.0, spacing, 0.0, -spacing};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 1024;
+  settings.beamforming = true;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  ASSERT_TRUE(srp.is_beamforming());
+
+  // low pass noise from 180 degrees reaches the microphone at -x 5 samples
+  // early and the one at +x 5 samples late
+  int frames = 4;
+  int length = frames * 1024 + 16;
+  std::vector<double> noise(static_cast<size_t>(length) + 8);
+  srand(42);
+  for (double &sample : noise)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  std::vector<double> source(static_cast<size_t>(length), 0.0);
+  for (int n = 0; n < length; ++n) {
+    for (int i = 0; i < 8; ++i)
+      source[n] += noise[n + i];
+  }
+  int offsets[] = {-5, 0, 5, 0};
+  std::vector<double> interleaved(static_cast<size_t>(length) * 4, 0.0);
+  for (int n = 5; n < length - 5; ++n) {
+    for (int channel = 0; channel < 4; ++channel)
+      interleaved[n * 4 + channel] = source[n + offsets[channel]];
+  }
+
+  std::vector<double> stream;
+  for (int frame = 0; frame < frames; ++frame) {
+    taylortrack::utils::SignalView view(interleaved.data() + frame * 1024 * 4, 4, 4, 1025);
+    srp.calculate_position_and_distribution(view);
+    ASSERT_EQ(180, srp.get_last_position());
+    ASSERT_EQ(1024u, srp.get_beamformed_frame().size());
+    stream.insert(stream.end(), srp.get_beamformed_frame().begin(),
+                  srp.get_beamformed_frame().end());
+  }
+  // the aligned channels add up to the source, delayed by the latest microphone
+  for (int n = 16; n < frames * 1024; ++n)
+    ASSERT_NEAR(source[n - 5], stream[n], 1e-9);
+}
+
+TEST(SrpPhatTest, continueFromTest) {
+  // same setup as the beamforming test, a coarser instance takes over halfway
+  double spacing = 5 * 340.42 / 44100;
+  double mx[] = {spacing, 0.0, -spacing, 0.0};
+  double my[] = {0.0, spacing, 0.0, -spacing};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 1024;
+  settings.beamforming = true;
+  settings.tracking = true;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat fine;
+  fine.set_config(config);
+  settings.interval = 0.2;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat coarse;
+  coarse.set_config(config);
+
+  int frames = 4;
+  int length = frames * 1024 + 16;
+  std::vector<double> noise(static_cast<size_t>(length) + 8);
+  srand(42);
+  for (double &sample : noise)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  std::vector<double> source(static_cast<size_t>(length), 0.0);
+  for (int n = 0; n < length; ++n) {
+    for (int i = 0; i < 8; ++i)
+      source[n] += noise[n + i];
+  }
+  int offsets[] = {-5, 0, 5, 0};
+  std::vector<double> interleaved(static_cast<size_t>(length) * 4, 0.0);
+  for (int n = 5; n < length - 5; ++n) {
+    for (int channel = 0; channel < 4; ++channel)
+      interleaved[n * 4 + channel] = source[n + offsets[channel]];
+  }
+
+  std::vector<double> stream;
+  for (int frame = 0; frame < frames; ++frame) {
+    taylortrack::localization::SrpPhat &srp = frame < 2 ? fine : coarse;
+    if (frame == 2) {
+      coarse.continue_from(fine);
+      ASSERT_TRUE(coarse.get_tracker().is_initialized());
+      ASSERT_DOUBLE_EQ(fine.get_tracker().predict(), coarse.get_tracker().predict());
+      ASSERT_EQ(fine.get_last_position(), coarse.get_last_position());
+    }
+    taylortrack::utils::SignalView view(interleaved.data() + frame * 1024 * 4, 4, 4, 1025);
+    srp.calculate_position_and_distribution(view);
+    ASSERT_EQ(180, srp.get_last_position());
+    stream.insert(stream.end(), srp.get_beamformed_frame().begin(),
+                  srp.get_beamformed_frame().end());
+  }
+  // the overlap of the first instance is carried over, the stream has no gap
+  for (int n = 16; n < frames * 1024; ++n)
+    ASSERT_NEAR(source[n - 5], stream[n], 1e-9);
+}
+
+TEST(SrpPhatTest, heatmapTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 1024;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat reference;
+  reference.set_config(config);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  settings.heatmap_decimation = 2;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat decimated;
+  decimated.set_config(config);
+
+  std::vector<double> interleaved(4 * 1024);
+  srand(7);
+  for (double &sample : interleaved)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  taylortrack::utils::SignalView view(interleaved.data(), 4, 4, 1024);
+
+  // nothing is stored unless requested
+  srp.calculate_position_and_distribution(view);
+  ASSERT_FALSE(srp.is_heatmap_enabled());
+  ASSERT_TRUE(srp.get_last_heatmap().empty());
+
+  std::vector<std::vector<double>> grid =
+      reference.get_generalized_cross_correlation(view);
+  int size = static_cast<int>(grid.size());
+  srp.set_heatmap_enabled(true);
+  srp.calculate_position_and_distribution(view);
+  ASSERT_EQ(size, srp.get_heatmap_size());
+  ASSERT_EQ(static_cast<size_t>(size * size), srp.get_last_heatmap().size());
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y)
+      ASSERT_NEAR(grid[x][y], srp.get_last_heatmap()[x * size + y], 1e-5);
+  }
+
+  decimated.set_heatmap_enabled(true);
+  decimated.calculate_position_and_distribution(view);
+  int half = (size + 1) / 2;
+  ASSERT_EQ(half, decimated.get_heatmap_size());
+  const std::vector<float> &heatmap = decimated.get_last_heatmap();
+  ASSERT_EQ(static_cast<size_t>(half * half), heatmap.size());
+  double block = (grid[2][4] + grid[2][5] + grid[3][4] + grid[3][5]) / 4;
+  ASSERT_NEAR(block, heatmap[1 * half + 2], 1e-5);
+  // the last block only covers the remaining row
+  ASSERT_NEAR(grid[size - 1][size - 1], heatmap[half * half - 1], 1e-5);
+
+  srp.set_heatmap_enabled(false);
+  ASSERT_TRUE(srp.get_last_heatmap().empty());
+}
+
+TEST(SrpPhatTest, shardTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 1024;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat whole;
+  whole.set_config(config);
+
+  std::vector<double> interleaved(4 * 1025);
+  srand(5);
+  for (double &sample : interleaved)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  taylortrack::utils::SignalView view(interleaved.data(), 4, 4, 1025);
+  whole.calculate_position_and_distribution(view);
+
+  // three shards of the six pairs add up to the whole frame
+  taylortrack::utils::RArray sums(0.0, 360);
+  for (int shard = 0; shard < 3; ++shard) {
+    taylortrack::localization::SrpPhat worker;
+    worker.set_config(config);
+    worker.set_shard(shard, 3);
+    worker.calculate_position_and_distribution(view);
+    sums += worker.get_last_degree_values();
+  }
+  taylortrack::localization::SrpPhat coordinator;
+  coordinator.set_config(config);
+  coordinator.set_degree_values(sums);
+  ASSERT_EQ(whole.get_last_position(), coordinator.get_last_position());
+  for (int degree = 0; degree < 360; ++degree) {
+    ASSERT_NEAR(whole.get_last_degree_values()[degree], sums[degree], 1e-9);
+    ASSERT_NEAR(whole.get_last_distribution()[degree],
+                coordinator.get_last_distribution()[degree], 1e-12);
+  }
+
+  // with round robin, a worker that missed a frame still evaluates its share of the right pairs
+  settings.pair_selection = taylortrack::utils::PairSelectionPolicy::kRoundRobin;
+  settings.max_pairs = 4;
+  config.set_audio_settings(settings);
+  whole.set_config(config);
+  whole.calculate_position_and_distribution(view);
+  whole.calculate_position_and_distribution(view);
+  sums = 0.0;
+  for (int shard = 0; shard < 2; ++shard) {
+    taylortrack::localization::SrpPhat worker;
+    worker.set_config(config);
+    worker.set_shard(shard, 2);
+    // only the second shard saw the first frame
+    if (shard == 1) {
+      worker.set_frame_number(0);
+      worker.calculate_position_and_distribution(view);
+    }
+    worker.set_frame_number(1);
+    worker.calculate_position_and_distribution(view);
+    sums += worker.get_last_degree_values();
+  }
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(whole.get_last_degree_values()[degree], sums[degree], 1e-9);
+}
+
+TEST(SrpPhatTest, elevationTest) {
+  // ceiling array 2.5 m above the floor, speaker at 1 m height in front of it
+  double mx[] = {0.5, 0.0, -0.5, 0.0};
+  double my[] = {0.0, 0.5, 0.0, -0.5};
+  double mz[] = {2.5, 2.5, 2.5, 2.5};
+  double heights[] = {0.5, 1.0, 1.5, 2.0};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.mic_z = taylortrack::utils::RArray(mz, 4);
+  settings.grid_z = taylortrack::utils::RArray(heights, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+
+  double source[] = {1.5, 0.0, 1.0};
+  std::vector<int> delays(4);
+  for (int m = 0; m < 4; ++m) {
+    double distance = std::sqrt(std::pow(source[0] - mx[m], 2) +
+        std::pow(source[1] - my[m], 2) + std::pow(source[2] - mz[m], 2));
+    delays[m] = static_cast<int>(std::lround(distance / 340.42 * 44100));
+  }
+  int length = 2049;
+  std::vector<double> noise(static_cast<size_t>(length) + 600);
+  srand(21);
+  for (double &sample : noise)
+    sample = static_cast<double>(rand()) / RAND_MAX - 0.5;
+  std::vector<double> interleaved(static_cast<size_t>(length) * 4);
+  for (int n = 0; n < length; ++n) {
+    for (int m = 0; m < 4; ++m)
+      interleaved[n * 4 + m] = noise[n + 500 - delays[m]];
+  }
+  taylortrack::utils::SignalView view(interleaved.data(), 4, 4, length);
+  srp.calculate_position_and_distribution(view);
+  ASSERT_LE(std::abs(taylortrack::localization::angle_difference(
+      srp.get_last_position(), 0)), 3.0);
+  // atan2(1.0 - 2.5, 1.5) = -45 degrees
+  ASSERT_NEAR(-45, srp.get_last_elevation(), 6);
+
+  // planar setups keep an elevation of 0
+  taylortrack::localization::SrpPhat planar;
+  settings.mic_z = taylortrack::utils::RArray();
+  settings.grid_z = taylortrack::utils::RArray(0.0, 1);
+  config.set_audio_settings(settings);
+  planar.set_config(config);
+  planar.calculate_position_and_distribution(view);
+  ASSERT_EQ(0, planar.get_last_elevation());
+}
+
+TEST(SrpPhatTest, lagVectorTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat edge;
+  taylortrack::localization::SrpPhat host;
+  taylortrack::localization::SrpPhat direct;
+  edge.set_config(config);
+  host.set_config(config);
+  direct.set_config(config);
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(edge.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(edge.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(edge.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(edge.get_microphone_signal("../Testdata/270-180_short.txt"));
+  std::vector<double> interleaved(4 * 2049);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < 2049; ++i)
+      interleaved[i * 4 + channel] = signals[channel][i];
+  }
+  taylortrack::utils::SignalView frame(interleaved.data(), 4, 4, 2049);
+
+  // only the lags reachable from the grid are sent, far less than the frame
+  std::vector<double> lag_values = edge.get_lag_vectors(frame);
+  ASSERT_EQ(edge.get_lag_vector_size(), static_cast<int>(lag_values.size()));
+  ASSERT_LT(lag_values.size(), interleaved.size() / 20);
+
+  ASSERT_TRUE(host.calculate_from_lag_vectors(lag_values));
+  direct.calculate_position_and_distribution(frame);
+  ASSERT_EQ(direct.get_last_position(), host.get_last_position());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_NEAR(direct.get_last_distribution()[degree],
+                host.get_last_distribution()[degree], 1e-9);
+
+  lag_values.pop_back();
+  ASSERT_FALSE(host.calculate_from_lag_vectors(lag_values));
+}
+
+TEST(SrpPhatTest, spectralVadTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat full_srp;
+  full_srp.set_config(config);
+  settings.vad = taylortrack::utils::VadMode::kSpectral;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  ASSERT_TRUE(srp.is_spectral_vad());
+  ASSERT_FALSE(full_srp.is_spectral_vad());
+
+  std::vector<taylortrack::utils::RArray> signals;
+  signals.push_back(srp.get_microphone_signal("../Testdata/0-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/90-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/180-180_short.txt"));
+  signals.push_back(srp.get_microphone_signal("../Testdata/270-180_short.txt"));
+  std::vector<double> interleaved(4 * 2049);
+  std::vector<double> quiet(4 * 2049);
+  srand(11);
+  for (int channel = 0; channel < 4; ++channel) {
+    for (int i = 0; i < 2049; ++i) {
+      interleaved[i * 4 + channel] = signals[channel][i];
+      quiet[i * 4 + channel] = 0.0001 * (2.0 * rand() / RAND_MAX - 1.0);
+    }
+  }
+  taylortrack::utils::SignalView frame(interleaved.data(), 4, 4, 2049);
+  taylortrack::utils::SignalView quiet_frame(quiet.data(), 4, 4, 2049);
+
+  // silence is rejected before the grid is computed, the results stay untouched
+  for (int i = 0; i < 3; ++i) {
+    srp.calculate_position_and_distribution(quiet_frame);
+    ASSERT_FALSE(srp.get_last_voice());
+    ASSERT_EQ(0.0, srp.get_last_distribution().sum());
+  }
+
+  srp.calculate_position_and_distribution(frame);
+  full_srp.calculate_position_and_distribution(frame);
+  ASSERT_TRUE(srp.get_last_voice());
+  ASSERT_TRUE(full_srp.get_last_voice());
+  ASSERT_EQ(180, srp.get_last_position());
+  for (int degree = 0; degree < 360; ++degree)
+    ASSERT_EQ(full_srp.get_last_distribution()[degree],
+              srp.get_last_distribution()[degree]);
+}
+
+TEST(SrpPhatTest, microphoneSignalsTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  // subbands bring a worker pool the files are parsed on
+  settings.subbands = 4;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+
+  std::vector<std::string> files;
+  files.push_back("../Testdata/0-180_short.txt");
+  files.push_back("../Testdata/90-180_short.txt");
+  files.push_back("../Testdata/180-180_short.txt");
+  files.push_back("../Testdata/270-180_short.txt");
+  files.push_back("../Testdata/CertainlyNotExistingFile.txt");
+  std::vector<taylortrack::utils::RArray> signals = srp.get_microphone_signals(files);
+  ASSERT_EQ(5u, signals.size());
+  for (int i = 0; i < 4; ++i) {
+    taylortrack::utils::RArray single = srp.get_microphone_signal(files[i]);
+    ASSERT_GT(single.size(), 6000u);
+    ASSERT_EQ(single.size(), signals[i].size());
+    for (size_t j = 0; j < single.size(); ++j)
+      ASSERT_EQ(single[j], signals[i][j]);
+  }
+  ASSERT_EQ(0u, signals[4].size());
+  ASSERT_DOUBLE_EQ(0.010416, signals[0][0]);
+}
+
+TEST(SrpPhatTest, microphoneSignalsSingleBandTest) {
+  double mx[] = {0.055, 0.0, -0.055, 0.0};
+  double my[] = {0.0, 0.055, 0.0, -0.055};
+  taylortrack::utils::AudioSettings settings;
+  settings.mic_x = taylortrack::utils::RArray(mx, 4);
+  settings.mic_y = taylortrack::utils::RArray(my, 4);
+  settings.frame_size = 2048;
+  // without subbands the files are still parsed in parallel, on the engine or one thread per file
+  settings.subbands = 1;
+  taylortrack::utils::ConfigParser config;
+  config.set_audio_settings(settings);
+  taylortrack::localization::SrpPhat srp;
+  srp.set_config(config);
+  taylortrack::localization::SrpPhat engine_srp;
+  engine_srp.set_engine(std::make_shared<taylortrack::localization::SrpEngine>(2));
+  engine_srp.set_config(config);
+
+  std::vector<std::string> files;
+  files.push_back("../Testdata/0-180_short.txt");
+  files.push_back("../Testdata/90-180_short.txt");
+  files.push_back("../Testdata/CertainlyNotExistingFile.txt");
+  files.push_back("../Testdata/270-180_short.txt");
+  std::vector<taylortrack::utils::RArray> signals = srp.get_microphone_signals(files);
+  std::vector<taylortrack::utils::RArray> engine_signals = engine_srp.get_microphone_signals(files);
+  ASSERT_EQ(4u, signals.size());
+  ASSERT_EQ(4u, engine_signals.size());
+  for (int i = 0; i < 4; ++i) {
+    taylortrack::utils::RArray single = srp.get_microphone_signal(files[i]);
+    ASSERT_EQ(single.size(), signals[i].size());
+    ASSERT_EQ(single.size(), engine_signals[i].size());
+    for (size_t j = 0; j < single.size(); ++j) {
+      ASSERT_EQ(single[j], signals[i][j]);
+      ASSERT_EQ(single[j], engine_signals[i][j]);
+    }
+  }
+  ASSERT_EQ(0u, signals[2].size());
+  ASSERT_GT(signals[3].size(), 6000u);
+  ASSERT_TRUE(srp.get_microphone_signals(std::vector<std::string>()).empty());
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "utils/clock_drift_estimator.h"
+#include "utils/stream_aligner.h"
+
+namespace {
+// records a slow sine wave like a device whose clock runs at the given rate and starts at the given time
+class SimulatedDevice {
+ public:
+  SimulatedDevice(double rate, double start, double jitter)
+      : rate_(rate), start_(start), jitter_(jitter), ring_(1, 16384) {}
+
+  // records the next period, returns its stamp
+  taylortrack::utils::CaptureStamp record(int period) {
+    std::vector<float> samples(period);
+    for (int i = 0; i < period; ++i)
+      samples[i] = static_cast<float>(signal(start_ + (recorded_ + i) / rate_));
+    const float *channels[] = {samples.data()};
+    taylortrack::utils::CaptureStamp stamp;
+    stamp.position = static_cast<double>(ring_.get_write_position());
+    stamp.time = start_ + recorded_ / rate_ + jitter_ * (2.0 * rand() / RAND_MAX - 1.0);
+    EXPECT_TRUE(ring_.write(channels, period));
+    recorded_ += period;
+    return stamp;
+  }
+
+  static double signal(double time) {
+    return std::sin(2.0 * M_PI * 5.0 * time);
+  }
+
+  taylortrack::utils::SampleRing *ring() {
+    return &ring_;
+  }
+
+ private:
+  double rate_;
+  double start_;
+  double jitter_;
+  taylortrack::utils::SampleRing ring_;
+  int64_t recorded_ = 0;
+};
+}  // namespace
+
+TEST(ClockDriftEstimatorTest, EstimatesRateAndTimes) {
+  taylortrack::utils::ClockDriftEstimator estimator(44100.0);
+  ASSERT_FALSE(estimator.has_stamps());
+  ASSERT_DOUBLE_EQ(44100.0, estimator.get_rate());
+
+  // a clock 80 ppm fast, stamps of 256 samples with 100 microseconds jitter
+  double rate = 44100.0 * 1.00008;
+  srand(5);
+  for (int period = 0; period < 172 * 120; ++period) {
+    double position = 256.0 * period;
+    estimator.add_stamp(position, 3.0 + position / rate + 0.0001 * (2.0 * rand() / RAND_MAX - 1.0));
+  }
+  ASSERT_TRUE(estimator.has_stamps());
+  ASSERT_NEAR(rate, estimator.get_rate(), 44100.0 * 2e-6);
+  ASSERT_NEAR(3.0 + 1000000 / rate, estimator.get_time(1000000), 0.00002);
+  ASSERT_NEAR(1000000, estimator.get_position(3.0 + 1000000 / rate), 1.0);
+
+  // after a reset earlier positions are ignored
+  estimator.reset(1000.0);
+  estimator.add_stamp(500.0, 1.0);
+  ASSERT_FALSE(estimator.has_stamps());
+  estimator.add_stamp(1000.0, 2.0);
+  ASSERT_TRUE(estimator.has_stamps());
+  ASSERT_DOUBLE_EQ(44100.0, estimator.get_rate());
+  ASSERT_DOUBLE_EQ(2.0, estimator.get_time(1000.0));
+}
+
+TEST(StreamAlignerTest, AppliesDelays) {
+  // identical clocks, the second device is delayed by 3 samples
+  SimulatedDevice first(44100.0, 1.0, 0.0);
+  SimulatedDevice second(44100.0, 1.0, 0.0);
+  taylortrack::utils::StreamAligner aligner({1, 1}, {0, 3}, 44100.0);
+  ASSERT_EQ(2, aligner.get_channels());
+  std::vector<taylortrack::utils::SampleRing *> rings = {first.ring(), second.ring()};
+
+  std::vector<double> frame(2 * 512);
+  ASSERT_FALSE(aligner.read_frame(rings, 512, frame.data()));
+  for (int period = 0; period < 8; ++period) {
+    aligner.add_stamp(0, first.record(256));
+    aligner.add_stamp(1, second.record(256));
+  }
+  ASSERT_TRUE(aligner.read_frame(rings, 512, frame.data()));
+  ASSERT_TRUE(aligner.is_started());
+  // the first device waits for the delayed one
+  for (int i = 0; i < 512; ++i) {
+    ASSERT_NEAR(SimulatedDevice::signal(1.0 + (i + 3) / 44100.0), frame[2 * i], 1e-6);
+    ASSERT_NEAR(SimulatedDevice::signal(1.0 + i / 44100.0), frame[2 * i + 1], 1e-6);
+  }
+  ASSERT_DOUBLE_EQ(0.0, aligner.get_drift(1));
+}
+
+TEST(StreamAlignerTest, CompensatesOffsetAndDrift) {
+  // the second device starts 12.3 ms later and runs 60 ppm faster, stamps jitter by 50 microseconds
+  srand(7);
+  SimulatedDevice first(44100.0, 1.0, 0.00005);
+  SimulatedDevice second(44100.0 * 1.00006, 1.0123, 0.00005);
+  taylortrack::utils::StreamAligner aligner({1, 1}, {0, 0}, 44100.0);
+  std::vector<taylortrack::utils::SampleRing *> rings = {first.ring(), second.ring()};
+
+  // 5 minutes of 256 sample periods and 1024 sample frames
+  std::vector<double> frame(2 * 1024);
+  double worst_offset = 0.0;
+  int frames = 0;
+  for (int period = 0; period < 172 * 300; ++period) {
+    aligner.add_stamp(0, first.record(256));
+    aligner.add_stamp(1, second.record(256));
+    while (aligner.read_frame(rings, 1024, frame.data())) {
+      ++frames;
+      if (frames < 172 * 30 / 4)
+        continue;
+      // after half a minute both devices hold the same samples, one sample of offset is 7e-4
+      for (int i = 0; i < 1024; ++i)
+        worst_offset = std::max(worst_offset, std::fabs(frame[2 * i] - frame[2 * i + 1]));
+    }
+  }
+  ASSERT_GT(frames, 172 * 290 / 4);
+  ASSERT_LT(worst_offset, 0.0002);
+  ASSERT_NEAR(60.0, aligner.get_drift(1), 5.0);
+}
+
+TEST(StreamAlignerTest, RestartDiscardsSamples) {
+  SimulatedDevice first(44100.0, 1.0, 0.0);
+  SimulatedDevice second(44100.0, 1.0, 0.0);
+  taylortrack::utils::StreamAligner aligner({1, 1}, {}, 44100.0);
+  std::vector<taylortrack::utils::SampleRing *> rings = {first.ring(), second.ring()};
+  for (int period = 0; period < 4; ++period) {
+    aligner.add_stamp(0, first.record(256));
+    aligner.add_stamp(1, second.record(256));
+  }
+  std::vector<double> frame(2 * 256);
+  ASSERT_TRUE(aligner.read_frame(rings, 256, frame.data()));
+
+  aligner.restart(rings);
+  ASSERT_FALSE(aligner.is_started());
+  ASSERT_EQ(0u, first.ring()->get_available());
+  ASSERT_FALSE(aligner.read_frame(rings, 256, frame.data()));
+  aligner.add_stamp(0, first.record(256));
+  aligner.add_stamp(1, second.record(256));
+  aligner.add_stamp(0, first.record(256));
+  aligner.add_stamp(1, second.record(256));
+  ASSERT_TRUE(aligner.read_frame(rings, 256, frame.data()));
+  ASSERT_EQ(frame[0], frame[1]);
+}
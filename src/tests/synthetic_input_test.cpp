@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "input/synthetic_input_strategy.h"
+#include "sim/frame_protocol.h"
+#include "utils/parameters.h"
+
+namespace {
+void configure(taylortrack::utils::ConfigParser *config, const std::string &ground_truth) {
+  taylortrack::utils::AudioSettings audio;
+  audio.sample_rate = 16000;
+  audio.mic_x = {0.0, 0.0, -0.055, 0.055};
+  audio.mic_y = {0.055, -0.055, 0.0, 0.0};
+  config->set_audio_settings(audio);
+
+  taylortrack::utils::SyntheticInputSettings settings;
+  settings.frame_size = 1024;
+  settings.speed = 0.0;
+  settings.duration = 0.2;
+  taylortrack::utils::SyntheticSource source;
+  source.x = 0.0;
+  source.y = 1.0;
+  settings.sources.push_back(source);
+  settings.ground_truth = ground_truth;
+  config->set_synthetic_input_settings(settings);
+}
+}  // namespace
+
+TEST(SyntheticInputTest, StreamsConfiguredDuration) {
+  taylortrack::utils::Parameters parameter;
+  taylortrack::utils::ConfigParser config;
+  configure(&config, "synthetic_ground_truth.txt");
+
+  taylortrack::input::SyntheticInputStrategy input;
+  input.set_parameters(parameter);
+  input.set_config(config);
+  ASSERT_TRUE(input.is_paced());
+
+  // 3200 frames take four reads of 1024
+  int reads = 0;
+  while (!input.is_done()) {
+    yarp::os::Bottle bottle;
+    input.read(&bottle);
+    ASSERT_EQ(1024 * 4, bottle.size());
+    ++reads;
+  }
+  ASSERT_EQ(4, reads);
+
+  // configuring again closes the ground truth file
+  configure(&config, "");
+  input.set_config(config);
+  std::ifstream ground_truth("synthetic_ground_truth.txt");
+  int lines = 0;
+  int64_t frame = 0;
+  double time = 0.0;
+  double x = 0.0;
+  double y = 0.0;
+  double degree = 0.0;
+  while (ground_truth >> frame >> time >> x >> y >> degree) {
+    ASSERT_EQ(lines * 1024 + 512, frame);
+    ASSERT_DOUBLE_EQ(frame / 16000.0, time);
+    ASSERT_DOUBLE_EQ(1.0, y);
+    ASSERT_DOUBLE_EQ(90.0, degree);
+    ++lines;
+  }
+  ASSERT_EQ(4, lines);
+  std::remove("synthetic_ground_truth.txt");
+}
+
+TEST(SyntheticInputTest, NeverSetConfig) {
+  taylortrack::input::SyntheticInputStrategy input;
+
+  ASSERT_TRUE(input.is_done());
+  yarp::os::Bottle bottle;
+  input.read(&bottle);
+  ASSERT_EQ(0, bottle.size());
+}
+
+TEST(SyntheticInputTest, PackedTransport) {
+  taylortrack::utils::Parameters parameter;
+  taylortrack::utils::ConfigParser config;
+  configure(&config, "");
+  taylortrack::utils::InputSettings input_settings;
+  input_settings.transport = taylortrack::utils::SampleTransport::kFloat32;
+  config.set_input_settings(input_settings);
+
+  taylortrack::input::SyntheticInputStrategy input;
+  input.set_parameters(parameter);
+  input.set_config(config);
+  yarp::os::Bottle bottle;
+  input.read(&bottle);
+
+  int channels = 0;
+  std::vector<double> samples;
+  ASSERT_TRUE(taylortrack::sim::read_packed_frame(bottle, &channels, &samples));
+  ASSERT_EQ(4, channels);
+  ASSERT_EQ(1024u * 4, samples.size());
+}
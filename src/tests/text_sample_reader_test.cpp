@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "utils/text_sample_reader.h"
+
+TEST(TextSampleReaderTest, WholeFile) {
+  taylortrack::utils::TextSampleReader reader("../Testdata/0-180_short.txt");
+  ASSERT_TRUE(reader.is_valid());
+  ASSERT_EQ(6148, reader.get_line_count());
+
+  std::vector<double> samples(reader.get_line_count());
+  int64_t count = reader.read_samples(samples.data(), static_cast<int64_t>(samples.size()));
+  ASSERT_EQ(6148, count);
+  ASSERT_TRUE(reader.is_done());
+  ASSERT_DOUBLE_EQ(0.010416, samples[0]);
+  ASSERT_DOUBLE_EQ(0.01031, samples[1]);
+  ASSERT_DOUBLE_EQ(8.5651e-05, samples[23]);
+  ASSERT_DOUBLE_EQ(-0.0006489, samples[26]);
+}
+
+TEST(TextSampleReaderTest, Chunks) {
+  taylortrack::utils::TextSampleReader whole("../Testdata/90-180_short.txt");
+  std::vector<double> expected(whole.get_line_count());
+  expected.resize(whole.read_samples(expected.data(), static_cast<int64_t>(expected.size())));
+
+  // chunks continue where the previous one stopped
+  taylortrack::utils::TextSampleReader reader("../Testdata/90-180_short.txt");
+  std::vector<double> samples;
+  double chunk[1000];
+  while (!reader.is_done()) {
+    int64_t count = reader.read_samples(chunk, 1000);
+    samples.insert(samples.end(), chunk, chunk + count);
+  }
+  ASSERT_EQ(expected, samples);
+}
+
+TEST(TextSampleReaderTest, StopsAtText) {
+  // Test.txt starts with words instead of numbers
+  taylortrack::utils::TextSampleReader reader("../Testdata/Test.txt");
+  ASSERT_TRUE(reader.is_valid());
+  double sample = 0.0;
+  ASSERT_EQ(0, reader.read_samples(&sample, 1));
+  ASSERT_TRUE(reader.is_done());
+}
+
+TEST(TextSampleReaderTest, NonExistingFile) {
+  taylortrack::utils::TextSampleReader reader("../Testdata/CertainlyNotExistingFile.txt");
+  ASSERT_FALSE(reader.is_valid());
+  ASSERT_EQ(0, reader.get_line_count());
+  double sample = 0.0;
+  ASSERT_EQ(0, reader.read_samples(&sample, 1));
+  ASSERT_TRUE(reader.is_done());
+}
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/thread_pool.h"
+
+TEST(ThreadPoolTest, ParallelForTest) {
+  taylortrack::utils::ThreadPool pool(4);
+  ASSERT_EQ(4, pool.get_thread_count());
+  std::vector<int> results(100, 0);
+  pool.parallel_for(100, [&](int task) {
+    results[task] = task * task;
+  });
+  for (int i = 0; i < 100; ++i)
+    ASSERT_EQ(i * i, results[i]);
+}
+
+TEST(ThreadPoolTest, RepeatedLoopsTest) {
+  taylortrack::utils::ThreadPool pool(3);
+  std::atomic<int> counter(0);
+  for (int loop = 0; loop < 50; ++loop) {
+    pool.parallel_for(7, [&](int) {
+      ++counter;
+    });
+    ASSERT_EQ((loop + 1) * 7, counter.load());
+  }
+}
+
+TEST(ThreadPoolTest, SingleThreadTest) {
+  // without workers everything runs on the calling thread
+  taylortrack::utils::ThreadPool pool(0);
+  ASSERT_EQ(1, pool.get_thread_count());
+  int sum = 0;
+  pool.parallel_for(10, [&](int task) {
+    sum += task;
+  });
+  ASSERT_EQ(45, sum);
+}
+
+TEST(ThreadPoolTest, ConcurrentLoopsTest) {
+  // loops of several callers share the workers without mixing up their tasks
+  taylortrack::utils::ThreadPool pool(3);
+  std::vector<std::vector<int>> results(4, std::vector<int>(200, 0));
+  std::vector<std::thread> callers;
+  for (int caller = 0; caller < 4; ++caller) {
+    callers.emplace_back([&pool, &results, caller]() {
+      for (int loop = 0; loop < 20; ++loop) {
+        pool.parallel_for(10, [&](int task) {
+          results[caller][loop * 10 + task] += caller + 1;
+        });
+      }
+    });
+  }
+  for (std::thread &caller : callers)
+    caller.join();
+  for (int caller = 0; caller < 4; ++caller) {
+    for (int value : results[caller])
+      ASSERT_EQ(caller + 1, value);
+  }
+}
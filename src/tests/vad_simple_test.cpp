@@ -29,3 +29,25 @@ TEST(VadSimpleTest, SimpleDetectionTestError) {
   taylortrack::utils::RArray data(sample_data, 1);
   ASSERT_FALSE(TestVad.detect(data));
 }
+
+TEST(VadSimpleTest, SignalViewDetection) {
+  taylortrack::utils::VadSimple TestVad = taylortrack::utils::VadSimple(0.25);
+  // two interleaved channels, only the first one is considered
+  double sample_data[] = {0.0, 5.0, 0.0, 5.0, 1.0, 5.0, 0.0, 5.0};
+  taylortrack::utils::SignalView frame(sample_data, 2, 2, 4);
+  ASSERT_TRUE(TestVad.detect(frame));
+
+  TestVad.set_threshold(0.5);
+  ASSERT_FALSE(TestVad.detect(frame));
+}
+
+TEST(VadSimpleTest, Pcm16Detection) {
+  taylortrack::utils::VadSimple TestVad = taylortrack::utils::VadSimple(0.25);
+  // the 16 bit frame of the signal view test, full scale stands for 1
+  int16_t sample_data[] = {0, 32767, 0, 32767, 32767, 32767, 0, 32767};
+  taylortrack::utils::Pcm16View frame(sample_data, 2, 2, 4);
+  ASSERT_TRUE(TestVad.detect(frame));
+
+  TestVad.set_threshold(0.26);
+  ASSERT_FALSE(TestVad.detect(frame));
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "utils/fft_plan.h"
+#include "utils/vad_spectral.h"
+
+namespace {
+const double kPI = 3.141592653589793238460;
+
+// white noise of the given amplitude, optionally with a voiced sound on top
+taylortrack::utils::RArray make_frame(double noise, double voiced, double fundamental) {
+  taylortrack::utils::RArray frame(2048);
+  for (size_t n = 0; n < frame.size(); ++n) {
+    frame[n] = noise * (2.0 * rand() / RAND_MAX - 1.0);
+    // harmonics with falling amplitudes like a vowel
+    for (int harmonic = 1; harmonic * fundamental < 4000.0; ++harmonic)
+      frame[n] += voiced / harmonic * sin(2 * kPI * harmonic * fundamental * n / 44100);
+  }
+  return frame;
+}
+}  // namespace
+
+TEST(VadSpectralTest, NoiseFloorTest) {
+  srand(3);
+  taylortrack::utils::VadSpectral vad(0.0000007, 44100);
+  // the first frame only initializes the noise floor
+  ASSERT_FALSE(vad.detect(make_frame(0.01, 0.0, 200.0)));
+  ASSERT_GT(vad.get_noise_floor(), 0.0);
+  for (int frame = 0; frame < 10; ++frame)
+    ASSERT_FALSE(vad.detect(make_frame(0.01, 0.0, 200.0)));
+  ASSERT_TRUE(vad.detect(make_frame(0.01, 0.1, 200.0)));
+  ASSERT_TRUE(vad.detect(make_frame(0.01, 0.1, 140.0)));
+  ASSERT_FALSE(vad.detect(make_frame(0.01, 0.0, 200.0)));
+
+  vad.reset();
+  ASSERT_LT(vad.get_noise_floor(), 0.0);
+  ASSERT_FALSE(vad.detect(make_frame(0.01, 0.1, 200.0)));
+}
+
+TEST(VadSpectralTest, SpectralShapeTest) {
+  srand(5);
+  taylortrack::utils::VadSpectral vad(0.0000007, 44100);
+  for (int frame = 0; frame < 5; ++frame)
+    vad.detect(make_frame(0.001, 0.0, 200.0));
+  // loud noise is flat across the speech band
+  ASSERT_FALSE(vad.detect(make_frame(0.3, 0.0, 200.0)));
+  // a loud hum below the speech band
+  taylortrack::utils::RArray hum(2048);
+  for (size_t n = 0; n < hum.size(); ++n)
+    hum[n] = 0.5 * sin(2 * kPI * 50.0 * n / 44100);
+  ASSERT_FALSE(vad.detect(hum));
+  // voiced sounds below the mean power threshold
+  vad.set_threshold(1.0);
+  ASSERT_FALSE(vad.detect(make_frame(0.001, 0.1, 200.0)));
+  vad.set_threshold(0.0000007);
+  ASSERT_TRUE(vad.detect(make_frame(0.001, 0.1, 200.0)));
+}
+
+TEST(VadSpectralTest, SpectrumTest) {
+  srand(7);
+  taylortrack::utils::VadSpectral samples_vad(0.0000007, 44100);
+  taylortrack::utils::VadSpectral spectrum_vad(0.0000007, 44100);
+  taylortrack::utils::FftPlan plan(2048);
+  for (int frame = 0; frame < 8; ++frame) {
+    taylortrack::utils::RArray samples = make_frame(0.01, frame % 2 ? 0.1 : 0.0, 200.0);
+    taylortrack::utils::CArray spectrum(2048);
+    for (size_t n = 0; n < samples.size(); ++n)
+      spectrum[n] = samples[n];
+    plan.fft(spectrum);
+    ASSERT_EQ(samples_vad.detect(samples), spectrum_vad.detect_spectrum(spectrum, 2048));
+    ASSERT_NEAR(samples_vad.get_noise_floor(), spectrum_vad.get_noise_floor(),
+                samples_vad.get_noise_floor() * 1e-9);
+  }
+}
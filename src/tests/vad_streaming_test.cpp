@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "utils/vad_streaming.h"
+
+namespace {
+// interleaved block holding a constant level per channel, its mean power is the squared level
+std::vector<double> make_block(const std::vector<double> &levels, int length) {
+  std::vector<double> block;
+  for (int n = 0; n < length; ++n)
+    block.insert(block.end(), levels.begin(), levels.end());
+  return block;
+}
+
+bool feed(taylortrack::utils::VadStreaming *vad, const std::vector<double> &levels) {
+  std::vector<double> block = make_block(levels, 64);
+  int channels = static_cast<int>(levels.size());
+  return vad->process_block(taylortrack::utils::SignalView(block.data(), channels, channels, 64));
+}
+}  // namespace
+
+TEST(VadStreamingTest, HangoverTest) {
+  taylortrack::utils::VadStreaming vad(0.0, 64, 3);
+  std::vector<double> quiet(4, 0.01);
+  std::vector<double> loud(4, 0.1);
+  // the first block only initializes the noise floors
+  ASSERT_FALSE(feed(&vad, loud));
+  ASSERT_EQ(4u, vad.get_noise_floors().size());
+  ASSERT_FALSE(feed(&vad, quiet));
+  ASSERT_NEAR(0.0001, vad.get_noise_floors()[0], 1e-12);
+  for (int block = 0; block < 10; ++block)
+    ASSERT_FALSE(feed(&vad, quiet));
+  ASSERT_TRUE(feed(&vad, loud));
+  // speech is held for the hangover blocks
+  for (int block = 0; block < 3; ++block) {
+    ASSERT_TRUE(feed(&vad, quiet));
+    ASSERT_TRUE(vad.is_active());
+  }
+  ASSERT_FALSE(feed(&vad, quiet));
+  ASSERT_FALSE(vad.is_active());
+
+  vad.reset();
+  ASSERT_TRUE(vad.get_noise_floors().empty());
+  ASSERT_FALSE(feed(&vad, loud));
+}
+
+TEST(VadStreamingTest, HysteresisTest) {
+  taylortrack::utils::VadStreaming vad(0.0, 64, 0);
+  std::vector<double> quiet(2, 0.01);
+  // three times the power of the floor, between release and onset ratio
+  std::vector<double> medium(2, 0.01 * std::sqrt(3.0));
+  std::vector<double> loud(2, 0.1);
+  feed(&vad, quiet);
+  ASSERT_FALSE(feed(&vad, medium));
+  feed(&vad, quiet);
+  feed(&vad, quiet);
+  ASSERT_TRUE(feed(&vad, loud));
+  ASSERT_TRUE(feed(&vad, medium));
+  ASSERT_TRUE(feed(&vad, medium));
+  ASSERT_FALSE(feed(&vad, quiet));
+}
+
+TEST(VadStreamingTest, ChannelFloorTest) {
+  taylortrack::utils::VadStreaming vad(0.0, 64, 0);
+  // a noisy microphone does not trigger on its own, every channel has its floor
+  std::vector<double> background = {0.2, 0.01, 0.01};
+  std::vector<double> speech = {0.25, 0.05, 0.05};
+  for (int block = 0; block < 5; ++block)
+    ASSERT_FALSE(feed(&vad, background));
+  ASSERT_NEAR(0.04, vad.get_noise_floors()[0], 1e-12);
+  ASSERT_NEAR(0.0001, vad.get_noise_floors()[2], 1e-12);
+  ASSERT_TRUE(feed(&vad, speech));
+}
+
+TEST(VadStreamingTest, ThresholdTest) {
+  taylortrack::utils::VadStreaming vad(0.001, 64, 0);
+  feed(&vad, std::vector<double>(4, 0.0001));
+  // far above the floor, but below the minimum power
+  ASSERT_FALSE(feed(&vad, std::vector<double>(4, 0.01)));
+  ASSERT_TRUE(feed(&vad, std::vector<double>(4, 0.1)));
+}
+
+TEST(VadStreamingTest, FrameTest) {
+  taylortrack::utils::VadStreaming frame_vad(0.0, 256, 0);
+  taylortrack::utils::VadStreaming block_vad(0.0, 256, 0);
+  // 2048 samples of 4 channels, speech starts in the last block
+  std::vector<double> frame;
+  for (int n = 0; n < 2048; ++n) {
+    for (int channel = 0; channel < 4; ++channel)
+      frame.push_back(n < 1792 ? 0.01 * (n % 2 ? 1 : -1) : 0.2 * (n % 2 ? 1 : -1));
+  }
+  ASSERT_TRUE(frame_vad.detect(taylortrack::utils::SignalView(frame.data(), 4, 4, 2048)));
+  bool voice = false;
+  for (int block = 0; block < 8; ++block)
+    voice = block_vad.process_block(
+        taylortrack::utils::SignalView(&frame[block * 256 * 4], 4, 4, 256)) || voice;
+  ASSERT_TRUE(voice);
+  for (size_t channel = 0; channel < 4; ++channel)
+    ASSERT_EQ(block_vad.get_noise_floors()[channel], frame_vad.get_noise_floors()[channel]);
+
+  // single channel frames work on the same blocks
+  taylortrack::utils::VadStreaming mono_vad(0.0, 256, 0);
+  taylortrack::utils::RArray mono(2048);
+  for (int n = 0; n < 2048; ++n)
+    mono[n] = frame[n * 4];
+  ASSERT_TRUE(mono_vad.detect(mono));
+}
+
+TEST(VadStreamingTest, Pcm16Test) {
+  taylortrack::utils::VadStreaming double_vad(0.0, 256, 2);
+  taylortrack::utils::VadStreaming pcm_vad(0.0, 256, 2);
+  // the same quantized stream as doubles and as 16 bit samples decides alike
+  std::vector<int16_t> pcm;
+  std::vector<double> samples;
+  for (int n = 0; n < 2048; ++n) {
+    for (int channel = 0; channel < 2; ++channel) {
+      int16_t value = static_cast<int16_t>((n >= 1024 && n < 1280 ? 6000 : 300) * (n % 2 ? 1 : -1));
+      pcm.push_back(value);
+      samples.push_back(value / 32767.0);
+    }
+  }
+  int active_blocks = 0;
+  for (int block = 0; block < 8; ++block) {
+    bool voice = pcm_vad.process_block(
+        taylortrack::utils::Pcm16View(&pcm[block * 256 * 2], 2, 2, 256));
+    ASSERT_EQ(double_vad.process_block(
+        taylortrack::utils::SignalView(&samples[block * 256 * 2], 2, 2, 256)), voice);
+    active_blocks += voice ? 1 : 0;
+  }
+  // the loud block and its hangover
+  ASSERT_EQ(3, active_blocks);
+  for (size_t channel = 0; channel < 2; ++channel)
+    ASSERT_NEAR(double_vad.get_noise_floors()[channel], pcm_vad.get_noise_floors()[channel], 1e-15);
+}
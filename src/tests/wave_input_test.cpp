@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <chrono>
 #include "utils/parameters.h"
 #include "input/wave_input_strategy.h"
 
@@ -115,7 +116,7 @@ TEST(WaveInputTest, 32BitPerSample) {
   taylortrack::utils::Parameters parameter;
 
   parameter.file = "../Testdata/Test32bit.wav";
-  // Read two samples at a time
+  // Read all samples at once
   parameter.size = 0;
 
   taylortrack::input::WaveInputStrategy input;
@@ -123,11 +124,89 @@ TEST(WaveInputTest, 32BitPerSample) {
 
   ASSERT_FALSE(input.is_done());
 
-  // read first two samples
   yarp::os::Bottle bottle;
   input.read(&bottle);
 
-  ASSERT_EQ(0, bottle.size());
+  // the samples of Test.wav shifted into the upper 16 bits
+  ASSERT_EQ(90561, bottle.size());
+  ASSERT_FLOAT_EQ(-37 * 65536 / 2147483647.0, bottle.get(0).asDouble());
+  ASSERT_FLOAT_EQ(-21 * 65536 / 2147483647.0, bottle.get(1).asDouble());
+  ASSERT_FLOAT_EQ(93 * 65536 / 2147483647.0, bottle.get(90560).asDouble());
 
   ASSERT_TRUE(input.is_done());
-}
\ No newline at end of file
+}
+
+TEST(WaveInputTest, FloatSamples) {
+  taylortrack::utils::Parameters parameter;
+
+  parameter.file = "../Testdata/Testfloat.wav";
+  parameter.size = 2;
+
+  taylortrack::input::WaveInputStrategy input;
+  input.set_parameters(parameter);
+
+  yarp::os::Bottle bottle;
+  input.read(&bottle);
+
+  // the same values as the 16 bit samples of Test.wav
+  ASSERT_EQ(2, bottle.size());
+  ASSERT_FLOAT_EQ(-0.0011291848, bottle.get(0).asDouble());
+  ASSERT_FLOAT_EQ(-0.0006408887, bottle.get(1).asDouble());
+  ASSERT_FALSE(input.is_done());
+}
+
+TEST(WaveInputTest, ConfiguredFrames) {
+  taylortrack::utils::Parameters parameter;
+  parameter.file = "../Testdata/Test.wav";
+
+  taylortrack::utils::WaveInputSettings settings;
+  settings.frame_size = 2049;
+  settings.speed = 0.0;
+  taylortrack::utils::ConfigParser config;
+  config.set_wave_input_settings(settings);
+
+  taylortrack::input::WaveInputStrategy input;
+  input.set_parameters(parameter);
+  input.set_config(config);
+  ASSERT_FALSE(input.is_paced());
+
+  // 90561 samples make 44 full frames and a last one filled with silence
+  int messages = 0;
+  yarp::os::Bottle bottle;
+  while (!input.is_done()) {
+    bottle.clear();
+    input.read(&bottle);
+    ASSERT_EQ(2049, bottle.size());
+    ++messages;
+  }
+  ASSERT_EQ(45, messages);
+  ASSERT_FLOAT_EQ(0.0028382214, bottle.get(90560 - 44 * 2049).asDouble());
+  ASSERT_EQ(0.0, bottle.get(2048).asDouble());
+}
+
+TEST(WaveInputTest, PacedBySampleRate) {
+  taylortrack::utils::Parameters parameter;
+  parameter.file = "../Testdata/Test.wav";
+
+  // 50 ms frames replayed ten times as fast
+  taylortrack::utils::WaveInputSettings settings;
+  settings.frame_size = 2205;
+  settings.speed = 10.0;
+  taylortrack::utils::ConfigParser config;
+  config.set_wave_input_settings(settings);
+
+  taylortrack::input::WaveInputStrategy input;
+  input.set_parameters(parameter);
+  input.set_config(config);
+  ASSERT_TRUE(input.is_paced());
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 4; ++i) {
+    yarp::os::Bottle bottle;
+    input.read(&bottle);
+    ASSERT_EQ(2205, bottle.size());
+  }
+  std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_GE(elapsed, std::chrono::milliseconds(20));
+  ASSERT_LT(elapsed, std::chrono::milliseconds(2000));
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <vector>
 #include "utils/wave_parser.h"
 
 TEST(WaveParserTest, ValidExample) {
@@ -51,3 +52,92 @@ TEST(WaveParserTest, NonExistingFile) {
   taylortrack::utils::WaveParser parser("../Testdata/CertainlyNotExistingFile.wav");
   ASSERT_FALSE(parser.is_valid());
 }
+
+TEST(WaveParserTest, FrameViews) {
+  taylortrack::utils::WaveParser parser("../Testdata/Test.wav");
+  ASSERT_TRUE(parser.is_valid());
+
+  // the same samples get_samples() returns, read in place
+  taylortrack::utils::Pcm16View frames = parser.get_frames(2);
+  ASSERT_EQ(1, frames.channels);
+  ASSERT_EQ(2, frames.length);
+  ASSERT_EQ(-37, frames.at(0, 0));
+  ASSERT_EQ(-21, frames.at(0, 1));
+
+  // both ways of reading continue where the other one stopped
+  std::string samples = parser.get_samples(1);
+  ASSERT_EQ(2u, samples.size());
+  taylortrack::utils::Pcm16View rest = parser.get_frames(parser.get_sample_num());
+  ASSERT_EQ(parser.get_sample_num() - 3, rest.length);
+  ASSERT_EQ(frames.data + 3, rest.data);
+  ASSERT_TRUE(parser.is_done());
+  ASSERT_EQ(0, parser.get_frames(2).length);
+}
+
+TEST(WaveParserTest, FrameViewsOnlyFor16Bit) {
+  taylortrack::utils::WaveParser parser("../Testdata/Test32bit.wav");
+  ASSERT_TRUE(parser.is_valid());
+  ASSERT_EQ(32, parser.get_bits_per_sample());
+  ASSERT_EQ(0, parser.get_frames(2).length);
+}
+
+TEST(WaveParserTest, DecodedFrames) {
+  taylortrack::utils::WaveParser parser("../Testdata/Test.wav");
+  ASSERT_TRUE(parser.is_decodable());
+
+  std::vector<double> samples;
+  ASSERT_EQ(2, parser.get_decoded_frames(2, &samples));
+  ASSERT_EQ(2u, samples.size());
+  ASSERT_FLOAT_EQ(-0.0011291848, samples[0]);
+  ASSERT_FLOAT_EQ(-0.0006408887, samples[1]);
+  ASSERT_EQ(parser.get_sample_num() - 2, parser.get_decoded_frames(parser.get_sample_num(), &samples));
+  ASSERT_TRUE(parser.is_done());
+  ASSERT_EQ(0, parser.get_decoded_frames(2, &samples));
+  ASSERT_TRUE(samples.empty());
+}
+
+TEST(WaveParserTest, Decoded32Bit) {
+  taylortrack::utils::WaveParser parser("../Testdata/Test32bit.wav");
+  ASSERT_TRUE(parser.is_decodable());
+
+  std::vector<double> samples;
+  ASSERT_EQ(2, parser.get_decoded_frames(2, &samples));
+  ASSERT_FLOAT_EQ(-37 * 65536 / 2147483647.0, samples[0]);
+  ASSERT_FLOAT_EQ(-21 * 65536 / 2147483647.0, samples[1]);
+}
+
+TEST(WaveParserTest, ExtensibleWithListChunk) {
+  // LIST chunk in front of a WAVE_FORMAT_EXTENSIBLE fmt chunk with 24 bit samples
+  taylortrack::utils::WaveParser parser("../Testdata/Test24bitlist.wav");
+  ASSERT_TRUE(parser.is_valid());
+  ASSERT_TRUE(parser.is_decodable());
+  ASSERT_EQ(0x0001, parser.get_audio_format());
+  ASSERT_EQ(24, parser.get_bits_per_sample());
+  ASSERT_EQ(3, parser.get_block_align());
+  ASSERT_EQ(4096, parser.get_sample_num());
+
+  std::vector<double> samples;
+  ASSERT_EQ(4096, parser.get_decoded_frames(4096, &samples));
+  ASSERT_FLOAT_EQ(-37 * 256 / 8388607.0, samples[0]);
+  ASSERT_FLOAT_EQ(-21 * 256 / 8388607.0, samples[1]);
+  ASSERT_FLOAT_EQ(-12 * 256 / 8388607.0, samples[4095]);
+  ASSERT_TRUE(parser.is_done());
+
+  // no 16 bit views on 24 bit samples
+  ASSERT_EQ(0, parser.get_frames(2).length);
+}
+
+TEST(WaveParserTest, FloatWithPaddedChunks) {
+  // fact and an odd sized LIST chunk between fmt and data
+  taylortrack::utils::WaveParser parser("../Testdata/Testfloat.wav");
+  ASSERT_TRUE(parser.is_valid());
+  ASSERT_TRUE(parser.is_decodable());
+  ASSERT_EQ(0x0003, parser.get_audio_format());
+  ASSERT_EQ(4096, parser.get_sample_num());
+
+  std::vector<double> samples;
+  ASSERT_EQ(4096, parser.get_decoded_frames(4096, &samples));
+  ASSERT_FLOAT_EQ(-0.0011291848, samples[0]);
+  ASSERT_FLOAT_EQ(-0.0006408887, samples[1]);
+  ASSERT_FLOAT_EQ(static_cast<float>(-12 / 32767.0), samples[4095]);
+}
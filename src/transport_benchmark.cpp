@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Compares the per-sample bottle format with packed float32 and int16 frames
+ *
+ * Every format is written, serialized to the binary representation YARP sends over the wire, deserialized and
+ * read back into doubles, as the input modules and the audio tracking module do for every frame.
+ */
+
+#include <yarp/os/all.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sim/frame_protocol.h"
+
+namespace {
+struct Result {
+  double encode_us = 0.0;
+  double decode_us = 0.0;
+  size_t wire_bytes = 0;
+  double max_error = 0.0;
+};
+
+double elapsed_us(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+Result measure(const std::vector<double> &samples, int channels,
+               taylortrack::utils::SampleTransport transport, int iterations) {
+  Result result;
+  yarp::os::Bottle bottle;
+  yarp::os::Bottle received;
+  std::vector<char> payload;
+  std::vector<double> decoded;
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    taylortrack::sim::write_samples(samples.data(), samples.size(), channels, transport, &payload, &bottle);
+    size_t size = 0;
+    const char *wire = bottle.toBinary(&size);
+    result.encode_us += elapsed_us(start);
+
+    start = std::chrono::steady_clock::now();
+    received.fromBinary(wire, static_cast<int>(size));
+    taylortrack::sim::read_samples(received, &decoded);
+    result.decode_us += elapsed_us(start);
+    result.wire_bytes = size;
+  }
+  result.encode_us /= iterations;
+  result.decode_us /= iterations;
+  for (size_t sample = 0; sample < samples.size() && sample < decoded.size(); ++sample)
+    result.max_error = std::max(result.max_error, std::fabs(samples[sample] - decoded[sample]));
+  return result;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int channels = argc > 1 ? std::atoi(argv[1]) : 4;
+  int frame_size = argc > 2 ? std::atoi(argv[2]) : 2048;
+  int iterations = argc > 3 ? std::atoi(argv[3]) : 1000;
+  if (channels <= 0 || frame_size <= 0 || iterations <= 0) {
+    std::cout << "Usage: transport_benchmark [channels] [frame_size] [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // a sweep in every channel, the level stays within the int16 range
+  std::vector<double> samples(static_cast<size_t>(channels) * frame_size);
+  for (int frame = 0; frame < frame_size; ++frame)
+    for (int channel = 0; channel < channels; ++channel)
+      samples[frame * channels + channel] = 0.8 * std::sin(0.001 * frame * frame + channel);
+
+  std::cout << channels << " channels x " << frame_size << " frames, " << iterations
+            << " iterations" << std::endl;
+  std::cout << std::left << std::setw(10) << "format" << std::right << std::setw(14) << "encode [us]"
+            << std::setw(14) << "decode [us]" << std::setw(14) << "wire [bytes]"
+            << std::setw(14) << "max error" << std::endl;
+  const std::pair<const char *, taylortrack::utils::SampleTransport> formats[] = {
+      {"bottle", taylortrack::utils::SampleTransport::kBottle},
+      {"float32", taylortrack::utils::SampleTransport::kFloat32},
+      {"int16", taylortrack::utils::SampleTransport::kInt16}};
+  for (const auto &format : formats) {
+    Result result = measure(samples, channels, format.second, iterations);
+    std::cout << std::left << std::setw(10) << format.first << std::right << std::fixed
+              << std::setprecision(1) << std::setw(14) << result.encode_us
+              << std::setw(14) << result.decode_us << std::setw(14) << result.wire_bytes
+              << std::scientific << std::setprecision(2) << std::setw(14) << result.max_error
+              << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Single producer single consumer queue whose ends wait until the other side caught up.
+*/
+#ifndef TAYLORTRACK_UTILS_BLOCKING_SPSC_QUEUE_H_
+#define TAYLORTRACK_UTILS_BLOCKING_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "utils/spsc_queue.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class BlockingSpscQueue
+* @brief SpscQueue with blocking push and pop for threads that have nothing else to do while waiting.
+*
+* Values pass through the lock-free SpscQueue. A waiting side spins shortly and then sleeps on a condition
+* variable until the other side pushed or popped, so idle or overloaded pipeline stages do not burn a core.
+* A push or pop only takes the mutex and notifies the condition variable while the other side sleeps, so the
+* handoff between two busy threads stays lock-free.
+* @code
+*  //Example usage:
+*  taylortrack::utils::BlockingSpscQueue<int> queue(4);
+*  // producer thread
+*  queue.push(42);
+*  // consumer thread
+*  int value = queue.pop();
+* @endcode
+*/
+template<class T>
+class BlockingSpscQueue {
+ public:
+  /**
+   * @brief Allocates room for capacity values.
+   * @param capacity maximum number of values in the queue, values below one are treated as one
+   */
+  explicit BlockingSpscQueue(size_t capacity) : queue_(capacity) {
+  }
+
+  BlockingSpscQueue(const BlockingSpscQueue &) = delete;
+  BlockingSpscQueue &operator=(const BlockingSpscQueue &) = delete;
+
+  /**
+   * @brief Appends a value without waiting, may only be called by the producer thread.
+   * @param value value to copy or move into the queue, left untouched if the queue is full
+   * @return false if the queue is full and the value was not added
+   */
+  template<class U>
+  bool try_push(U &&value) {
+    if (!queue_.try_push(std::forward<U>(value)))
+      return false;
+    wake();
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest value without waiting, may only be called by the consumer thread.
+   * @param value receives the removed value
+   * @return false if the queue is empty and value was not changed
+   */
+  bool try_pop(T *value) {
+    if (!queue_.try_pop(value))
+      return false;
+    wake();
+    return true;
+  }
+
+  /**
+   * @brief Appends a value, waits while the queue is full. May only be called by the producer thread.
+   * @param value value to copy into the queue
+   */
+  void push(const T &value) {
+    for (int spin = 0; spin < kSpinCount; ++spin) {
+      if (try_push(value))
+        return;
+      std::this_thread::yield();
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      sleep(&lock, [&]() { return queue_.try_push(value); });
+    }
+    wake();
+  }
+
+  /**
+   * @brief Removes the oldest value, waits while the queue is empty. May only be called by the consumer thread.
+   * @return the removed value
+   */
+  T pop() {
+    T value;
+    for (int spin = 0; spin < kSpinCount; ++spin) {
+      if (try_pop(&value))
+        return value;
+      std::this_thread::yield();
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      sleep(&lock, [&]() { return queue_.try_pop(&value); });
+    }
+    wake();
+    return value;
+  }
+
+  /**
+   * @brief Checks whether the queue holds no values.
+   *
+   * Only a snapshot when called while the other side is active.
+   * @return true if the queue is empty, false otherwise.
+   */
+  bool empty() const {
+    return queue_.empty();
+  }
+
+  /**
+   * @brief Returns the maximum number of values in the queue.
+   * @return capacity given to the constructor
+   */
+  size_t get_capacity() const {
+    return queue_.get_capacity();
+  }
+
+ private:
+  // attempts before a waiting side goes to sleep, covers a neighbouring stage that is about to finish
+  static const int kSpinCount = 64;
+  // the values, never locked
+  SpscQueue<T> queue_;
+  // only held while a side checks the queue before sleeping and when waking it
+  std::mutex mutex_;
+  // signalled after a push or pop while the other side sleeps
+  std::condition_variable changed_;
+  // number of sides registered to sleep, a push or pop without sleepers skips the mutex
+  std::atomic<int> sleepers_{0};
+
+  // registers before the queue is checked, together with the fence in wake() either the waking side
+  // sees the sleeper or the sleeping side sees the change
+  template<class Predicate>
+  void sleep(std::unique_lock<std::mutex> *lock, Predicate ready) {
+    sleepers_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    changed_.wait(*lock, ready);
+    sleepers_.fetch_sub(1);
+  }
+
+  // without sleepers nothing is locked, otherwise passing through the mutex orders the change before
+  // the sleeping side checks the queue again, so the notification cannot fall between its check and its wait
+  void wake() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load() == 0)
+      return;
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    changed_.notify_all();
+  }
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_BLOCKING_SPSC_QUEUE_H_
@@ -0,0 +1,97 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Layout of the files written by taylortrack::utils::CaptureRecorder.
+*
+* A capture file starts with a CaptureFileHeader followed by one record per frame: a CaptureRecordHeader and
+* its values as 32 bit floats. Closing the recorder appends one CaptureIndexEntry per record and a
+* CaptureTrailer pointing to them. All numbers are stored in the byte order of the recording machine.
+*/
+#ifndef TAYLORTRACK_UTILS_CAPTURE_FORMAT_H_
+#define TAYLORTRACK_UTILS_CAPTURE_FORMAT_H_
+
+#include <cstdint>
+
+namespace taylortrack {
+namespace utils {
+/**
+ * @brief Identifies a capture file.
+ */
+const char kCaptureMagic[4] = {'T', 'T', 'C', 'P'};
+
+/**
+ * @brief Identifies the index trailer of a capture file.
+ */
+const char kCaptureIndexMagic[4] = {'T', 'T', 'I', 'X'};
+
+/**
+ * @brief Version of the layout described here.
+ */
+const uint32_t kCaptureVersion = 1;
+
+/**
+ * @struct CaptureFileHeader
+ * @brief First bytes of a capture file.
+ */
+struct CaptureFileHeader {
+  char magic[4];     ///< kCaptureMagic
+  uint32_t version;  ///< kCaptureVersion
+};
+
+/**
+ * @struct CaptureRecordHeader
+ * @brief Precedes the values of every recorded frame.
+ */
+struct CaptureRecordHeader {
+  uint64_t sequence;  ///< number of the frame in the stream, gaps mark frames that were not recorded
+  double timestamp;   ///< seconds since the epoch when the frame was streamed
+  uint32_t values;    ///< number of 32 bit float values following the header
+  uint32_t reserved;  ///< 0
+};
+
+/**
+ * @struct CaptureIndexEntry
+ * @brief Locates a record in the file.
+ */
+struct CaptureIndexEntry {
+  uint64_t sequence;  ///< sequence number of the record
+  double timestamp;   ///< timestamp of the record
+  uint64_t offset;    ///< byte offset of the CaptureRecordHeader
+};
+
+/**
+ * @struct CaptureTrailer
+ * @brief Last bytes of a completely written capture file.
+ */
+struct CaptureTrailer {
+  uint64_t index_offset;  ///< byte offset of the first CaptureIndexEntry
+  uint64_t entries;       ///< number of index entries
+  char magic[4];          ///< kCaptureIndexMagic
+  uint32_t version;       ///< kCaptureVersion
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_CAPTURE_FORMAT_H_
@@ -0,0 +1,117 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the capture_reader.h
+*/
+#include "utils/capture_reader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace taylortrack {
+namespace utils {
+CaptureReader::CaptureReader(const char *file_name) : file_(file_name) {
+  CaptureFileHeader header;
+  if (!file_.is_open() || file_.size() < sizeof(header))
+    return;
+  std::memcpy(&header, file_.data(), sizeof(header));
+  if (std::memcmp(header.magic, kCaptureMagic, sizeof(header.magic)) != 0 ||
+      header.version != kCaptureVersion)
+    return;
+  valid_ = true;
+  complete_ = load_index();
+  if (!complete_)
+    scan_records();
+}
+
+size_t CaptureReader::seek(double timestamp) const {
+  std::vector<CaptureIndexEntry>::const_iterator found = std::lower_bound(
+      index_.begin(), index_.end(), timestamp,
+      [](const CaptureIndexEntry &entry, double value) { return entry.timestamp < value; });
+  return static_cast<size_t>(found - index_.begin());
+}
+
+void CaptureReader::read_frame(size_t frame, std::vector<double> *values) const {
+  CaptureRecordHeader header;
+  const unsigned char *record = file_.data() + index_[frame].offset;
+  std::memcpy(&header, record, sizeof(header));
+  record += sizeof(header);
+  values->resize(header.values);
+  for (size_t value = 0; value < header.values; ++value) {
+    // copied, the values carry no alignment guarantee
+    float sample;
+    std::memcpy(&sample, record + value * sizeof(float), sizeof(float));
+    (*values)[value] = sample;
+  }
+}
+
+bool CaptureReader::load_index() {
+  CaptureTrailer trailer;
+  if (file_.size() < sizeof(CaptureFileHeader) + sizeof(trailer))
+    return false;
+  uint64_t trailer_offset = file_.size() - sizeof(trailer);
+  std::memcpy(&trailer, file_.data() + trailer_offset, sizeof(trailer));
+  if (std::memcmp(trailer.magic, kCaptureIndexMagic, sizeof(trailer.magic)) != 0 ||
+      trailer.version != kCaptureVersion || trailer.index_offset < sizeof(CaptureFileHeader) ||
+      trailer.index_offset > trailer_offset ||
+      (trailer_offset - trailer.index_offset) / sizeof(CaptureIndexEntry) != trailer.entries ||
+      (trailer_offset - trailer.index_offset) % sizeof(CaptureIndexEntry) != 0)
+    return false;
+
+  index_.resize(static_cast<size_t>(trailer.entries));
+  std::memcpy(index_.data(), file_.data() + trailer.index_offset,
+              index_.size() * sizeof(CaptureIndexEntry));
+  for (const CaptureIndexEntry &entry : index_) {
+    CaptureRecordHeader header;
+    if (!read_record_header(entry.offset, trailer.index_offset, &header)) {
+      index_.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+void CaptureReader::scan_records() {
+  uint64_t offset = sizeof(CaptureFileHeader);
+  CaptureRecordHeader header;
+  // a crash may have cut the last record short
+  while (read_record_header(offset, file_.size(), &header)) {
+    CaptureIndexEntry entry;
+    entry.sequence = header.sequence;
+    entry.timestamp = header.timestamp;
+    entry.offset = offset;
+    index_.push_back(entry);
+    offset += sizeof(header) + header.values * sizeof(float);
+  }
+}
+
+bool CaptureReader::read_record_header(uint64_t offset, uint64_t limit,
+                                       CaptureRecordHeader *header) const {
+  if (offset < sizeof(CaptureFileHeader) || offset > limit || limit - offset < sizeof(*header))
+    return false;
+  std::memcpy(header, file_.data() + offset, sizeof(*header));
+  return (limit - offset - sizeof(*header)) / sizeof(float) >= header->values;
+}
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,135 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::CaptureReader class.
+*/
+#ifndef TAYLORTRACK_UTILS_CAPTURE_READER_H_
+#define TAYLORTRACK_UTILS_CAPTURE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/capture_format.h"
+#include "utils/mapped_file.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class CaptureReader
+* @brief Reads the frames of a capture file written by taylortrack::utils::CaptureRecorder.
+*
+* The file is mapped into memory and its index is loaded, so any frame can be read directly and seek() finds the
+* frame of a timestamp by binary search. The index of a recording that was not closed properly, for example
+* because the streamer crashed, is rebuilt from the records up to the first incomplete one.
+* @code
+*  //Example usage:
+*  taylortrack::utils::CaptureReader reader("session.ttcap");
+*  std::vector<double> frame;
+*  // replay from ten seconds into the recording
+*  for (size_t index = reader.seek(reader.get_timestamp(0) + 10.0); index < reader.get_frame_count(); ++index)
+*    reader.read_frame(index, &frame);
+* @endcode
+*/
+class CaptureReader {
+ public:
+  /**
+   * @brief Maps the file and loads its index
+   * @param file_name path of the capture file
+   */
+  explicit CaptureReader(const char *file_name);
+
+  /**
+   * @brief Checks whether the file is a capture file
+   * @return true if the file could be opened and starts with a capture file header
+   */
+  bool is_valid() const {
+    return valid_;
+  }
+
+  /**
+   * @brief Checks whether the file was closed properly
+   * @return true if the index was read from the file, false if it was rebuilt
+   */
+  bool is_complete() const {
+    return complete_;
+  }
+
+  /**
+   * @brief Returns the number of frames
+   * @return number of readable frames
+   */
+  size_t get_frame_count() const {
+    return index_.size();
+  }
+
+  /**
+   * @brief Returns the sequence number of a frame
+   * @param frame index of the frame, below get_frame_count()
+   * @return number of the frame in the recorded stream
+   */
+  uint64_t get_sequence(size_t frame) const {
+    return index_[frame].sequence;
+  }
+
+  /**
+   * @brief Returns the timestamp of a frame
+   * @param frame index of the frame, below get_frame_count()
+   * @return seconds since the epoch when the frame was streamed
+   */
+  double get_timestamp(size_t frame) const {
+    return index_[frame].timestamp;
+  }
+
+  /**
+   * @brief Finds the first frame streamed at or after a point in time
+   * @param timestamp seconds since the epoch
+   * @return index of the frame, get_frame_count() if all frames are older
+   */
+  size_t seek(double timestamp) const;
+
+  /**
+   * @brief Reads the values of a frame
+   * @param frame index of the frame, below get_frame_count()
+   * @param values receives the values of the frame
+   */
+  void read_frame(size_t frame, std::vector<double> *values) const;
+
+ private:
+  MappedFile file_;
+  std::vector<CaptureIndexEntry> index_;
+  bool valid_ = false;
+  bool complete_ = false;
+
+  // loads the index written by the recorder, false if the file has none or it does not fit the file
+  bool load_index();
+  // rebuilds the index by walking the records
+  void scan_records();
+  // reads the header of the record at offset, false if the record does not end before limit
+  bool read_record_header(uint64_t offset, uint64_t limit, CaptureRecordHeader *header) const;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_CAPTURE_READER_H_
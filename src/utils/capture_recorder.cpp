@@ -0,0 +1,139 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the capture_recorder.h
+*/
+#include "utils/capture_recorder.h"
+#include <cstring>
+#include <iostream>
+
+namespace taylortrack {
+namespace utils {
+CaptureRecorder::CaptureRecorder(const char *file_name, size_t buffer_size)
+    : file_(file_name, std::ios::out | std::ios::binary | std::ios::trunc),
+      buffer_size_(buffer_size) {
+  if (!file_)
+    return;
+  CaptureFileHeader header;
+  std::memcpy(header.magic, kCaptureMagic, sizeof(header.magic));
+  header.version = kCaptureVersion;
+  file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  // both buffers are allocated once and swapped afterwards
+  active_.reserve(buffer_size_);
+  pending_.reserve(buffer_size_);
+  writer_ = std::thread(&CaptureRecorder::write_pending, this);
+}
+
+CaptureRecorder::~CaptureRecorder() {
+  if (!writer_.joinable())
+    return;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // the last frames may wait for the disk now
+    wake_.wait(lock, [this] { return pending_.empty(); });
+    handed_over_ += active_.size();
+    active_.swap(pending_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  writer_.join();
+
+  CaptureTrailer trailer;
+  trailer.index_offset = sizeof(CaptureFileHeader) + handed_over_;
+  trailer.entries = index_.size();
+  std::memcpy(trailer.magic, kCaptureIndexMagic, sizeof(trailer.magic));
+  trailer.version = kCaptureVersion;
+  file_.write(reinterpret_cast<const char *>(index_.data()),
+              static_cast<std::streamsize>(index_.size() * sizeof(CaptureIndexEntry)));
+  file_.write(reinterpret_cast<const char *>(&trailer), sizeof(trailer));
+  file_.close();
+  if (!file_)
+    std::cout << "Warning: the recording could not be written completely" << std::endl;
+  if (dropped_ > 0)
+    std::cout << "Warning: " << dropped_ << " frames were not recorded" << std::endl;
+}
+
+bool CaptureRecorder::record(uint64_t sequence, double timestamp, const double *values, size_t count) {
+  if (!is_open())
+    return false;
+  size_t record_size = sizeof(CaptureRecordHeader) + count * sizeof(float);
+  if (!active_.empty() && active_.size() + record_size > buffer_size_ && !hand_over()) {
+    ++dropped_;
+    return false;
+  }
+
+  CaptureIndexEntry entry;
+  entry.sequence = sequence;
+  entry.timestamp = timestamp;
+  entry.offset = sizeof(CaptureFileHeader) + handed_over_ + active_.size();
+  CaptureRecordHeader header;
+  header.sequence = sequence;
+  header.timestamp = timestamp;
+  header.values = static_cast<uint32_t>(count);
+  header.reserved = 0;
+
+  size_t offset = active_.size();
+  active_.resize(offset + record_size);
+  char *record = active_.data() + offset;
+  std::memcpy(record, &header, sizeof(header));
+  record += sizeof(header);
+  for (size_t value = 0; value < count; ++value) {
+    float sample = static_cast<float>(values[value]);
+    std::memcpy(record + value * sizeof(float), &sample, sizeof(float));
+  }
+  index_.push_back(entry);
+
+  // handing over early keeps the file close to the stream and the other buffer free
+  if (active_.size() >= buffer_size_ / 2)
+    hand_over();
+  return true;
+}
+
+bool CaptureRecorder::hand_over() {
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || !pending_.empty())
+    return false;
+  handed_over_ += active_.size();
+  active_.swap(pending_);
+  wake_.notify_all();
+  return true;
+}
+
+void CaptureRecorder::write_pending() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this] { return !pending_.empty() || stopping_; });
+    if (pending_.empty())
+      break;
+    // the recording thread keeps filling the other buffer meanwhile
+    lock.unlock();
+    file_.write(pending_.data(), static_cast<std::streamsize>(pending_.size()));
+    lock.lock();
+    pending_.clear();
+    wake_.notify_all();
+  }
+}
+}  // namespace utils
+}  // namespace taylortrack
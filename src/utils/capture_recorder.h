@@ -0,0 +1,140 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::CaptureRecorder class.
+*/
+#ifndef TAYLORTRACK_UTILS_CAPTURE_RECORDER_H_
+#define TAYLORTRACK_UTILS_CAPTURE_RECORDER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/capture_format.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class CaptureRecorder
+* @brief Records frames into a capture file without blocking the thread that streams them.
+*
+* record() only copies a frame into the active one of two buffers. A full buffer is swapped with the other one,
+* which a background thread writes to the file meanwhile. If the writer has not finished the other buffer yet,
+* the frame is dropped from the recording instead of waiting for the disk, the gap shows in the sequence
+* numbers. The destructor writes the remaining frames and the index, see utils/capture_format.h.
+* @code
+*  //Example usage:
+*  taylortrack::utils::CaptureRecorder recorder("session.ttcap");
+*  if (recorder.is_open())
+*    recorder.record(sequence, timestamp, frame.data(), frame.size());
+* @endcode
+*/
+class CaptureRecorder {
+ public:
+  /**
+   * @brief Creates the file and starts the writer thread
+   * @param file_name path of the capture file, an existing file is replaced
+   * @param buffer_size bytes collected before they are handed to the writer
+   */
+  explicit CaptureRecorder(const char *file_name, size_t buffer_size = 1 << 22);
+
+  CaptureRecorder(const CaptureRecorder &that) = delete;
+  CaptureRecorder &operator=(const CaptureRecorder &that) = delete;
+
+  /**
+   * @brief Destructor
+   *
+   * Writes the remaining frames and the index, stops the writer thread and closes the file.
+   */
+  ~CaptureRecorder();
+
+  /**
+   * @brief Checks whether the file could be created
+   * @return true if frames are recorded
+   */
+  bool is_open() const {
+    return writer_.joinable();
+  }
+
+  /**
+   * @brief Adds a frame to the recording
+   *
+   * Never waits for the file, must always be called from the same thread.
+   * @param sequence number of the frame in the stream
+   * @param timestamp seconds since the epoch when the frame was streamed
+   * @param values values of the frame, stored as 32 bit floats
+   * @param count number of values
+   * @return false if the frame was dropped because the writer fell behind or the file is not open
+   */
+  bool record(uint64_t sequence, double timestamp, const double *values, size_t count);
+
+  /**
+   * @brief Returns the number of recorded frames
+   * @return frames that will be in the file
+   */
+  uint64_t get_recorded() const {
+    return index_.size();
+  }
+
+  /**
+   * @brief Returns the number of dropped frames
+   * @return frames record() could not take because the writer fell behind
+   */
+  uint64_t get_dropped() const {
+    return dropped_;
+  }
+
+ private:
+  std::ofstream file_;
+  // bytes collected before a hand over
+  size_t buffer_size_;
+  // buffer record() appends to
+  std::vector<char> active_;
+  // buffer the writer thread writes, empty while the writer is idle
+  std::vector<char> pending_;
+  // bytes handed to the writer so far, locates the records in the file
+  uint64_t handed_over_ = 0;
+  // one entry per recorded frame
+  std::vector<CaptureIndexEntry> index_;
+  uint64_t dropped_ = 0;
+  // guards pending_ and stopping_
+  std::mutex mutex_;
+  // signals a new pending buffer to the writer and a written one back
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  std::thread writer_;
+
+  // swaps the buffers if the writer is idle, never blocks
+  bool hand_over();
+  // body of the writer thread
+  void write_pending();
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_CAPTURE_RECORDER_H_
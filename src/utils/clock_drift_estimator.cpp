@@ -0,0 +1,101 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::ClockDriftEstimator class.
+*/
+
+#include "utils/clock_drift_estimator.h"
+
+namespace taylortrack {
+namespace utils {
+
+ClockDriftEstimator::ClockDriftEstimator(double nominal_rate, double interval, size_t window)
+    : nominal_rate_(nominal_rate), interval_(interval), window_(window < 2 ? 2 : window),
+      seconds_per_sample_(1.0 / nominal_rate) {}
+
+void ClockDriftEstimator::add_stamp(double position, double time) {
+  if (position < min_position_)
+    return;
+  if (stamp_count_ == 0)
+    interval_start_ = time;
+  position_sum_ += position;
+  time_sum_ += time;
+  ++stamp_count_;
+
+  if (time - interval_start_ >= interval_) {
+    Point point = {position_sum_ / stamp_count_, time_sum_ / stamp_count_};
+    points_.push_back(point);
+    if (points_.size() > window_)
+      points_.pop_front();
+    stamp_count_ = 0;
+    position_sum_ = 0.0;
+    time_sum_ = 0.0;
+    fit();
+  } else if (points_.empty()) {
+    // until the first interval is complete its running mean anchors the nominal rate
+    mean_position_ = position_sum_ / stamp_count_;
+    mean_time_ = time_sum_ / stamp_count_;
+  }
+}
+
+void ClockDriftEstimator::reset(double min_position) {
+  points_.clear();
+  min_position_ = min_position;
+  stamp_count_ = 0;
+  position_sum_ = 0.0;
+  time_sum_ = 0.0;
+  mean_position_ = 0.0;
+  mean_time_ = 0.0;
+  seconds_per_sample_ = 1.0 / nominal_rate_;
+}
+
+void ClockDriftEstimator::fit() {
+  double position_mean = 0.0;
+  double time_mean = 0.0;
+  for (const Point &point : points_) {
+    position_mean += point.position;
+    time_mean += point.time;
+  }
+  position_mean /= points_.size();
+  time_mean /= points_.size();
+  mean_position_ = position_mean;
+  mean_time_ = time_mean;
+  if (points_.size() < 2)
+    return;
+
+  // positions are exact and times jitter, so the times are regressed on the positions
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (const Point &point : points_) {
+    double position = point.position - position_mean;
+    covariance += position * (point.time - time_mean);
+    variance += position * position;
+  }
+  if (variance > 0.0 && covariance > 0.0)
+    seconds_per_sample_ = covariance / variance;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,147 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::ClockDriftEstimator class.
+*/
+
+#ifndef TAYLORTRACK_UTILS_CLOCK_DRIFT_ESTIMATOR_H_
+#define TAYLORTRACK_UTILS_CLOCK_DRIFT_ESTIMATOR_H_
+
+#include <cstddef>
+#include <deque>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class ClockDriftEstimator
+* @brief Estimates the actual sample clock of an audio device from timestamped sample positions.
+*
+* Every recorded period contributes the position of its first sample and the time it was captured. The stamps are
+* averaged over short intervals to suppress scheduling jitter, a line fitted through the intervals of a long window
+* maps sample positions to capture times and back. The slope is the actual sample rate of the device, which differs
+* from the nominal one by some parts per million and changes slowly with temperature.
+* @code
+* // Example usage:
+* taylortrack::utils::ClockDriftEstimator estimator(44100.0);
+* // for every recorded period
+* estimator.add_stamp(first_sample_position, capture_time);
+* double rate = estimator.get_rate();
+* double position = estimator.get_position(capture_time_of_interest);
+* @endcode
+*/
+class ClockDriftEstimator {
+ public:
+  /**
+   * @brief Constructor
+   * @param nominal_rate sample rate assumed until two intervals were averaged
+   * @param interval seconds of stamps averaged into a single point of the fit
+   * @param window maximum number of averaged points the line is fitted through
+   */
+  explicit ClockDriftEstimator(double nominal_rate, double interval = 0.5, size_t window = 600);
+
+  /**
+   * @brief Adds the capture time of a sample position
+   * @param position position of the sample within the stream of the device
+   * @param time capture time of the sample in seconds
+   */
+  void add_stamp(double position, double time);
+
+  /**
+   * @brief Forgets all stamps, for example after samples were lost
+   * @param min_position stamps of earlier positions are ignored from now on
+   */
+  void reset(double min_position = 0.0);
+
+  /**
+   * @brief Checks whether positions and times can be mapped
+   * @return true once a stamp was added since the last reset
+   */
+  bool has_stamps() const {
+    return stamp_count_ > 0 || !points_.empty();
+  }
+
+  /**
+   * @brief Returns the estimated sample rate of the device
+   * @return samples per second
+   */
+  double get_rate() const {
+    return 1.0 / seconds_per_sample_;
+  }
+
+  /**
+   * @brief Maps a sample position to its capture time
+   * @pre has_stamps() returns true
+   * @param position position of the sample within the stream of the device
+   * @return capture time in seconds
+   */
+  double get_time(double position) const {
+    return mean_time_ + (position - mean_position_) * seconds_per_sample_;
+  }
+
+  /**
+   * @brief Maps a capture time to the fractional sample position recorded at that time
+   * @pre has_stamps() returns true
+   * @param time capture time in seconds
+   * @return sample position within the stream of the device
+   */
+  double get_position(double time) const {
+    return mean_position_ + (time - mean_time_) / seconds_per_sample_;
+  }
+
+ private:
+  // averaged stamp
+  struct Point {
+    double position;
+    double time;
+  };
+  // sample rate without a fit
+  double nominal_rate_;
+  // seconds of stamps per point
+  double interval_;
+  // maximum number of points
+  size_t window_;
+  // averaged stamps, oldest first
+  std::deque<Point> points_;
+  // stamps of earlier positions are ignored
+  double min_position_ = 0.0;
+  // number of stamps of the point being averaged
+  int stamp_count_ = 0;
+  // sums of the point being averaged
+  double position_sum_ = 0.0;
+  double time_sum_ = 0.0;
+  // time of the first stamp of the point being averaged
+  double interval_start_ = 0.0;
+  // fitted line through the mean point of the window
+  double mean_position_ = 0.0;
+  double mean_time_ = 0.0;
+  double seconds_per_sample_;
+
+  // fits the line through the averaged points
+  void fit();
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_CLOCK_DRIFT_ESTIMATOR_H_
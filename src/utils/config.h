@@ -58,6 +58,37 @@ struct MicrophoneDevice {
   int channels = 0;
 };
 
+/**
+ * @enum PairSelectionPolicy
+ * @brief Decides which microphone pairs the audio tracking algorithm evaluates.
+ */
+enum class PairSelectionPolicy {
+  kAll,              ///< every microphone pair
+  kMinimumBaseline,  ///< only pairs at least AudioSettings::min_baseline apart
+  kTopK,             ///< AudioSettings::max_pairs pairs with the most diverse baselines
+  kRoundRobin        ///< a rotating subset of AudioSettings::max_pairs pairs per frame
+};
+
+/**
+ * @enum VadMode
+ * @brief Decides how the audio tracking algorithm detects voice activity.
+ */
+enum class VadMode {
+  kEnergy,    ///< mean power of the first channel reaching AudioSettings::vad_threshold
+  kSpectral,  ///< speech band energy, flatness and noise floor of the spectra the localization computes anyway
+  kStreaming  ///< power of all channels over adaptive noise floors, decided block by block while receiving
+};
+
+/**
+ * @enum SampleTransport
+ * @brief Decides how the input modules send frames of samples.
+ */
+enum class SampleTransport {
+  kBottle,   ///< one double value per sample
+  kFloat32,  ///< packed frame of interleaved 32 bit floats
+  kInt16     ///< packed frame of interleaved 16 bit integers, samples beyond +-1 are clipped
+};
+
 /**
  * @struct GeneralOptions
  * @brief Contains general options.
@@ -71,6 +102,18 @@ struct GeneralOptions {
 };
 
 
+/**
+ * @struct InputSettings
+ * @brief Contains the parameters shared by all input modules.
+ */
+struct InputSettings {
+  /**
+   * @var transport
+   * Defines how frames of samples are sent to the audio tracking module.
+  */
+  SampleTransport transport = SampleTransport::kBottle;
+};
+
 /**
  * @struct MicrophoneInputSettings
  * @brief Contains the parameters for the microphone input.
@@ -93,6 +136,27 @@ struct MicrophoneInputSettings {
    * Defines the amount of samples per channel that are being recorded per frame.
   */
   int frame_size = 2049;
+
+  /**
+   * @var period_size
+   * Defines the amount of samples per channel each audio callback delivers, independent of the frame size.
+   * Small periods lower the latency, 0 lets the audio driver choose.
+  */
+  int period_size = 256;
+
+  /**
+   * @var align
+   * Defines whether the devices are merged sample aligned using the capture times of their samples, which
+   * removes start offsets and clock drift between them and applies the delays of the devices.
+  */
+  bool align = true;
+
+  /**
+   * @var edge_gcc
+   * Defines whether the cross correlation lag vectors of each frame are computed on the capture node and
+   * streamed instead of the samples. The [audio] settings have to match the ones of the receiver.
+  */
+  bool edge_gcc = false;
 };
 
 /**
@@ -105,6 +169,149 @@ struct WaveInputSettings {
    * Defines the amount of samples per channel that are being read per frame.
   */
   int frame_size = 2049;
+
+  /**
+   * @var speed
+   * Defines how fast the wave file is replayed compared to its sample rate, 1 streams in real time,
+   * 0 streams as fast as possible.
+  */
+  double speed = 1.0;
+};
+
+/**
+ * @struct ReplayInputSettings
+ * @brief Contains the parameters for replaying a recording of the streamer.
+ */
+struct ReplayInputSettings {
+  /**
+   * @var start
+   * Defines the seconds after the first recorded frame the replay starts at.
+  */
+  double start = 0.0;
+
+  /**
+   * @var speed
+   * Defines how fast the recording is replayed compared to the time it was recorded in, 1 replays in real time,
+   * 0 replays as fast as possible.
+  */
+  double speed = 1.0;
+};
+
+/**
+ * @enum TrajectoryType
+ * @brief Decides how a synthetic sound source moves.
+ */
+enum class TrajectoryType {
+  kStatic,  ///< stays at (x, y)
+  kLine,    ///< moves from (x, y) to (x_end, y_end) and back once per period
+  kCircle   ///< circles counterclockwise around (x, y) once per period, starting at angle 0
+};
+
+/**
+ * @struct SyntheticSource
+ * @brief Contains the trajectory of a single synthetic sound source.
+ *
+ * Coordinates are in meters in the frame of the microphone array, the source emits white noise.
+ */
+struct SyntheticSource {
+  /**
+   * @var trajectory
+   * Defines how the source moves.
+  */
+  TrajectoryType trajectory = TrajectoryType::kStatic;
+
+  /**
+   * @var x
+   * Defines the x coordinate of the position, the start of the line or the center of the circle.
+  */
+  double x = 0.0;
+
+  /**
+   * @var y
+   * Defines the y coordinate of the position, the start of the line or the center of the circle.
+  */
+  double y = 0.0;
+
+  /**
+   * @var x_end
+   * Defines the x coordinate of the end of the line.
+  */
+  double x_end = 0.0;
+
+  /**
+   * @var y_end
+   * Defines the y coordinate of the end of the line.
+  */
+  double y_end = 0.0;
+
+  /**
+   * @var radius
+   * Defines the radius of the circle.
+  */
+  double radius = 0.0;
+
+  /**
+   * @var period
+   * Defines the seconds a line round trip or a circle takes.
+  */
+  double period = 1.0;
+};
+
+/**
+ * @struct SyntheticInputSettings
+ * @brief Contains the parameters for the synthetic scene input.
+ *
+ * The microphones and the sample rate are taken from the [audio] settings.
+ */
+struct SyntheticInputSettings {
+  /**
+   * @var frame_size
+   * Defines the amount of samples per channel that are being synthesized per frame.
+  */
+  int frame_size = 2048;
+
+  /**
+   * @var speed
+   * Defines how fast the scene is streamed compared to the sample rate, 1 streams in real time,
+   * 0 streams as fast as possible.
+  */
+  double speed = 1.0;
+
+  /**
+   * @var duration
+   * Defines the seconds of audio to synthesize, 0 synthesizes endlessly.
+  */
+  double duration = 0.0;
+
+  /**
+   * @var sources
+   * Defines the moving sound sources of the scene.
+  */
+  std::vector<SyntheticSource> sources = {};
+
+  /**
+   * @var noise
+   * Defines the standard deviation of the independent noise of every microphone.
+  */
+  double noise = 0.001;
+
+  /**
+   * @var reflection
+   * Defines the reflection coefficient of the four walls around the grid, 0 simulates a free field.
+  */
+  double reflection = 0.0;
+
+  /**
+   * @var seed
+   * Defines the seed of the source signals and the microphone noise.
+  */
+  int seed = 1;
+
+  /**
+   * @var ground_truth
+   * Defines a file the source positions of every frame are written to, empty writes none.
+  */
+  std::string ground_truth = "";
 };
 
 /**
@@ -144,6 +351,12 @@ struct AudioSettings {
   */
   std::valarray<double> mic_y;
 
+  /**
+   * @var mic_z
+   * Defines a valarray of doubles which stores the z coordinate for each microphone, empty for a planar array at height 0.
+  */
+  std::valarray<double> mic_z;
+
   /**
    * @var beta
    * Defines the beta value for the speaker tracking algorithm.
@@ -162,6 +375,12 @@ struct AudioSettings {
   */
   double grid_y = 4;
 
+  /**
+   * @var grid_z
+   * Defines the heights of the horizontal grid slices that are evaluated.
+  */
+  std::valarray<double> grid_z = std::valarray<double>(0.0, 1);
+
   /**
    * @var interval
    * Defines the interval/step size of the axis.
@@ -173,6 +392,138 @@ struct AudioSettings {
    * Defines the frame size for the speaker tracking algorithm.
   */
   int frame_size = 2048;
+
+  /**
+   * @var pair_selection
+   * Defines which microphone pairs are used for the speaker tracking algorithm.
+  */
+  PairSelectionPolicy pair_selection = PairSelectionPolicy::kAll;
+
+  /**
+   * @var max_pairs
+   * Defines the maximum number of microphone pairs evaluated per frame. 0 means no limit.
+  */
+  int max_pairs = 0;
+
+  /**
+   * @var min_baseline
+   * Defines the minimum distance in meters between two microphones of a pair.
+  */
+  double min_baseline = 0.0;
+
+  /**
+   * @var fixed_point
+   * Defines whether the speaker tracking algorithm works on 16 bit PCM samples in fixed point arithmetic.
+  */
+  bool fixed_point = false;
+
+  /**
+   * @var band_low
+   * Defines the lowest frequency in Hz used by the speaker tracking algorithm.
+  */
+  double band_low = 0.0;
+
+  /**
+   * @var band_high
+   * Defines the highest frequency in Hz used by the speaker tracking algorithm. 0 means up to the Nyquist frequency.
+  */
+  double band_high = 0.0;
+
+  /**
+   * @var subbands
+   * Defines the number of subbands the frequency band is split into and evaluated in parallel.
+  */
+  int subbands = 1;
+
+  /**
+   * @var decimated_rate
+   * Defines the sample rate the audio is decimated to before localization. 0 disables the decimation.
+  */
+  int decimated_rate = 0;
+
+  /**
+   * @var tracking
+   * Defines whether the speaker tracking algorithm only searches a window around the predicted speaker position.
+  */
+  bool tracking = false;
+
+  /**
+   * @var tracking_window
+   * Defines the half width of the search window in degrees.
+  */
+  double tracking_window = 30.0;
+
+  /**
+   * @var full_sweep_interval
+   * Defines the maximum number of windowed frames between two searches over all degrees.
+  */
+  int full_sweep_interval = 25;
+
+  /**
+   * @var tracking_alpha
+   * Defines the gain of the angle correction of the tracker.
+  */
+  double tracking_alpha = 0.5;
+
+  /**
+   * @var tracking_beta
+   * Defines the gain of the angular rate correction of the tracker.
+  */
+  double tracking_beta = 0.05;
+
+  /**
+   * @var governor
+   * Defines whether the resolution of the speaker tracking algorithm adapts to the available processing time.
+  */
+  bool governor = false;
+
+  /**
+   * @var governor_budget
+   * Defines the fraction of the frame period the processing of a frame may take.
+  */
+  double governor_budget = 0.8;
+
+  /**
+   * @var beamforming
+   * Defines whether a delay and sum beamformed stream towards the located speaker is produced.
+  */
+  bool beamforming = false;
+
+  /**
+   * @var heatmap_decimation
+   * Defines how many grid points along each axis are averaged into one value of the published power map.
+  */
+  int heatmap_decimation = 1;
+
+  /**
+   * @var workers
+   * Defines the number of worker processes the microphone pairs are split across, 0 localizes in process.
+  */
+  int workers = 0;
+
+  /**
+   * @var vad
+   * Defines how voice activity is detected before a frame is localized.
+  */
+  VadMode vad = VadMode::kEnergy;
+
+  /**
+   * @var vad_threshold
+   * Defines the minimum mean power of a frame containing speech.
+  */
+  double vad_threshold = 0.0000007;
+
+  /**
+   * @var vad_block_size
+   * Defines the number of samples per channel the streaming voice activity detection decides on at once.
+  */
+  int vad_block_size = 256;
+
+  /**
+   * @var vad_hangover
+   * Defines the number of blocks the streaming voice activity detection keeps speech active after it faded.
+  */
+  int vad_hangover = 8;
 };
 
 /**
@@ -272,6 +623,66 @@ struct CommunicationSettings {
   */
   std::string port = "/unnamed_port";
 };
+
+/**
+ * @struct AudioSession
+ * @brief Contains the settings and ports of one microphone array served by the audio tracking module.
+ */
+struct AudioSession {
+  /**
+   * @var name
+   * Defines the name of the session, the part after "audio." of its section name.
+  */
+  std::string name = "audio";
+
+  /**
+   * @var settings
+   * Contains the audio algorithm parameters of the array.
+  */
+  AudioSettings settings;
+
+  /**
+   * @var communication_in
+   * Defines the port receiving the frames of the array.
+  */
+  CommunicationSettings communication_in;
+
+  /**
+   * @var communication_out
+   * Defines the port publishing the position distributions.
+  */
+  CommunicationSettings communication_out;
+
+  /**
+   * @var communication_destination
+   * Defines the port the distributions are sent to.
+  */
+  CommunicationSettings communication_destination;
+
+  /**
+   * @var beamform_communication_out
+   * Defines the port publishing the beamformed stream.
+  */
+  CommunicationSettings beamform_communication_out;
+
+  /**
+   * @var heatmap_communication_out
+   * Defines the port publishing the power map.
+  */
+  CommunicationSettings heatmap_communication_out;
+
+  /**
+   * @var worker_communication_out
+   * Defines the port broadcasting the frames to the workers.
+  */
+  CommunicationSettings worker_communication_out;
+
+  /**
+   * @var worker_communication_in
+   * Defines the port receiving the partial degree values of the workers.
+  */
+  CommunicationSettings worker_communication_in;
+};
 }  // namespace utils
 }  // namespace taylortrack
 #endif  // TAYLORTRACK_CONFIG_H
@@ -27,6 +27,7 @@ SOFTWARE.
 */
 #include "utils/config_parser.h"
 #include <iomanip>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -50,8 +51,11 @@ bool ConfigParser::parse_file() {
 
   // 0 = options, 1 = audio, 2 = video,
   // 3 = combination, 4 = input, 5 = visualizer
-  // 6 = microphone input, 7 = wave input
+  // 6 = microphone input, 7 = wave input, 8 = synthetic input,
+  // 9 = replay input
   int section = -1;
+  // index into audio_sessions_ while in an [audio.<name>] section
+  int audio_session = -1;
   std::string line = "";
   while (std::getline(file_, line)) {
     std::vector<std::string> split_string = split(line, '=');
@@ -75,46 +79,148 @@ bool ConfigParser::parse_file() {
                 split_string[1].compare("true") == 0;
           break;  // end section 0
 
-        case 1:  // [audio]
+        case 1: {  // [audio] and [audio.<name>]
+          AudioSession *session =
+              audio_session < 0 ? nullptr : &audio_sessions_[audio_session];
+          AudioSettings &audio_settings =
+              session ? session->settings : audio_settings_;
           if (split_string[0].compare("inport") == 0) {
-            audio_settings_.inport = split_string[1];
-            audio_communication_in_.port = split_string[1];
+            audio_settings.inport = split_string[1];
+            (session ? session->communication_in :
+                       audio_communication_in_).port = split_string[1];
           } else if (split_string[0].compare("outport") == 0) {
-            audio_settings_.outport = split_string[1];
-            audio_communication_out_.port = split_string[1];
+            audio_settings.outport = split_string[1];
+            (session ? session->communication_out :
+                       audio_communication_out_).port = split_string[1];
           } else if (split_string[0].compare("destination") == 0) {
-            audio_communication_destination.port = split_string[1];
+            (session ? session->communication_destination :
+                       audio_communication_destination).port = split_string[1];
+          } else if (split_string[0].compare("beamform_outport") == 0) {
+            (session ? session->beamform_communication_out :
+                       audio_beamform_communication_out_).port = split_string[1];
+          } else if (split_string[0].compare("heatmap_outport") == 0) {
+            (session ? session->heatmap_communication_out :
+                       audio_heatmap_communication_out_).port = split_string[1];
           } else if (split_string[0].compare("sample_rate") == 0) {
             std::istringstream(split_string[1]) >>
-                audio_settings_.sample_rate;
+                audio_settings.sample_rate;
           } else if (split_string[0].compare("mic_x") == 0) {
             std::vector<std::string> mic = split_microphones(split_string[1]);
-            audio_settings_.mic_x.resize(mic.size());
+            audio_settings.mic_x.resize(mic.size());
             for (int i = 0; i < static_cast<int>(mic.size()); i++)
-              std::stringstream(mic[i]) >> audio_settings_.mic_x[i];
+              std::stringstream(mic[i]) >> audio_settings.mic_x[i];
           } else if (split_string[0].compare("mic_y") == 0) {
             std::vector<std::string> mic = split_microphones(split_string[1]);
-            audio_settings_.mic_y.resize(mic.size());
+            audio_settings.mic_y.resize(mic.size());
             for (int i = 0; i < static_cast<int>(mic.size()); i++)
               std::stringstream(mic[i]) >>
-                  audio_settings_.mic_y[i];
+                  audio_settings.mic_y[i];
+          } else if (split_string[0].compare("mic_z") == 0) {
+            std::vector<std::string> mic = split_microphones(split_string[1]);
+            audio_settings.mic_z.resize(mic.size());
+            for (int i = 0; i < static_cast<int>(mic.size()); i++)
+              std::stringstream(mic[i]) >> audio_settings.mic_z[i];
+          } else if (split_string[0].compare("grid_z") == 0) {
+            std::vector<std::string> heights =
+                split_microphones(split_string[1]);
+            audio_settings.grid_z.resize(heights.size());
+            for (int i = 0; i < static_cast<int>(heights.size()); i++)
+              std::stringstream(heights[i]) >> audio_settings.grid_z[i];
           } else if (split_string[0].compare("beta") == 0) {
             std::stringstream(split_string[1]) >>
-                audio_settings_.beta;
+                audio_settings.beta;
           } else if (split_string[0].compare("grid_x") == 0) {
             std::stringstream(split_string[1]) >>
-                audio_settings_.grid_x;
+                audio_settings.grid_x;
           } else if (split_string[0].compare("grid_y") == 0) {
             std::stringstream(split_string[1]) >>
-                audio_settings_.grid_y;
+                audio_settings.grid_y;
           } else if (split_string[0].compare("interval") == 0) {
             std::stringstream(split_string[1]) >>
-                audio_settings_.interval;
+                audio_settings.interval;
           } else if (split_string[0].compare("frame_size") == 0) {
             std::stringstream(split_string[1]) >>
-                audio_settings_.frame_size;
+                audio_settings.frame_size;
+          } else if (split_string[0].compare("pair_selection") == 0) {
+            if (split_string[1].compare("all") == 0)
+              audio_settings.pair_selection = PairSelectionPolicy::kAll;
+            else if (split_string[1].compare("min_baseline") == 0)
+              audio_settings.pair_selection =
+                  PairSelectionPolicy::kMinimumBaseline;
+            else if (split_string[1].compare("top_k") == 0)
+              audio_settings.pair_selection = PairSelectionPolicy::kTopK;
+            else if (split_string[1].compare("round_robin") == 0)
+              audio_settings.pair_selection =
+                  PairSelectionPolicy::kRoundRobin;
+          } else if (split_string[0].compare("max_pairs") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.max_pairs;
+          } else if (split_string[0].compare("min_baseline") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.min_baseline;
+          } else if (split_string[0].compare("fixed_point") == 0) {
+            audio_settings.fixed_point =
+                split_string[1].compare("true") == 0;
+          } else if (split_string[0].compare("band_low") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.band_low;
+          } else if (split_string[0].compare("band_high") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.band_high;
+          } else if (split_string[0].compare("subbands") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.subbands;
+          } else if (split_string[0].compare("decimated_rate") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.decimated_rate;
+          } else if (split_string[0].compare("tracking") == 0) {
+            audio_settings.tracking = split_string[1].compare("true") == 0;
+          } else if (split_string[0].compare("tracking_window") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.tracking_window;
+          } else if (split_string[0].compare("full_sweep_interval") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.full_sweep_interval;
+          } else if (split_string[0].compare("tracking_alpha") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.tracking_alpha;
+          } else if (split_string[0].compare("tracking_beta") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.tracking_beta;
+          } else if (split_string[0].compare("governor") == 0) {
+            audio_settings.governor = split_string[1].compare("true") == 0;
+          } else if (split_string[0].compare("governor_budget") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.governor_budget;
+          } else if (split_string[0].compare("beamforming") == 0) {
+            audio_settings.beamforming = split_string[1].compare("true") == 0;
+          } else if (split_string[0].compare("heatmap_decimation") == 0) {
+            std::stringstream(split_string[1]) >>
+                audio_settings.heatmap_decimation;
+          } else if (split_string[0].compare("workers") == 0) {
+            std::stringstream(split_string[1]) >> audio_settings.workers;
+          } else if (split_string[0].compare("worker_outport") == 0) {
+            (session ? session->worker_communication_out :
+                       audio_worker_communication_out_).port = split_string[1];
+          } else if (split_string[0].compare("worker_inport") == 0) {
+            (session ? session->worker_communication_in :
+                       audio_worker_communication_in_).port = split_string[1];
+          } else if (split_string[0].compare("vad") == 0) {
+            if (split_string[1].compare("energy") == 0)
+              audio_settings.vad = VadMode::kEnergy;
+            else if (split_string[1].compare("spectral") == 0)
+              audio_settings.vad = VadMode::kSpectral;
+            else if (split_string[1].compare("streaming") == 0)
+              audio_settings.vad = VadMode::kStreaming;
+          } else if (split_string[0].compare("vad_threshold") == 0) {
+            std::stringstream(split_string[1]) >> audio_settings.vad_threshold;
+          } else if (split_string[0].compare("vad_block_size") == 0) {
+            std::stringstream(split_string[1]) >> audio_settings.vad_block_size;
+          } else if (split_string[0].compare("vad_hangover") == 0) {
+            std::stringstream(split_string[1]) >> audio_settings.vad_hangover;
           }
           break;  // end section 1
+        }
 
         case 2:  // [video]
           if (split_string[0].compare("inport") == 0) {
@@ -175,8 +281,16 @@ bool ConfigParser::parse_file() {
           break;  // end section 3
 
         case 4:
-          if (split_string[0].compare("outport") == 0)
+          if (split_string[0].compare("outport") == 0) {
             input_communication_out_.port = split_string[1];
+          } else if (split_string[0].compare("transport") == 0) {
+            if (split_string[1].compare("bottle") == 0)
+              input_settings_.transport = SampleTransport::kBottle;
+            else if (split_string[1].compare("float32") == 0)
+              input_settings_.transport = SampleTransport::kFloat32;
+            else if (split_string[1].compare("int16") == 0)
+              input_settings_.transport = SampleTransport::kInt16;
+          }
           break;  // end section 4
 
         case 5:
@@ -203,6 +317,15 @@ bool ConfigParser::parse_file() {
           } else if (split_string[0].compare("frame_size") == 0) {
             std::stringstream(split_string[1]) >>
                 microphone_input_settings_.frame_size;
+          } else if (split_string[0].compare("period_size") == 0) {
+            std::stringstream(split_string[1]) >>
+                microphone_input_settings_.period_size;
+          } else if (split_string[0].compare("align") == 0) {
+            microphone_input_settings_.align =
+                split_string[1].compare("true") == 0;
+          } else if (split_string[0].compare("edge_gcc") == 0) {
+            microphone_input_settings_.edge_gcc =
+                split_string[1].compare("true") == 0;
           }
           break;  // end section 6
 
@@ -210,16 +333,79 @@ bool ConfigParser::parse_file() {
           if (split_string[0].compare("frame_size") == 0)
             std::stringstream(split_string[1]) >>
                 wave_input_settings_.frame_size;
+          else if (split_string[0].compare("speed") == 0)
+            std::stringstream(split_string[1]) >>
+                wave_input_settings_.speed;
           break;  // end section 7
 
+        case 8:
+          if (split_string[0].compare("frame_size") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.frame_size;
+          } else if (split_string[0].compare("speed") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.speed;
+          } else if (split_string[0].compare("duration") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.duration;
+          } else if (split_string[0].compare("source") == 0) {
+            SyntheticSource source;
+            if (!parse_source(split_string[1], &source))
+              return false;
+            synthetic_input_settings_.sources.push_back(source);
+          } else if (split_string[0].compare("noise") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.noise;
+          } else if (split_string[0].compare("reflection") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.reflection;
+          } else if (split_string[0].compare("seed") == 0) {
+            std::stringstream(split_string[1]) >>
+                synthetic_input_settings_.seed;
+          } else if (split_string[0].compare("ground_truth") == 0) {
+            synthetic_input_settings_.ground_truth = split_string[1];
+          }
+          break;  // end section 8
+
+        case 9:
+          if (split_string[0].compare("start") == 0)
+            std::stringstream(split_string[1]) >>
+                replay_input_settings_.start;
+          else if (split_string[0].compare("speed") == 0)
+            std::stringstream(split_string[1]) >>
+                replay_input_settings_.speed;
+          break;  // end section 9
+
         default:  // Do nothing
           break;
       }
     }
+    if (!line.empty() && line.at(0) == '[')
+      audio_session = -1;
     if (line.compare("[options]") == 0)
       section = 0;
     else if (line.compare("[audio]") == 0)
       section = 1;
+    else if (line.compare(0, 7, "[audio.") == 0 && line.back() == ']') {
+      // further arrays start from the values of the [audio] section, the ports
+      // the session opens itself get the name of the session appended
+      AudioSession session;
+      session.name = line.substr(7, line.size() - 8);
+      std::string suffix = "/" + session.name;
+      session.settings = audio_settings_;
+      session.settings.inport += suffix;
+      session.settings.outport += suffix;
+      session.communication_in.port = audio_communication_in_.port + suffix;
+      session.communication_out.port = audio_communication_out_.port + suffix;
+      session.communication_destination = audio_communication_destination;
+      session.beamform_communication_out.port = audio_beamform_communication_out_.port + suffix;
+      session.heatmap_communication_out.port = audio_heatmap_communication_out_.port + suffix;
+      session.worker_communication_out.port = audio_worker_communication_out_.port + suffix;
+      session.worker_communication_in.port = audio_worker_communication_in_.port + suffix;
+      audio_sessions_.push_back(session);
+      audio_session = static_cast<int>(audio_sessions_.size()) - 1;
+      section = 1;
+    }
     else if (line.compare("[video]") == 0)
       section = 2;
     else if (line.compare("[combination]") == 0)
@@ -232,6 +418,10 @@ bool ConfigParser::parse_file() {
       section = 6;
     else if (line.compare("[wave input]") == 0)
       section = 7;
+    else if (line.compare("[synthetic input]") == 0)
+      section = 8;
+    else if (line.compare("[replay input]") == 0)
+      section = 9;
   }  // end while
 
   // create proper microphone device objects
@@ -252,9 +442,84 @@ bool ConfigParser::parse_file() {
     microphone_input_settings_.devices.push_back(device);
   }
 
-  return audio_settings_.mic_x.size() == audio_settings_.mic_y.size()
-      && audio_settings_.mic_x.size() > 0
-      && audio_settings_.mic_y.size() > 0;
+  if (audio_sessions_.empty())
+    return has_microphones(audio_settings_);
+  // session opening each port, two sessions opening the same port would fail at runtime
+  std::map<std::string, const AudioSession *> ports;
+  for (const AudioSession &session : audio_sessions_) {
+    if (!has_microphones(session.settings))
+      return false;
+    const CommunicationSettings *opened[] = {
+        &session.communication_in, &session.communication_out,
+        &session.beamform_communication_out, &session.heatmap_communication_out,
+        &session.worker_communication_out, &session.worker_communication_in};
+    for (const CommunicationSettings *communication : opened) {
+      const AudioSession *&owner = ports[communication->port];
+      if (owner && owner != &session) {
+        std::cout << "Error: port " << communication->port << " is used by the audio sessions "
+                  << owner->name << " and " << session.name << "." << std::endl;
+        return false;
+      }
+      owner = &session;
+    }
+  }
+  return true;
+}
+
+bool ConfigParser::parse_source(const std::string &description,
+                                SyntheticSource *source) {
+  std::vector<std::string> elements = split_microphones(description);
+  if (elements.empty())
+    return false;
+  size_t expected = 0;
+  if (elements[0].compare("static") == 0) {
+    source->trajectory = TrajectoryType::kStatic;
+    expected = 3;
+  } else if (elements[0].compare("line") == 0) {
+    source->trajectory = TrajectoryType::kLine;
+    expected = 6;
+  } else if (elements[0].compare("circle") == 0) {
+    source->trajectory = TrajectoryType::kCircle;
+    expected = 5;
+  }
+  if (elements.size() != expected)
+    return false;
+
+  std::stringstream(elements[1]) >> source->x;
+  std::stringstream(elements[2]) >> source->y;
+  if (source->trajectory == TrajectoryType::kLine) {
+    std::stringstream(elements[3]) >> source->x_end;
+    std::stringstream(elements[4]) >> source->y_end;
+    std::stringstream(elements[5]) >> source->period;
+  } else if (source->trajectory == TrajectoryType::kCircle) {
+    std::stringstream(elements[3]) >> source->radius;
+    std::stringstream(elements[4]) >> source->period;
+  }
+  return source->period > 0.0;
+}
+
+bool ConfigParser::has_microphones(const AudioSettings &audio_settings) {
+  return audio_settings.mic_x.size() == audio_settings.mic_y.size()
+      && audio_settings.mic_x.size() > 0
+      && audio_settings.mic_y.size() > 0
+      && (audio_settings.mic_z.size() == 0 ||
+          audio_settings.mic_z.size() == audio_settings.mic_x.size())
+      && audio_settings.grid_z.size() > 0;
+}
+
+std::vector<AudioSession> ConfigParser::get_audio_sessions() const {
+  if (!audio_sessions_.empty())
+    return audio_sessions_;
+  AudioSession session;
+  session.settings = audio_settings_;
+  session.communication_in = audio_communication_in_;
+  session.communication_out = audio_communication_out_;
+  session.communication_destination = audio_communication_destination;
+  session.beamform_communication_out = audio_beamform_communication_out_;
+  session.heatmap_communication_out = audio_heatmap_communication_out_;
+  session.worker_communication_out = audio_worker_communication_out_;
+  session.worker_communication_in = audio_worker_communication_in_;
+  return std::vector<AudioSession>(1, session);
 }
 
 // Method to split a string by the given delim.
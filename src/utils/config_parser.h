@@ -141,6 +141,38 @@ class ConfigParser {
     return audio_communication_destination;
   }
 
+  /**
+   * @brief Retrieves the outgoing communication settings for the beamformed audio stream
+   * @return taylortrack::utils::CommunicationSettings object, containing the outgoing communication settings for the beamformed audio stream
+   */
+  const CommunicationSettings &get_audio_beamform_communication_out() const {
+    return audio_beamform_communication_out_;
+  }
+
+  /**
+   * @brief Retrieves the outgoing communication settings for the power map of the audio tracking module
+   * @return taylortrack::utils::CommunicationSettings object, containing the outgoing communication settings for the power map
+   */
+  const CommunicationSettings &get_audio_heatmap_communication_out() const {
+    return audio_heatmap_communication_out_;
+  }
+
+  /**
+   * @brief Retrieves the communication settings for broadcasting frames to the localization workers
+   * @return taylortrack::utils::CommunicationSettings object, containing the port the frames are broadcast on
+   */
+  const CommunicationSettings &get_audio_worker_communication_out() const {
+    return audio_worker_communication_out_;
+  }
+
+  /**
+   * @brief Retrieves the communication settings for receiving the results of the localization workers
+   * @return taylortrack::utils::CommunicationSettings object, containing the port the partial results arrive on
+   */
+  const CommunicationSettings &get_audio_worker_communication_in() const {
+    return audio_worker_communication_in_;
+  }
+
   /**
   * @brief Retrieves the audio communication source settings.
   * @return taylortrack::utils::CommunicationSettings object, containing the audio communication source settings.
@@ -292,6 +324,46 @@ class ConfigParser {
     ConfigParser::visualizer_communication_in_ = visualizer_communication_in;
   }
 
+  /**
+   * @brief Sets the outgoing communication settings for the beamformed audio stream
+   * @param audio_beamform_communication_out taylortrack::utils::CommunicationSettings to be set
+   */
+  void set_audio_beamform_communication_out(
+      const CommunicationSettings &audio_beamform_communication_out) {
+    ConfigParser::audio_beamform_communication_out_ =
+        audio_beamform_communication_out;
+  }
+
+  /**
+   * @brief Sets the outgoing communication settings for the power map of the audio tracking module
+   * @param audio_heatmap_communication_out taylortrack::utils::CommunicationSettings to be set
+   */
+  void set_audio_heatmap_communication_out(
+      const CommunicationSettings &audio_heatmap_communication_out) {
+    ConfigParser::audio_heatmap_communication_out_ =
+        audio_heatmap_communication_out;
+  }
+
+  /**
+   * @brief Sets the communication settings for broadcasting frames to the localization workers
+   * @param audio_worker_communication_out taylortrack::utils::CommunicationSettings to be set
+   */
+  void set_audio_worker_communication_out(
+      const CommunicationSettings &audio_worker_communication_out) {
+    ConfigParser::audio_worker_communication_out_ =
+        audio_worker_communication_out;
+  }
+
+  /**
+   * @brief Sets the communication settings for receiving the results of the localization workers
+   * @param audio_worker_communication_in taylortrack::utils::CommunicationSettings to be set
+   */
+  void set_audio_worker_communication_in(
+      const CommunicationSettings &audio_worker_communication_in) {
+    ConfigParser::audio_worker_communication_in_ =
+        audio_worker_communication_in;
+  }
+
   /**
   * @brief Gets the general configuration for the algorithms
   * @pre is_valid() returns true
@@ -310,6 +382,24 @@ class ConfigParser {
     return audio_settings_;
   }
 
+  /**
+   * @brief Sets the settings shared by all input modules
+   * @param input_settings taylortrack::utils::InputSettings to be set
+   * @sa taylortrack::input::InputStrategy
+   */
+  void set_input_settings(const InputSettings &input_settings) {
+    ConfigParser::input_settings_ = input_settings;
+  }
+
+  /**
+  * @brief Gets the configuration shared by all input modules
+  * @pre is_valid() returns true
+  * @return Configuration shared by all input modules
+  */
+  const InputSettings get_input_configuration() const {
+    return input_settings_;
+  }
+
   /**
    * @brief Sets the settings for the microphone input module
    * @param microphone_input_settings taylortrack::utils::MicrophoneInputSettings to be set
@@ -347,6 +437,42 @@ class ConfigParser {
     return wave_input_settings_;
   }
 
+  /**
+   * @brief Sets the settings for the replay input module
+   * @param replay_input_settings taylortrack::utils::ReplayInputSettings to be set
+   * @sa taylortrack::input::ReplayInputStrategy
+   */
+  void set_replay_input_settings(const ReplayInputSettings &replay_input_settings) {
+    ConfigParser::replay_input_settings_ = replay_input_settings;
+  }
+
+  /**
+  * @brief Gets the configuration for the replay input module
+  * @pre is_valid() returns true
+  * @return Configuration for the replay input module
+  */
+  const ReplayInputSettings get_replay_input_configuration() const {
+    return replay_input_settings_;
+  }
+
+  /**
+   * @brief Sets the settings for the synthetic scene input module
+   * @param synthetic_input_settings taylortrack::utils::SyntheticInputSettings to be set
+   * @sa taylortrack::input::SyntheticInputStrategy
+   */
+  void set_synthetic_input_settings(const SyntheticInputSettings &synthetic_input_settings) {
+    ConfigParser::synthetic_input_settings_ = synthetic_input_settings;
+  }
+
+  /**
+  * @brief Gets the configuration for the synthetic scene input module
+  * @pre is_valid() returns true
+  * @return Configuration for the synthetic scene input module
+  */
+  const SyntheticInputSettings get_synthetic_input_configuration() const {
+    return synthetic_input_settings_;
+  }
+
   /**
   * @brief Gets the configuration for the vision tracking algorithm
   * @pre is_valid() returns true
@@ -365,6 +491,16 @@ class ConfigParser {
     return combination_settings_;
   }
 
+  /**
+  * @brief Gets the microphone arrays served by the audio tracking module
+  *
+  * Every [audio.<name>] section describes one array and starts from the values of the [audio] section.
+  * Without such sections the [audio] section describes the only array.
+  * @pre is_valid() returns true
+  * @return One session per [audio.<name>] section, or a single session named "audio" made from the [audio] section
+  */
+  std::vector<AudioSession> get_audio_sessions() const;
+
   /**
   * @brief Checks whether the configuration file is valid or not.
   * @return true if the configuration is valid, otherwise false
@@ -382,6 +518,10 @@ class ConfigParser {
   std::vector<std::string> split_microphones(std::string temporary_string);
   // signals if a config file has been parsed correctly
   bool parse_file();
+  // parses "<static|line|circle> <values...>", false if the type or the number of values is wrong
+  bool parse_source(const std::string &description, SyntheticSource *source);
+  // checks whether the settings contain a valid microphone array
+  static bool has_microphones(const AudioSettings &audio_settings);
   // signals if the configuration file is valid
   bool valid_;
   std::ifstream file_;
@@ -389,10 +529,16 @@ class ConfigParser {
   GeneralOptions general_options_;
   // struct containing the audio algorithm parameters and input port/output port
   AudioSettings audio_settings_;
+  // Contains parameters shared by all input modules
+  InputSettings input_settings_;
   // struct containing the microphone devices and audio samplerate and framesize
   MicrophoneInputSettings microphone_input_settings_;
   // Contains parameters for the wave file input
   WaveInputSettings wave_input_settings_;
+  // Contains parameters for replaying recordings
+  ReplayInputSettings replay_input_settings_;
+  // Contains parameters for the synthetic scene input
+  SyntheticInputSettings synthetic_input_settings_;
   // contains the video algorithm parameters and the input port / output port
   VideoSettings video_settings_;
   // Contains parameters for the combination of the audio and video algorithm
@@ -402,6 +548,10 @@ class ConfigParser {
                         audio_communication_in_,
                         audio_communication_out_,
                         audio_communication_destination,
+                        audio_beamform_communication_out_,
+                        audio_heatmap_communication_out_,
+                        audio_worker_communication_out_,
+                        audio_worker_communication_in_,
                         video_communication_source,
                         video_communication_in_,
                         video_communication_out_,
@@ -411,6 +561,8 @@ class ConfigParser {
                         combination_communication_out_,
                         combination_communication_destination,
                         visualizer_communication_in_;
+  // one entry per [audio.<name>] section
+  std::vector<AudioSession> audio_sessions_;
   // a vector storing all input ports for the combination module
   std::vector<CommunicationSettings> combination_inports_;
   // a vector storing all microphone input device ids
@@ -0,0 +1,128 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the fixed point Fast Fourier Transformation.
+*/
+#include "utils/fft_fixed.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace taylortrack {
+namespace utils {
+namespace {
+// butterflies grow a value by at most 1 + sqrt(2),
+// larger values might overflow within the next stage
+const int32_t kHeadroomLimit = 1 << 29;
+// rounds the Q15 twiddle products to nearest instead of down
+const int64_t kRounding = 1 << 14;
+
+int32_t peak_value(const FixedCArray &x) {
+  int32_t peak = 0;
+  for (const FixedComplex &value : x) {
+    peak = std::max(peak, std::abs(value.real));
+    peak = std::max(peak, std::abs(value.imag));
+  }
+  return peak;
+}
+}  // namespace
+
+FftFixed::FftFixed(size_t length) : length_(length) {
+  const double kPI = 3.141592653589793238460;
+  cosine_.resize(length / 2);
+  sine_.resize(length / 2);
+  for (size_t k = 0; k < length / 2; ++k) {
+    double angle = 2 * kPI * k / length;
+    cosine_[k] = static_cast<int32_t>(std::lround(cos(angle) * 32768.0));
+    sine_[k] = static_cast<int32_t>(std::lround(sin(angle) * 32768.0));
+  }
+
+  int bits = 0;
+  while ((static_cast<size_t>(1) << bits) < length)
+    ++bits;
+  bit_reversal_.resize(length);
+  for (size_t i = 0; i < length; ++i) {
+    uint32_t reversed = 0;
+    for (int bit = 0; bit < bits; ++bit)
+      reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+    bit_reversal_[i] = reversed;
+  }
+}
+
+int FftFixed::fft(FixedCArray &x) const {
+  return transform(x, false);
+}
+
+int FftFixed::ifft(FixedCArray &x) const {
+  return transform(x, true);
+}
+
+int FftFixed::transform(FixedCArray &x, bool inverse) const {
+  for (size_t i = 0; i < length_; ++i) {
+    if (i < bit_reversal_[i])
+      std::swap(x[i], x[bit_reversal_[i]]);
+  }
+
+  int shifts = 0;
+  int32_t peak = peak_value(x);
+  for (size_t half = 1; half < length_; half <<= 1) {
+    if (peak >= kHeadroomLimit) {
+      for (FixedComplex &value : x) {
+        value.real >>= 1;
+        value.imag >>= 1;
+      }
+      ++shifts;
+    }
+    peak = 0;
+    size_t twiddle_step = length_ / (2 * half);
+    for (size_t start = 0; start < length_; start += 2 * half) {
+      for (size_t k = 0; k < half; ++k) {
+        int32_t twiddle_real = cosine_[k * twiddle_step];
+        int32_t twiddle_imag = inverse ? sine_[k * twiddle_step] :
+                                         -sine_[k * twiddle_step];
+        FixedComplex &even = x[start + k];
+        FixedComplex &odd = x[start + k + half];
+        int32_t product_real = static_cast<int32_t>(
+            (static_cast<int64_t>(odd.real) * twiddle_real -
+                static_cast<int64_t>(odd.imag) * twiddle_imag + kRounding) >> 15);
+        int32_t product_imag = static_cast<int32_t>(
+            (static_cast<int64_t>(odd.real) * twiddle_imag +
+                static_cast<int64_t>(odd.imag) * twiddle_real + kRounding) >> 15);
+        odd.real = even.real - product_real;
+        odd.imag = even.imag - product_imag;
+        even.real += product_real;
+        even.imag += product_imag;
+        peak = std::max(peak, std::max(std::abs(even.real),
+                                       std::abs(even.imag)));
+        peak = std::max(peak, std::max(std::abs(odd.real),
+                                       std::abs(odd.imag)));
+      }
+    }
+  }
+  return shifts;
+}
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,130 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Fixed point Fast Fourier Transformation for targets without a fast floating point unit.
+*/
+#ifndef TAYLORTRACK_UTILS_FFT_FIXED_H_
+#define TAYLORTRACK_UTILS_FFT_FIXED_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace taylortrack {
+namespace utils {
+/**
+ * @struct FixedComplex
+ * @brief Complex number with 32 bit integer parts.
+ */
+struct FixedComplex {
+  /**
+   * @var real
+   * Real part.
+   */
+  int32_t real = 0;
+
+  /**
+   * @var imag
+   * Imaginary part.
+   */
+  int32_t imag = 0;
+};
+
+/**
+ * @typedef FixedCArray
+ * vector filled with fixed point complex values.
+ */
+typedef std::vector<FixedComplex> FixedCArray;
+
+/**
+* @class FftFixed
+* @brief Iterative radix 2 fast fourier transformation on 32 bit integers with Q15 twiddle factors.
+*
+* Uses block floating point: whenever a stage could overflow, the whole block is shifted right by one bit.
+* The number of shifts is returned so the caller can keep track of the scale.
+* Only works with signals that have a length equal to a power of two.
+* @code
+*  //Example usage:
+*  taylortrack::utils::FftFixed fft(8);
+*  taylortrack::utils::FixedCArray vec(8);
+*  vec[0].real = 16384;
+*  int exponent = fft.fft(vec);
+*  // vec now contains the spectrum divided by 2^exponent
+* @endcode
+*/
+class FftFixed {
+ public:
+  /**
+   * @brief Creates an unusable transformation of length zero
+   */
+  FftFixed() = default;
+
+  /**
+   * @brief Precomputes twiddle factors and bit reversal table
+   * @param length transformation length, has to be a power of two
+   */
+  explicit FftFixed(size_t length);
+
+  /**
+  * @brief Perform a fast fourier transformation on a signal in place.
+  * @param x Discrete signal with get_length() values.
+  * @return Number of right shifts applied, the result is the spectrum divided by 2^return value
+  */
+  int fft(FixedCArray &x) const;
+
+  /**
+  * @brief Perform an unscaled inverse fast fourier transformation on a signal in place.
+  *
+  * Unlike FftLib::ifft the result is not divided by the length.
+  * @param x Discrete spectrum with get_length() values.
+  * @return Number of right shifts applied, the result is the signal divided by 2^return value
+  */
+  int ifft(FixedCArray &x) const;
+
+  /**
+   * @brief Gets the transformation length
+   * @return number of values per transformation
+   */
+  size_t get_length() const {
+    return length_;
+  }
+
+ private:
+  // number of values per transformation
+  size_t length_ = 0;
+  // Q15 cosine of the twiddle factors, one is stored exactly as 1 << 15
+  std::vector<int32_t> cosine_;
+  // Q15 sine of the twiddle factors
+  std::vector<int32_t> sine_;
+  // index of each value after the bit reversal permutation
+  std::vector<uint32_t> bit_reversal_;
+  // shared implementation of fft and ifft
+  int transform(FixedCArray &x, bool inverse) const;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_FFT_FIXED_H_
@@ -0,0 +1,86 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the planned fast fourier transformation.
+*/
+#include "utils/fft_plan.h"
+#include <utility>
+
+namespace taylortrack {
+namespace utils {
+FftPlan::FftPlan(size_t length) : length_(length) {
+  twiddles_.resize(length / 2);
+  for (size_t k = 0; k < twiddles_.size(); ++k)
+    twiddles_[k] = std::polar(1.0, -2 * kPI * k / length);
+  reversed_.assign(length, 0);
+  int bits = 0;
+  while ((static_cast<size_t>(1) << bits) < length)
+    ++bits;
+  for (size_t n = 0; n < length; ++n) {
+    size_t reversed = 0;
+    for (int bit = 0; bit < bits; ++bit) {
+      if (n & (static_cast<size_t>(1) << bit))
+        reversed |= static_cast<size_t>(1) << (bits - 1 - bit);
+    }
+    reversed_[n] = reversed;
+  }
+}
+
+void FftPlan::fft(CArray &signal) {
+  if (signal.size() != length_) {
+    FftLib::fft(signal);
+    return;
+  }
+  for (size_t n = 0; n < length_; ++n) {
+    if (n < reversed_[n])
+      std::swap(signal[n], signal[reversed_[n]]);
+  }
+  // same butterflies as the recursive version, combining the shortest
+  // transforms first
+  for (size_t size = 2; size <= length_; size <<= 1) {
+    size_t half = size / 2;
+    size_t step = length_ / size;
+    for (size_t start = 0; start < length_; start += size) {
+      for (size_t k = 0; k < half; ++k) {
+        ComplexDouble t = twiddles_[k * step] * signal[start + half + k];
+        signal[start + half + k] = signal[start + k] - t;
+        signal[start + k] += t;
+      }
+    }
+  }
+}
+
+void FftPlan::ifft(CArray &signal) {
+  // conjugated in place, without the temporaries of FftLib::ifft()
+  for (ComplexDouble &value : signal)
+    value = std::conj(value);
+  fft(signal);
+  double length = static_cast<double>(signal.size());
+  for (ComplexDouble &value : signal)
+    value = std::conj(value) / length;
+}
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,91 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Fast Fourier Transformation with precomputed tables for one signal length.
+*/
+
+#ifndef TAYLORTRACK_UTILS_FFT_PLAN_H_
+#define TAYLORTRACK_UTILS_FFT_PLAN_H_
+
+#include <cstddef>
+#include <vector>
+#include "utils/fft_lib.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class FftPlan
+* @brief Iterative version of FftLib with twiddle factors and bit reversal computed once.
+*
+* Transforming a signal only reads the tables, so one plan may be shared by several threads.
+* Signals of another length are transformed by FftLib.
+* @code
+*  //Example usage:
+*  std::shared_ptr<taylortrack::utils::FftPlan> plan =
+*      std::make_shared<taylortrack::utils::FftPlan>(4096);
+*  taylortrack::utils::FftLib::CArray vec(4096);
+*  plan->fft(vec);
+* @endcode
+*/
+class FftPlan : public FftLib {
+ public:
+  /**
+   * @brief Precomputes the tables for a signal length.
+   * @param length signal length, has to be a power of two
+   */
+  explicit FftPlan(size_t length);
+
+  /**
+  * @brief Perform a fast fourier transformation on a signal in place.
+  * @param x Discrete audio signal.
+  */
+  void fft(CArray &x) override;
+
+  /**
+  * @brief Perform an inverse fast fourier transformation on a signal in place.
+  * @param x Spectrum of a discrete audio signal.
+  */
+  void ifft(CArray &x) override;
+
+  /**
+   * @brief Returns the signal length the tables were computed for.
+   * @return length given to the constructor
+   */
+  size_t get_length() const {
+    return length_;
+  }
+
+ private:
+  // signal length the tables were computed for
+  size_t length_;
+  // e^(-2 pi i k / length) for the first half of the bins
+  std::vector<ComplexDouble> twiddles_;
+  // target index of each sample in the bit reversed order
+  std::vector<size_t> reversed_;
+};
+}  // namespace utils
+}  // namespace taylortrack
+#endif  // TAYLORTRACK_UTILS_FFT_PLAN_H_
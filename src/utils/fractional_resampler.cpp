@@ -0,0 +1,79 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::FractionalResampler class.
+*/
+
+#include "utils/fractional_resampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace taylortrack {
+namespace utils {
+
+FractionalResampler::FractionalResampler(int channels)
+    : channels_(std::max(channels, 1)), previous_(static_cast<size_t>(std::max(channels, 1)), 0.0) {}
+
+void FractionalResampler::prime(const double *first, double phase) {
+  std::copy(first, first + channels_, previous_.begin());
+  phase_ = phase;
+}
+
+size_t FractionalResampler::get_required(size_t frames, double step) const {
+  if (frames == 0)
+    return 0;
+  // the last output needs the input after it, the next call starts at the last consumed input
+  size_t last = static_cast<size_t>(std::floor(phase_ + (frames - 1) * step)) + 1;
+  size_t consumed = static_cast<size_t>(std::floor(phase_ + frames * step));
+  return std::max(last, consumed);
+}
+
+size_t FractionalResampler::process(const SignalView &input, size_t frames, double step,
+                                    double *output, int stride) {
+  // index 0 is the last consumed frame, index j > 0 is input frame j - 1
+  auto sample = [&](size_t index, int channel) {
+    return index == 0 ? previous_[channel] : input.at(channel, static_cast<int64_t>(index - 1));
+  };
+  for (size_t frame = 0; frame < frames; ++frame) {
+    double position = phase_ + frame * step;
+    size_t index = static_cast<size_t>(position);
+    double fraction = position - index;
+    for (int channel = 0; channel < channels_; ++channel) {
+      double left = sample(index, channel);
+      double right = sample(index + 1, channel);
+      output[frame * stride + channel] = left + (right - left) * fraction;
+    }
+  }
+
+  double end = phase_ + frames * step;
+  size_t consumed = static_cast<size_t>(end);
+  for (int channel = 0; channel < channels_; ++channel)
+    previous_[channel] = sample(consumed, channel);
+  phase_ = end - consumed;
+  return consumed;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
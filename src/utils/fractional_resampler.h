@@ -0,0 +1,116 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Linear interpolating resampler with a freely adjustable fractional step.
+*/
+#ifndef TAYLORTRACK_UTILS_FRACTIONAL_RESAMPLER_H_
+#define TAYLORTRACK_UTILS_FRACTIONAL_RESAMPLER_H_
+
+#include <cstddef>
+#include <vector>
+#include "utils/signal_view.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class FractionalResampler
+* @brief Reads a multichannel stream at fractional positions that advance by a step per output sample.
+*
+* Meant for steering a stream by a few parts per million, where the rational PolyphaseResampler would need
+* enormous factors. The step can change with every call. Each output sample interpolates linearly between
+* its two neighbouring input samples, which costs two multiplications per channel. The last consumed input
+* sample is kept, so consecutive calls continue the stream without gaps.
+* @code
+*  //Example usage:
+*  taylortrack::utils::FractionalResampler resampler(2);
+*  resampler.prime(first_frame);
+*  // 2048 output samples, the input runs 20 ppm faster than the output
+*  size_t required = resampler.get_required(2048, 1.00002);
+*  // fetch required input frames into input
+*  size_t consumed = resampler.process(input, 2048, 1.00002, output.data(), 2);
+* @endcode
+*/
+class FractionalResampler {
+ public:
+  /**
+   * @brief Constructor
+   * @param channels number of interleaved channels
+   */
+  explicit FractionalResampler(int channels);
+
+  /**
+   * @brief Starts a new stream.
+   * @param first first input frame, get_channels() values
+   * @param phase fraction of an input sample between the first input frame and the first output frame
+   */
+  void prime(const double *first, double phase = 0.0);
+
+  /**
+   * @brief Returns the number of new input frames process() needs.
+   * @param frames number of output frames
+   * @param step input samples per output sample
+   * @return number of input frames
+   */
+  size_t get_required(size_t frames, double step) const;
+
+  /**
+   * @brief Produces the next output frames.
+   * @param input view on at least get_required() new input frames
+   * @param frames number of output frames
+   * @param step input samples per output sample
+   * @param output first output value, sample c of frame i is written to output[i * stride + c]
+   * @param stride number of values between two output frames
+   * @return number of input frames consumed, the remaining ones have to be passed again
+   */
+  size_t process(const SignalView &input, size_t frames, double step, double *output, int stride);
+
+  /**
+   * @brief Returns the position of the next output frame after the last consumed input frame.
+   * @return fraction of an input sample, between 0 and 1
+   */
+  double get_phase() const {
+    return phase_;
+  }
+
+  /**
+   * @brief Returns the number of channels.
+   * @return channels given to the constructor
+   */
+  int get_channels() const {
+    return channels_;
+  }
+
+ private:
+  // interleaved channels
+  int channels_;
+  // last consumed input frame
+  std::vector<double> previous_;
+  // position of the next output frame after previous_
+  double phase_ = 0.0;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_FRACTIONAL_RESAMPLER_H_
@@ -0,0 +1,73 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::MappedFile class.
+*/
+
+#include "utils/mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace taylortrack {
+namespace utils {
+
+MappedFile::MappedFile(const char *file_name) {
+  file_descriptor_ = open(file_name, O_RDONLY);
+  struct stat file_status;
+  if (file_descriptor_ >= 0 && fstat(file_descriptor_, &file_status) == 0 &&
+      file_status.st_size > 0) {
+    void *mapping = mmap(nullptr, static_cast<size_t>(file_status.st_size),
+                         PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+    if (mapping != MAP_FAILED) {
+      data_ = static_cast<const unsigned char *>(mapping);
+      size_ = static_cast<size_t>(file_status.st_size);
+      // files are streamed front to back
+      madvise(mapping, size_, MADV_SEQUENTIAL);
+    }
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (data_)
+    munmap(const_cast<unsigned char *>(data_), size_);
+  if (file_descriptor_ >= 0)
+    close(file_descriptor_);
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+  if (!data_ || offset >= size_)
+    return;
+  // the range has to start at a page boundary
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t start = offset / page_size * page_size;
+  length = std::min(length + (offset - start), size_ - start);
+  madvise(const_cast<unsigned char *>(data_) + start, length, MADV_WILLNEED);
+}
+
+}  // namespace utils
+}  // namespace taylortrack
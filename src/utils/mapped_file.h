@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::MappedFile class.
+*/
+
+#ifndef TAYLORTRACK_UTILS_MAPPED_FILE_H_
+#define TAYLORTRACK_UTILS_MAPPED_FILE_H_
+
+#include <cstddef>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class MappedFile
+* @brief Maps a whole file read only into memory.
+*
+* The file stays mapped as long as the object exists. Files are usually read front to back, so the kernel is told
+* to read ahead aggressively and to drop the pages that were read.
+* @code
+* // Example usage:
+* taylortrack::utils::MappedFile file("../Testdata/Test.txt");
+* if (file.is_open()) {
+*   // ask the kernel to load the first megabyte in the background
+*   file.prefetch(0, 1 << 20);
+*   unsigned char first_byte = file.data()[0];
+* }
+* @endcode
+*/
+class MappedFile {
+ public:
+  /**
+  * @brief Opens and maps the file
+  * @param file_name Path to the file to be mapped.
+  */
+  explicit MappedFile(const char *file_name);
+
+  /**
+   * @brief Remove copy constructor
+   */
+  MappedFile(const MappedFile &that) = delete;
+
+  /**
+   * @brief Destructor
+   *
+   * Unmaps and closes the file
+   */
+  ~MappedFile();
+
+  /**
+  * @brief Checks whether the file could be opened and mapped
+  * @return true if the file is mapped, false if it does not exist or is empty
+  */
+  bool is_open() const {
+    return data_ != nullptr;
+  }
+
+  /**
+  * @brief Gets the first byte of the file
+  * @return pointer to the mapped file, nullptr if it is not open
+  */
+  const unsigned char *data() const {
+    return data_;
+  }
+
+  /**
+  * @brief Gets the size of the file
+  * @return number of mapped bytes
+  */
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+  * @brief Asks the kernel to load part of the file in the background
+  * @param offset first byte to load, does not need to be page aligned
+  * @param length number of bytes to load, ranges past the end of the file are cut
+  */
+  void prefetch(size_t offset, size_t length) const;
+
+ private:
+  // descriptor of the file, -1 if it could not be opened
+  int file_descriptor_ = -1;
+  // the whole file mapped into memory, nullptr if mapping failed
+  const unsigned char *data_ = nullptr;
+  // number of mapped bytes
+  size_t size_ = 0;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_MAPPED_FILE_H_
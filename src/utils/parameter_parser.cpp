@@ -70,6 +70,14 @@ Parameters parse_streamer(int argc,
             parameters.config = argv[i];
           }
           break;
+          // recording of the streamed frames
+        case 'r':
+          if (++i >= argc) {
+            parameters.valid = false;
+          } else {
+            parameters.record = argv[i];
+          }
+          break;
 
         default:
           parameters.valid = false;
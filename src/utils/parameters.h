@@ -45,6 +45,12 @@ namespace taylortrack {
        * Path to the config file.
        */
       const char *config = "../conf/real_config.conf";
+
+      /**
+       * @var record
+       * Path to the file the streamed frames are recorded to, nullptr records nothing.
+       */
+      const char *record = nullptr;
     };
   } // namespace utils
 } // namespace taylortrack
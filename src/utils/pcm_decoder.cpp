@@ -0,0 +1,153 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the wave sample decoders.
+*/
+
+#include "utils/pcm_decoder.h"
+#include <cstring>
+
+namespace taylortrack {
+namespace utils {
+
+namespace {
+// format codes of the fmt chunk
+const int kFormatPcm = 0x0001;
+const int kFormatFloat = 0x0003;
+
+void decode_pcm8(const unsigned char *input, int64_t count, double *output) {
+  // 8 bit samples are unsigned with 128 as silence
+  const double scale = 1.0 / 127.0;
+  for (int64_t i = 0; i < count; ++i)
+    output[i] = (static_cast<int>(input[i]) - 128) * scale;
+}
+
+void decode_pcm16(const unsigned char *input, int64_t count, double *output) {
+  const double scale = 1.0 / 32767.0;
+  for (int64_t i = 0; i < count; ++i) {
+    const unsigned char *sample = input + 2 * i;
+    int16_t value = static_cast<int16_t>(sample[0] | (sample[1] << 8));
+    output[i] = value * scale;
+  }
+}
+
+void decode_pcm24(const unsigned char *input, int64_t count, double *output) {
+  const double scale = 1.0 / 8388607.0;
+  for (int64_t i = 0; i < count; ++i) {
+    const unsigned char *sample = input + 3 * i;
+    // place the sample in the upper bytes so the shift extends the sign
+    int32_t value = static_cast<int32_t>((static_cast<uint32_t>(sample[0]) << 8) |
+        (static_cast<uint32_t>(sample[1]) << 16) |
+        (static_cast<uint32_t>(sample[2]) << 24)) >> 8;
+    output[i] = value * scale;
+  }
+}
+
+void decode_pcm32(const unsigned char *input, int64_t count, double *output) {
+  const double scale = 1.0 / 2147483647.0;
+  for (int64_t i = 0; i < count; ++i) {
+    const unsigned char *sample = input + 4 * i;
+    int32_t value = static_cast<int32_t>(static_cast<uint32_t>(sample[0]) |
+        (static_cast<uint32_t>(sample[1]) << 8) |
+        (static_cast<uint32_t>(sample[2]) << 16) |
+        (static_cast<uint32_t>(sample[3]) << 24));
+    output[i] = value * scale;
+  }
+}
+
+void decode_float32(const unsigned char *input, int64_t count, double *output) {
+  for (int64_t i = 0; i < count; ++i) {
+    const unsigned char *sample = input + 4 * i;
+    uint32_t bits = static_cast<uint32_t>(sample[0]) |
+        (static_cast<uint32_t>(sample[1]) << 8) |
+        (static_cast<uint32_t>(sample[2]) << 16) |
+        (static_cast<uint32_t>(sample[3]) << 24);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    output[i] = value;
+  }
+}
+}  // namespace
+
+SampleEncoding get_sample_encoding(int audio_format, int bits_per_sample) {
+  if (audio_format == kFormatPcm) {
+    switch (bits_per_sample) {
+      case 8:
+        return SampleEncoding::kPcm8;
+      case 16:
+        return SampleEncoding::kPcm16;
+      case 24:
+        return SampleEncoding::kPcm24;
+      case 32:
+        return SampleEncoding::kPcm32;
+      default:
+        return SampleEncoding::kUnsupported;
+    }
+  }
+  if (audio_format == kFormatFloat && bits_per_sample == 32)
+    return SampleEncoding::kFloat32;
+  return SampleEncoding::kUnsupported;
+}
+
+int get_sample_size(SampleEncoding encoding) {
+  switch (encoding) {
+    case SampleEncoding::kPcm8:
+      return 1;
+    case SampleEncoding::kPcm16:
+      return 2;
+    case SampleEncoding::kPcm24:
+      return 3;
+    case SampleEncoding::kPcm32:
+    case SampleEncoding::kFloat32:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+void decode_samples(SampleEncoding encoding, const unsigned char *input, int64_t count, double *output) {
+  switch (encoding) {
+    case SampleEncoding::kPcm8:
+      decode_pcm8(input, count, output);
+      break;
+    case SampleEncoding::kPcm16:
+      decode_pcm16(input, count, output);
+      break;
+    case SampleEncoding::kPcm24:
+      decode_pcm24(input, count, output);
+      break;
+    case SampleEncoding::kPcm32:
+      decode_pcm32(input, count, output);
+      break;
+    case SampleEncoding::kFloat32:
+      decode_float32(input, count, output);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace utils
+}  // namespace taylortrack
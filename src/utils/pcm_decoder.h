@@ -0,0 +1,85 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Decoding of raw PCM and floating point wave samples.
+*/
+
+#ifndef TAYLORTRACK_UTILS_PCM_DECODER_H_
+#define TAYLORTRACK_UTILS_PCM_DECODER_H_
+
+#include <cstdint>
+
+namespace taylortrack {
+namespace utils {
+/**
+ * @enum SampleEncoding
+ * @brief Sample encodings the decoders can turn into doubles.
+ */
+enum class SampleEncoding {
+  kUnsupported,
+  kPcm8,
+  kPcm16,
+  kPcm24,
+  kPcm32,
+  kFloat32
+};
+
+/**
+ * @brief Determines the sample encoding of a wave file.
+ * @param audio_format format code of the fmt chunk, for WAVE_FORMAT_EXTENSIBLE the code of the sub format
+ * @param bits_per_sample size of a sample within the file in bits
+ * @return the encoding, kUnsupported if there is no decoder for it
+ */
+SampleEncoding get_sample_encoding(int audio_format, int bits_per_sample);
+
+/**
+ * @brief Gets the size of a single encoded sample.
+ * @param encoding the sample encoding
+ * @return number of bytes of a sample, 0 for kUnsupported
+ */
+int get_sample_size(SampleEncoding encoding);
+
+/**
+ * @brief Decodes little endian samples into doubles in a single pass.
+ *
+ * Integer samples are scaled by their largest positive value, so full scale maps to about -1.0 to 1.0 like the
+ * 16 bit samples always did. Floating point samples are taken as they are. The loops work on plain bytes, so the
+ * input needs no alignment, and have no dependencies between iterations, so the compiler can vectorize them.
+ * @code
+ * // Example usage:
+ * // decode 2048 frames of a 4 channel recording with 24 bits per sample
+ * std::vector<double> samples(4 * 2048);
+ * taylortrack::utils::decode_samples(taylortrack::utils::SampleEncoding::kPcm24, bytes, 4 * 2048, samples.data());
+ * @endcode
+ * @param encoding encoding of the input samples
+ * @param input first byte of the first sample
+ * @param count number of samples to decode
+ * @param output array with space for count doubles
+ */
+void decode_samples(SampleEncoding encoding, const unsigned char *input, int64_t count, double *output);
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_PCM_DECODER_H_
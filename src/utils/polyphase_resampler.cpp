@@ -0,0 +1,147 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the polyphase sample rate converter.
+*/
+#include "utils/polyphase_resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace taylortrack {
+namespace utils {
+namespace {
+// modified bessel function of the first kind and order zero
+double bessel_i0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+int greatest_common_divisor(int a, int b) {
+  while (b != 0) {
+    int rest = a % b;
+    a = b;
+    b = rest;
+  }
+  return a;
+}
+}  // namespace
+
+PolyphaseResampler::PolyphaseResampler(int input_rate, int output_rate,
+                                       int channels, int taps_per_phase)
+    : channels_(channels), taps_(std::max(1, taps_per_phase)) {
+  int divisor = greatest_common_divisor(input_rate, output_rate);
+  interpolation_ = output_rate / divisor;
+  decimation_ = input_rate / divisor;
+
+  // kaiser windowed sinc at the upsampled rate, cut off a little below the
+  // lower of both nyquist frequencies
+  const double kPI = 3.141592653589793238460;
+  const double kBeta = 8.0;
+  const double kRolloff = 0.9;
+  int length = interpolation_ * taps_;
+  double cutoff = kRolloff * 0.5 / std::max(interpolation_, decimation_);
+  double center = (length - 1) / 2.0;
+  std::vector<double> prototype(static_cast<size_t>(length));
+  for (int k = 0; k < length; ++k) {
+    double t = k - center;
+    double sinc = t == 0.0 ? 1.0 : sin(2 * kPI * cutoff * t) / (2 * kPI * cutoff * t);
+    double ratio = center > 0.0 ? t / center : 0.0;
+    double window = bessel_i0(kBeta * sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+                    bessel_i0(kBeta);
+    // the gain of interpolation_ makes up for the inserted zeros
+    prototype[k] = 2 * cutoff * sinc * window * interpolation_;
+  }
+
+  coefficients_.resize(static_cast<size_t>(length));
+  for (int phase = 0; phase < interpolation_; ++phase) {
+    for (int i = 0; i < taps_; ++i)
+      coefficients_[phase * taps_ + i] =
+          prototype[phase + (taps_ - 1 - i) * interpolation_];
+  }
+  reset();
+}
+
+void PolyphaseResampler::reset() {
+  history_.assign(static_cast<size_t>(channels_),
+                  std::vector<double>(static_cast<size_t>(taps_ - 1), 0.0));
+  phase_ = 0;
+  next_input_ = 0;
+}
+
+void PolyphaseResampler::process(const SignalView &input,
+                                 std::vector<double> *output) {
+  int64_t length = input.length;
+  size_t kept = static_cast<size_t>(taps_ - 1);
+
+  // output positions are the same for every channel
+  int64_t count = 0;
+  int phase = phase_;
+  int64_t position = next_input_;
+  while (position < length) {
+    ++count;
+    phase += decimation_;
+    position += phase / interpolation_;
+    phase %= interpolation_;
+  }
+  output->resize(static_cast<size_t>(count * channels_));
+
+  for (int channel = 0; channel < channels_; ++channel) {
+    std::vector<double> &history = history_[channel];
+    history.resize(kept + static_cast<size_t>(length));
+    for (int64_t n = 0; n < length; ++n)
+      history[kept + n] = input.at(channel, n);
+
+    phase = phase_;
+    position = next_input_;
+    double *out = output->data() + channel;
+    for (int64_t m = 0; m < count; ++m) {
+      // the window ending at input sample position starts at history[position]
+      const double *samples = &history[static_cast<size_t>(position)];
+      const double *taps = &coefficients_[static_cast<size_t>(phase) * taps_];
+      double sum = 0.0;
+      for (int i = 0; i < taps_; ++i)
+        sum += taps[i] * samples[i];
+      out[m * channels_] = sum;
+      phase += decimation_;
+      position += phase / interpolation_;
+      phase %= interpolation_;
+    }
+
+    // keeping the last input samples for the next frame
+    std::copy(history.end() - kept, history.end(), history.begin());
+    history.resize(kept);
+  }
+  phase_ = phase;
+  next_input_ = position - length;
+}
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,125 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Rational polyphase sample rate converter for interleaved multichannel streams.
+*/
+#ifndef TAYLORTRACK_UTILS_POLYPHASE_RESAMPLER_H_
+#define TAYLORTRACK_UTILS_POLYPHASE_RESAMPLER_H_
+
+#include <cstdint>
+#include <vector>
+#include "utils/signal_view.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class PolyphaseResampler
+* @brief Converts a stream from one sample rate to another with a windowed sinc polyphase FIR filter.
+*
+* The rate ratio is reduced to output / input = L / M. Only the L phases of the prototype filter are
+* stored, each output sample costs one dot product of taps_per_phase coefficients per channel.
+* Filter state is kept between calls, so consecutive frames of a stream are converted without gaps.
+* The added latency is the group delay of the filter, about taps_per_phase / 2 input samples.
+* @code
+*  //Example usage:
+*  // 4 channels from 44.1 kHz down to 16 kHz
+*  taylortrack::utils::PolyphaseResampler resampler(44100, 16000, 4);
+*  std::vector<double> decimated;
+*  resampler.process(frame, &decimated);
+*  taylortrack::utils::SignalView decimated_frame(decimated.data(), 4, 4, decimated.size() / 4);
+* @endcode
+*/
+class PolyphaseResampler {
+ public:
+  /**
+   * @brief Designs the filter and clears the stream state.
+   * @param input_rate sample rate of the incoming stream
+   * @param output_rate sample rate of the produced stream
+   * @param channels number of interleaved channels
+   * @param taps_per_phase length of each polyphase branch
+   */
+  PolyphaseResampler(int input_rate, int output_rate, int channels,
+                     int taps_per_phase = 32);
+
+  /**
+   * @brief Converts the next frame of the stream.
+   * @param input view on the next interleaved input frame, has to contain get_channels() channels
+   * @param output receives the interleaved converted samples, the number of samples per channel varies by one between frames
+   */
+  void process(const SignalView &input, std::vector<double> *output);
+
+  /**
+   * @brief Clears the filter state to start a new stream.
+   */
+  void reset();
+
+  /**
+   * @brief Returns the upsampling factor L of the reduced ratio.
+   * @return upsampling factor
+   */
+  int get_interpolation() const {
+    return interpolation_;
+  }
+
+  /**
+   * @brief Returns the downsampling factor M of the reduced ratio.
+   * @return downsampling factor
+   */
+  int get_decimation() const {
+    return decimation_;
+  }
+
+  /**
+   * @brief Returns the number of channels.
+   * @return number of interleaved channels
+   */
+  int get_channels() const {
+    return channels_;
+  }
+
+ private:
+  // upsampling factor
+  int interpolation_;
+  // downsampling factor
+  int decimation_;
+  // number of channels
+  int channels_;
+  // number of taps of each phase
+  int taps_;
+  // coefficients of all phases, phase p starts at p * taps_, stored in
+  // reverse order so they line up with the ascending history
+  std::vector<double> coefficients_;
+  // last taps_ - 1 input samples of each channel followed by the current frame
+  std::vector<std::vector<double>> history_;
+  // phase of the next output sample
+  int phase_ = 0;
+  // input index of the next output sample relative to the current frame
+  int64_t next_input_ = 0;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_POLYPHASE_RESAMPLER_H_
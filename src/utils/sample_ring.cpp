@@ -0,0 +1,90 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::SampleRing class.
+*/
+
+#include "utils/sample_ring.h"
+#include <algorithm>
+
+namespace taylortrack {
+namespace utils {
+
+SampleRing::SampleRing(int channels, size_t frames)
+    : channels_(std::max(channels, 1)), capacity_(1), read_position_(0), write_position_(0), overruns_(0) {
+  // positions are mapped to slots with a mask
+  while (capacity_ < frames)
+    capacity_ *= 2;
+  samples_.resize(capacity_ * channels_);
+}
+
+bool SampleRing::write(const float *const *input, size_t frames) {
+  size_t write = write_position_.load(std::memory_order_relaxed);
+  size_t read = read_position_.load(std::memory_order_acquire);
+  if (capacity_ - (write - read) < frames) {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  for (size_t frame = 0; frame < frames; ++frame) {
+    float *slot = &samples_[((write + frame) & (capacity_ - 1)) * channels_];
+    for (int channel = 0; channel < channels_; ++channel)
+      slot[channel] = input[channel][frame];
+  }
+  write_position_.store(write + frames, std::memory_order_release);
+  return true;
+}
+
+size_t SampleRing::get_available() const {
+  return write_position_.load(std::memory_order_acquire) - read_position_.load(std::memory_order_relaxed);
+}
+
+bool SampleRing::read(size_t frames, double *output, int stride) {
+  return peek(frames, output, stride) && skip(frames);
+}
+
+bool SampleRing::peek(size_t frames, double *output, int stride) const {
+  size_t read = read_position_.load(std::memory_order_relaxed);
+  size_t write = write_position_.load(std::memory_order_acquire);
+  if (write - read < frames)
+    return false;
+  for (size_t frame = 0; frame < frames; ++frame) {
+    const float *slot = &samples_[((read + frame) & (capacity_ - 1)) * channels_];
+    for (int channel = 0; channel < channels_; ++channel)
+      output[frame * stride + channel] = slot[channel];
+  }
+  return true;
+}
+
+bool SampleRing::skip(size_t frames) {
+  size_t read = read_position_.load(std::memory_order_relaxed);
+  size_t write = write_position_.load(std::memory_order_acquire);
+  if (write - read < frames)
+    return false;
+  read_position_.store(read + frames, std::memory_order_release);
+  return true;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
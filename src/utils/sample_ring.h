@@ -0,0 +1,173 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Wait-free ring of multichannel sample frames for one producer and one consumer thread.
+*/
+#ifndef TAYLORTRACK_UTILS_SAMPLE_RING_H_
+#define TAYLORTRACK_UTILS_SAMPLE_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class SampleRing
+* @brief Fixed capacity ring buffer passing blocks of sample frames from exactly one producer to exactly one consumer.
+*
+* Made for audio callbacks: writing never allocates, locks or waits. The producer hands over whole periods of
+* non-interleaved channels, the consumer takes any number of frames and interleaves them into its own buffer, so
+* the period size of the device does not need to match the frame size of the analysis. A period that does not
+* fit is dropped as a whole and counted as overrun. All storage is allocated in the constructor.
+* @code
+*  //Example usage:
+*  taylortrack::utils::SampleRing ring(4, 8192);
+*  // audio callback with 4 non-interleaved channels of 256 samples each
+*  ring.write(channels, 256);
+*  // consumer thread, interleaves a frame of 2048 samples per channel
+*  std::vector<double> frame(4 * 2048);
+*  if (ring.get_available() >= 2048)
+*    ring.read(2048, frame.data(), 4);
+* @endcode
+*/
+class SampleRing {
+ public:
+  /**
+   * @brief Allocates room for the given number of frames.
+   * @param channels number of samples per frame
+   * @param frames minimum number of frames the ring holds, rounded up to a power of two
+   */
+  SampleRing(int channels, size_t frames);
+
+  SampleRing(const SampleRing &) = delete;
+  SampleRing &operator=(const SampleRing &) = delete;
+
+  /**
+   * @brief Appends a period of samples, may only be called by the producer thread.
+   * @param input one array of samples per channel
+   * @param frames number of samples per channel
+   * @return false if the period did not fit and was dropped
+   */
+  bool write(const float *const *input, size_t frames);
+
+  /**
+   * @brief Counts the frames ready for reading, may only be called by the consumer thread.
+   * @return number of frames written and not read yet
+   */
+  size_t get_available() const;
+
+  /**
+   * @brief Removes the oldest frames, may only be called by the consumer thread.
+   *
+   * Sample c of frame i is stored at output[i * stride + c], so the frames of several rings can be
+   * interleaved into one buffer.
+   * @param frames number of frames to read
+   * @param output first value to write
+   * @param stride number of values between two frames in output
+   * @return false if fewer frames are available, nothing is read then
+   */
+  bool read(size_t frames, double *output, int stride);
+
+  /**
+   * @brief Copies the oldest frames like read() but leaves them in the ring, may only be called by the consumer thread.
+   * @param frames number of frames to copy
+   * @param output first value to write
+   * @param stride number of values between two frames in output
+   * @return false if fewer frames are available, nothing is copied then
+   */
+  bool peek(size_t frames, double *output, int stride) const;
+
+  /**
+   * @brief Removes the oldest frames without copying them, may only be called by the consumer thread.
+   * @param frames number of frames to remove
+   * @return false if fewer frames are available, nothing is removed then
+   */
+  bool skip(size_t frames);
+
+  /**
+   * @brief Returns the number of frames read or skipped since construction, may only be called by the consumer thread.
+   * @return position of the oldest frame in the ring
+   */
+  size_t get_read_position() const {
+    return read_position_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the number of frames written since construction, may only be called by the producer thread.
+   * @return position the next written frame gets
+   */
+  size_t get_write_position() const {
+    return write_position_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Counts the periods dropped because the ring was full.
+   * @return number of failed write() calls
+   */
+  uint64_t get_overruns() const {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Returns the number of samples per frame.
+   * @return channels given to the constructor
+   */
+  int get_channels() const {
+    return channels_;
+  }
+
+  /**
+   * @brief Returns the maximum number of frames in the ring.
+   * @return capacity in frames
+   */
+  size_t get_capacity() const {
+    return capacity_;
+  }
+
+ private:
+  // samples per frame
+  int channels_;
+  // frames the ring holds, a power of two
+  size_t capacity_;
+  // interleaved samples of all frames
+  std::vector<float> samples_;
+  // the ring lives on the heap, where C++11 does not honor alignas, so the positions
+  // are kept on separate cache lines by padding
+  char read_padding_[64];
+  // number of frames read since construction, written by the consumer only
+  std::atomic<size_t> read_position_;
+  char write_padding_[64];
+  // number of frames written since construction, written by the producer only
+  std::atomic<size_t> write_position_;
+  char overrun_padding_[64];
+  // number of dropped periods
+  std::atomic<uint64_t> overruns_;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_SAMPLE_RING_H_
@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Non-owning view on an interleaved multichannel frame.
+*/
+#ifndef TAYLORTRACK_UTILS_SIGNAL_VIEW_H_
+#define TAYLORTRACK_UTILS_SIGNAL_VIEW_H_
+
+#include <cstdint>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @struct BasicSignalView
+* @brief Describes a frame of multichannel samples without owning them.
+*
+* Sample i of channel c is stored at data[i * stride + c]. For plain interleaved frames the stride
+* equals the number of channels, larger strides allow skipping channels that are not used.
+* @code
+* // Example usage:
+* // wrap an interleaved buffer of 4 channels with 2049 samples each
+* std::vector<double> buffer(4 * 2049);
+* taylortrack::utils::SignalView frame(buffer.data(), 4, 4, 2049);
+* double first_sample_of_second_channel = frame.at(1, 0);
+* @endcode
+*/
+template <typename T> struct BasicSignalView {
+  /**
+   * @var data
+   * Pointer to the first sample of the first channel.
+   */
+  const T *data = nullptr;
+
+  /**
+   * @var channels
+   * Number of channels within the frame.
+   */
+  int channels = 0;
+
+  /**
+   * @var stride
+   * Number of values between two consecutive samples of the same channel.
+   */
+  int stride = 0;
+
+  /**
+   * @var length
+   * Number of samples per channel.
+   */
+  int64_t length = 0;
+
+  /**
+   * @brief Creates an empty view
+   */
+  BasicSignalView() = default;
+
+  /**
+   * @brief Creates a view on an existing buffer
+   * @param data pointer to the first sample of the first channel
+   * @param channels number of channels within the frame
+   * @param stride number of values between two consecutive samples of the same channel
+   * @param length number of samples per channel
+   */
+  BasicSignalView(const T *data, int channels, int stride, int64_t length)
+      : data(data), channels(channels), stride(stride), length(length) {}
+
+  /**
+   * @brief Accesses a single sample
+   * @param channel index of the channel
+   * @param sample index of the sample within the channel
+   * @return the requested sample
+   */
+  const T &at(int channel, int64_t sample) const {
+    return data[sample * stride + channel];
+  }
+};
+
+/**
+ * @typedef SignalView
+ * View on a frame of double samples.
+ */
+typedef BasicSignalView<double> SignalView;
+
+/**
+ * @typedef Pcm16View
+ * View on a frame of raw 16 bit PCM samples.
+ */
+typedef BasicSignalView<int16_t> Pcm16View;
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_SIGNAL_VIEW_H_
@@ -0,0 +1,139 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Bounded lock-free queue for one producer and one consumer thread.
+*/
+#ifndef TAYLORTRACK_UTILS_SPSC_QUEUE_H_
+#define TAYLORTRACK_UTILS_SPSC_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class SpscQueue
+* @brief Fixed capacity ring buffer passing values from exactly one producer thread to exactly one consumer thread.
+*
+* Neither side ever blocks or locks, a full or empty queue is reported to the caller instead.
+* All storage is allocated in the constructor.
+* @code
+*  //Example usage:
+*  taylortrack::utils::SpscQueue<int> queue(4);
+*  // producer thread
+*  while (!queue.try_push(42))
+*    std::this_thread::yield();
+*  // consumer thread
+*  int value;
+*  while (!queue.try_pop(&value))
+*    std::this_thread::yield();
+* @endcode
+*/
+template<class T>
+class SpscQueue {
+ public:
+  /**
+   * @brief Allocates room for capacity values.
+   * @param capacity maximum number of values in the queue, values below one are treated as one
+   */
+  explicit SpscQueue(size_t capacity)
+      : slots_(std::max<size_t>(capacity, 1) + 1), head_(0), tail_(0) {
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  /**
+   * @brief Appends a value, may only be called by the producer thread.
+   * @param value value to copy or move into the queue, left untouched if the queue is full
+   * @return false if the queue is full and the value was not added
+   */
+  template<class U>
+  bool try_push(U &&value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t next = advance(tail);
+    if (next == head_.load(std::memory_order_acquire))
+      return false;
+    slots_[tail] = std::forward<U>(value);
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest value, may only be called by the consumer thread.
+   * @param value receives the removed value
+   * @return false if the queue is empty and value was not changed
+   */
+  bool try_pop(T *value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return false;
+    *value = std::move(slots_[head]);
+    head_.store(advance(head), std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Checks whether the queue holds no values.
+   *
+   * Only a snapshot when called while the other side is active.
+   * @return true if the queue is empty, false otherwise.
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the maximum number of values in the queue.
+   * @return capacity given to the constructor
+   */
+  size_t get_capacity() const {
+    return slots_.size() - 1;
+  }
+
+ private:
+  // one slot more than the capacity, so full and empty can be told apart
+  std::vector<T> slots_;
+  // the indices are kept on separate cache lines by padding, which unlike alignas
+  // also holds for queues allocated with new
+  char head_padding_[64];
+  // index of the oldest value, written by the consumer only
+  std::atomic<size_t> head_;
+  char tail_padding_[64];
+  // index of the next free slot, written by the producer only
+  std::atomic<size_t> tail_;
+
+  size_t advance(size_t index) const {
+    return index + 1 == slots_.size() ? 0 : index + 1;
+  }
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_SPSC_QUEUE_H_
@@ -0,0 +1,162 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::StreamAligner class.
+*/
+
+#include "utils/stream_aligner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace taylortrack {
+namespace utils {
+
+namespace {
+// share of the remaining offset corrected over the next frame
+const double kCorrectionGain = 0.1;
+
+// largest step change of the correction, 500 ppm
+const double kMaxCorrection = 0.0005;
+
+// fraction of a sample treated as a rounding error
+const double kRoundingTolerance = 0.000001;
+}  // namespace
+
+StreamAligner::StreamAligner(const std::vector<int> &channels, const std::vector<int> &delays,
+                             double sample_rate) {
+  for (size_t i = 0; i < channels.size(); ++i) {
+    Device device = {ClockDriftEstimator(sample_rate), FractionalResampler(channels[i]), channels_,
+                     i < delays.size() ? delays[i] : 0, std::vector<double>()};
+    devices_.push_back(device);
+    channels_ += channels[i];
+  }
+}
+
+void StreamAligner::add_stamp(int device, const CaptureStamp &stamp) {
+  devices_[device].clock.add_stamp(stamp.position, stamp.time);
+}
+
+double StreamAligner::get_read_position(int device, const SampleRing &ring) const {
+  // the resampler keeps the last consumed sample, the next output lies behind it
+  return static_cast<double>(ring.get_read_position()) - 1.0 + devices_[device].resampler.get_phase();
+}
+
+bool StreamAligner::start(const std::vector<SampleRing *> &rings) {
+  for (const Device &device : devices_) {
+    if (!device.clock.has_stamps())
+      return false;
+  }
+
+  // the first time all devices have recorded a sample for
+  double time = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    double position = static_cast<double>(rings[i]->get_read_position() + devices_[i].delay);
+    time = std::max(time, devices_[i].clock.get_time(position));
+  }
+  // the reference starts at a whole sample, rounding errors of the mapping are ignored
+  const Device &reference = devices_[0];
+  double reference_position = std::ceil(reference.clock.get_position(time) - reference.delay - kRoundingTolerance);
+  time = reference.clock.get_time(reference_position + reference.delay);
+
+  std::vector<double> positions(devices_.size(), reference_position);
+  for (size_t i = 1; i < devices_.size(); ++i)
+    positions[i] = devices_[i].clock.get_position(time) - devices_[i].delay;
+  std::vector<size_t> first(devices_.size());
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    positions[i] = std::max(positions[i], static_cast<double>(rings[i]->get_read_position()));
+    first[i] = static_cast<size_t>(positions[i]);
+    if (rings[i]->get_available() < first[i] - rings[i]->get_read_position() + 1)
+      return false;
+  }
+
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    Device &device = devices_[i];
+    device.input.resize(static_cast<size_t>(device.resampler.get_channels()));
+    rings[i]->skip(first[i] - rings[i]->get_read_position());
+    rings[i]->peek(1, device.input.data(), device.resampler.get_channels());
+    rings[i]->skip(1);
+    device.resampler.prime(device.input.data(), i == 0 ? 0.0 : positions[i] - first[i]);
+  }
+  started_ = true;
+  return true;
+}
+
+bool StreamAligner::read_frame(const std::vector<SampleRing *> &rings, size_t frames, double *output) {
+  if (!started_ && !start(rings))
+    return false;
+
+  // capture time of the first sample of the frame, given by the reference
+  const Device &reference = devices_[0];
+  double time = reference.clock.get_time(get_read_position(0, *rings[0]) + reference.delay);
+
+  std::vector<double> steps(devices_.size(), 1.0);
+  std::vector<size_t> required(devices_.size());
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    Device &device = devices_[i];
+    if (i > 0) {
+      // the faster a device runs, the more of its samples make up a frame
+      steps[i] = device.clock.get_rate() / reference.clock.get_rate();
+      double offset = device.clock.get_position(time) - device.delay - get_read_position(i, *rings[i]);
+      if (std::fabs(offset) > frames) {
+        // the stamps jumped, the devices are aligned from scratch
+        started_ = false;
+        return false;
+      }
+      // the remaining offset is spread over the next frames, slow enough to leave the pitch alone
+      double correction = kCorrectionGain * offset / frames;
+      steps[i] += std::max(-kMaxCorrection, std::min(kMaxCorrection, correction));
+    }
+    required[i] = device.resampler.get_required(frames, steps[i]);
+    if (rings[i]->get_available() < required[i])
+      return false;
+  }
+
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    Device &device = devices_[i];
+    int channels = device.resampler.get_channels();
+    device.input.resize(required[i] * channels);
+    rings[i]->peek(required[i], device.input.data(), channels);
+    SignalView input(device.input.data(), channels, channels, static_cast<int64_t>(required[i]));
+    size_t consumed = device.resampler.process(input, frames, steps[i], output + device.first_channel, channels_);
+    rings[i]->skip(consumed);
+  }
+  return true;
+}
+
+void StreamAligner::restart(const std::vector<SampleRing *> &rings) {
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    rings[i]->skip(rings[i]->get_available());
+    devices_[i].clock.reset(static_cast<double>(rings[i]->get_read_position()));
+  }
+  started_ = false;
+}
+
+double StreamAligner::get_drift(int device) const {
+  return (devices_[device].clock.get_rate() / devices_[0].clock.get_rate() - 1.0) * 1e6;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,168 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::StreamAligner class.
+*/
+
+#ifndef TAYLORTRACK_UTILS_STREAM_ALIGNER_H_
+#define TAYLORTRACK_UTILS_STREAM_ALIGNER_H_
+
+#include <cstddef>
+#include <vector>
+#include "utils/clock_drift_estimator.h"
+#include "utils/fractional_resampler.h"
+#include "utils/sample_ring.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+ * @struct CaptureStamp
+ * @brief Capture time of a recorded period.
+ */
+struct CaptureStamp {
+  /**
+   * @var position
+   * Position of the first sample of the period within the ring of its device.
+   */
+  double position = 0.0;
+
+  /**
+   * @var time
+   * Capture time of the first sample in seconds.
+   */
+  double time = 0.0;
+};
+
+/**
+* @class StreamAligner
+* @brief Merges the recordings of several audio devices into sample aligned frames.
+*
+* Every device runs on its own clock. The capture times of the recorded periods tell each device's actual sample
+* rate and the capture time of each of its samples. The first device is the reference, its samples are passed
+* through unchanged. All other devices are read by a FractionalResampler at the positions captured at the same
+* time as the reference samples, so start offsets and clock drift between the devices are removed. Remaining
+* offsets are corrected by slightly changing the step over the following frames. The configured delays shift
+* the devices on top of that.
+* @code
+* // Example usage:
+* // two devices with 2 channels each, the second one is delayed by 3 samples
+* taylortrack::utils::StreamAligner aligner({2, 2}, {0, 3}, 44100.0);
+* // for every stamp the audio callbacks recorded
+* aligner.add_stamp(device, stamp);
+* // frames of 2048 samples of all 4 channels
+* std::vector<double> frame(4 * 2048);
+* if (aligner.read_frame(rings, 2048, frame.data())) {
+*   // frame holds aligned samples
+* }
+* @endcode
+*/
+class StreamAligner {
+ public:
+  /**
+   * @brief Constructor
+   * @param channels number of channels of every device, the first device is the reference
+   * @param delays number of samples every device is delayed by, missing values are 0
+   * @param sample_rate nominal sample rate of all devices
+   */
+  StreamAligner(const std::vector<int> &channels, const std::vector<int> &delays, double sample_rate);
+
+  /**
+   * @brief Adds the capture time of a recorded period
+   * @param device index of the device
+   * @param stamp ring position and capture time of the first sample of the period
+   */
+  void add_stamp(int device, const CaptureStamp &stamp);
+
+  /**
+   * @brief Reads the next aligned frame out of the rings of the devices
+   *
+   * Nothing is read until all devices recorded enough samples, the first frame also waits for a stamp of every
+   * device.
+   * @param rings the ring of every device
+   * @param frames number of samples per channel
+   * @param output receives the interleaved frame, channels of the first device first
+   * @return false if not all samples of the frame have been recorded yet
+   */
+  bool read_frame(const std::vector<SampleRing *> &rings, size_t frames, double *output);
+
+  /**
+   * @brief Discards all recorded samples and stamps and aligns the devices anew
+   *
+   * Needed once samples were lost, their positions no longer match the stamps.
+   * @param rings the ring of every device
+   */
+  void restart(const std::vector<SampleRing *> &rings);
+
+  /**
+   * @brief Checks whether the devices have been aligned
+   * @return true once the first frame has been read
+   */
+  bool is_started() const {
+    return started_;
+  }
+
+  /**
+   * @brief Returns the estimated clock deviation of a device from the reference
+   * @param device index of the device
+   * @return deviation in parts per million, positive if the device runs faster
+   */
+  double get_drift(int device) const;
+
+  /**
+   * @brief Returns the number of channels of all devices
+   * @return number of channels of an output frame
+   */
+  int get_channels() const {
+    return channels_;
+  }
+
+ private:
+  // alignment state of a device
+  struct Device {
+    ClockDriftEstimator clock;
+    FractionalResampler resampler;
+    // first channel of the device within an output frame
+    int first_channel;
+    // samples the device is delayed by
+    int delay;
+    // input samples of the current frame
+    std::vector<double> input;
+  };
+  // all devices, the first one is the reference
+  std::vector<Device> devices_;
+  // number of channels of all devices
+  int channels_ = 0;
+  // signals whether the devices have been aligned
+  bool started_ = false;
+
+  // skips the samples of all devices recorded before the first common sample and primes the resamplers
+  bool start(const std::vector<SampleRing *> &rings);
+  // position of the next output sample of a device within its ring
+  double get_read_position(int device, const SampleRing &ring) const;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_STREAM_ALIGNER_H_
@@ -0,0 +1,101 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the taylortrack::utils::TextSampleReader class.
+*/
+
+#include "utils/text_sample_reader.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace taylortrack {
+namespace utils {
+
+namespace {
+// longer tokens are no sample values
+const size_t kMaxTokenLength = 63;
+
+// bytes the kernel is asked to read ahead of the parsed samples
+const size_t kReadahead = 1 << 20;
+
+bool is_space(char character) {
+  return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+}  // namespace
+
+TextSampleReader::TextSampleReader(const char *file_name) : file_(file_name) {}
+
+int64_t TextSampleReader::get_line_count() const {
+  const char *text = reinterpret_cast<const char *>(file_.data());
+  const char *end = text + file_.size();
+  int64_t lines = 0;
+  while (text < end) {
+    const char *newline = static_cast<const char *>(memchr(text, '\n', end - text));
+    ++lines;
+    if (!newline)
+      break;
+    text = newline + 1;
+  }
+  return lines;
+}
+
+int64_t TextSampleReader::read_samples(double *samples, int64_t count) {
+  const char *text = reinterpret_cast<const char *>(file_.data());
+  const size_t size = file_.size();
+  int64_t parsed = 0;
+  while (parsed < count && !is_done()) {
+    while (position_ < size && is_space(text[position_]))
+      ++position_;
+    size_t token_end = position_;
+    while (token_end < size && !is_space(text[token_end]))
+      ++token_end;
+    if (token_end == position_)
+      break;
+
+    // the mapping is not terminated, strtod gets a terminated copy of the token
+    size_t length = token_end - position_;
+    char token[kMaxTokenLength + 1];
+    char *number_end = token;
+    if (length <= kMaxTokenLength) {
+      memcpy(token, text + position_, length);
+      token[length] = '\0';
+      samples[parsed] = strtod(token, &number_end);
+    }
+    if (number_end == token) {
+      stopped_ = true;
+      break;
+    }
+    ++parsed;
+    // the end of the file is detected right after its last value
+    position_ = token_end;
+    while (position_ < size && is_space(text[position_]))
+      ++position_;
+  }
+  file_.prefetch(position_, kReadahead);
+  return parsed;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Header file for taylortrack::utils::TextSampleReader class.
+*/
+
+#ifndef TAYLORTRACK_UTILS_TEXT_SAMPLE_READER_H_
+#define TAYLORTRACK_UTILS_TEXT_SAMPLE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "utils/mapped_file.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class TextSampleReader
+* @brief Parses text files with one sample value per line.
+*
+* The file is memory mapped and parsed in place into buffers of the caller, so large recordings are read without
+* an intermediate copy of every line. Reading stops at the first value that is no number.
+* @code
+* // Example usage:
+* taylortrack::utils::TextSampleReader reader("../Testdata/0-180_short.txt");
+* // the number of lines is an upper bound for the number of samples
+* std::vector<double> samples(reader.get_line_count());
+* samples.resize(reader.read_samples(samples.data(), samples.size()));
+*
+* // or stream the file in chunks of 2048 samples
+* double chunk[2048];
+* while (!reader.is_done()) {
+*   int64_t read = reader.read_samples(chunk, 2048);
+* }
+* @endcode
+*/
+class TextSampleReader {
+ public:
+  /**
+  * @brief Maps the text file
+  * @param file_name Path to the file to be parsed.
+  */
+  explicit TextSampleReader(const char *file_name);
+
+  /**
+   * @brief Remove copy constructor
+   */
+  TextSampleReader(const TextSampleReader &that) = delete;
+
+  /**
+  * @brief Checks whether the file could be opened
+  * @return true if the file exists and is not empty, otherwise false
+  */
+  bool is_valid() const {
+    return file_.is_open();
+  }
+
+  /**
+  * @brief Counts the lines of the file
+  * @return Number of lines, an upper bound for the number of samples
+  */
+  int64_t get_line_count() const;
+
+  /**
+  * @brief Parses the next samples
+  *
+  * Continues where the previous call stopped.
+  * @param samples buffer with space for count values
+  * @param count maximum number of values to parse
+  * @return Number of parsed values, less than count at the end of the samples
+  */
+  int64_t read_samples(double *samples, int64_t count);
+
+  /**
+  * @brief Checks whether all samples have been parsed
+  * @return true if the end of the file or a value that is no number was reached, otherwise false
+  */
+  bool is_done() const {
+    return stopped_ || position_ >= file_.size();
+  }
+
+ private:
+  // the whole text file mapped into memory
+  MappedFile file_;
+  // offset of the next unparsed character
+  size_t position_ = 0;
+  // signals that a value could not be parsed
+  bool stopped_ = false;
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_TEXT_SAMPLE_READER_H_
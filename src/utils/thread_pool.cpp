@@ -0,0 +1,89 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Implementation of the thread pool.
+*/
+#include "utils/thread_pool.h"
+#include <algorithm>
+
+namespace taylortrack {
+namespace utils {
+ThreadPool::ThreadPool(int threads) {
+  for (int i = 1; i < threads; ++i)
+    workers_.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_available_.notify_all();
+  for (std::thread &worker : workers_)
+    worker.join();
+}
+
+void ThreadPool::parallel_for(int count,
+                              const std::function<void(int)> &task) {
+  if (count <= 0)
+    return;
+  Loop loop;
+  loop.task = &task;
+  loop.count = count;
+  loop.unfinished = count;
+  std::unique_lock<std::mutex> lock(mutex_);
+  loops_.push_back(&loop);
+  work_available_.notify_all();
+  // the caller helps with its own loop until nothing is left to start,
+  // idle workers take the remaining iterations of any running loop
+  while (loop.next < loop.count)
+    run_next(&loop, &lock);
+  work_done_.wait(lock, [&loop] { return loop.unfinished == 0; });
+}
+
+void ThreadPool::run_next(Loop *loop, std::unique_lock<std::mutex> *lock) {
+  int index = loop->next++;
+  if (loop->next == loop->count)
+    loops_.erase(std::find(loops_.begin(), loops_.end(), loop));
+  lock->unlock();
+  (*loop->task)(index);
+  lock->lock();
+  if (--loop->unfinished == 0)
+    work_done_.notify_all();
+}
+
+void ThreadPool::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this] { return stop_ || !loops_.empty(); });
+    if (stop_)
+      return;
+    // oldest loop first, so no caller starves
+    run_next(loops_.front(), &lock);
+  }
+}
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,121 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+* @file
+* @brief Small fixed size thread pool for data parallel loops.
+*/
+#ifndef TAYLORTRACK_UTILS_THREAD_POOL_H_
+#define TAYLORTRACK_UTILS_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class ThreadPool
+* @brief Runs the iterations of a loop on a fixed set of worker threads.
+*
+* The calling thread takes part in the work, so a pool with one thread runs everything
+* on the caller and starts no workers at all. Several threads may run loops on the same
+* pool at once, idle workers take the unstarted iterations of whichever loop is oldest.
+* @code
+*  //Example usage:
+*  taylortrack::utils::ThreadPool pool(4);
+*  std::vector<double> partial(8);
+*  pool.parallel_for(8, [&](int task) {
+*    partial[task] = compute_part(task);
+*  });
+*  // all tasks are finished here
+* @endcode
+*/
+class ThreadPool {
+ public:
+  /**
+   * @brief Starts the worker threads.
+   * @param threads total number of threads including the calling thread, values below one are treated as one
+   */
+  explicit ThreadPool(int threads);
+
+  /**
+   * @brief Waits for the running tasks and joins all worker threads.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Calls task(0) ... task(count - 1) in parallel and blocks until all calls returned.
+   * @param count number of tasks
+   * @param task function called with the index of each task
+   */
+  void parallel_for(int count, const std::function<void(int)> &task);
+
+  /**
+   * @brief Returns the number of threads including the calling thread.
+   * @return number of threads working on a loop
+   */
+  int get_thread_count() const {
+    return static_cast<int>(workers_.size()) + 1;
+  }
+
+ private:
+  // worker threads, the calling thread is not included
+  std::vector<std::thread> workers_;
+  // state of one parallel_for call, lives on the stack of its caller
+  struct Loop {
+    // function called for each index
+    const std::function<void(int)> *task = nullptr;
+    // next index to start
+    int next = 0;
+    // number of indices
+    int count = 0;
+    // number of indices not yet finished
+    int unfinished = 0;
+  };
+  // loops with indices not yet started, oldest first
+  std::deque<Loop *> loops_;
+  // set when the pool shuts down
+  bool stop_ = false;
+  // guards all members above
+  std::mutex mutex_;
+  // signaled when new tasks are available or the pool shuts down
+  std::condition_variable work_available_;
+  // signaled when the last task of a loop finished
+  std::condition_variable work_done_;
+  // takes and runs tasks of any loop until the pool shuts down
+  void work();
+  // runs the next index of a loop on the current thread, expects the lock to be held
+  void run_next(Loop *loop, std::unique_lock<std::mutex> *lock);
+};
+}  // namespace utils
+}  // namespace taylortrack
+
+#endif  // TAYLORTRACK_UTILS_THREAD_POOL_H_
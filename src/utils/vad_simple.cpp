@@ -36,8 +36,32 @@ VadSimple::VadSimple(double threshold) {
 
 bool VadSimple::detect(const RArray &sample) {
   if (sample.size() > 0) {
-    RArray result = std::pow(sample, 2.0);
-    return threshold_ <= result.sum() / result.size();
+    // summed up in place, no temporary array per frame
+    double energy = 0.0;
+    for (double value : sample)
+      energy += value * value;
+    return threshold_ <= energy / sample.size();
+  }
+  return false;
+}
+
+bool VadSimple::detect(const SignalView &frame) {
+  if (frame.length > 0) {
+    double energy = 0.0;
+    for (int64_t i = 0; i < frame.length; ++i)
+      energy += frame.at(0, i) * frame.at(0, i);
+    return threshold_ <= energy / frame.length;
+  }
+  return false;
+}
+
+bool VadSimple::detect(const Pcm16View &frame) {
+  if (frame.length > 0) {
+    // exact in 64 bit, scaled to the power of the double precision samples once
+    int64_t energy = 0;
+    for (int64_t i = 0; i < frame.length; ++i)
+      energy += static_cast<int32_t>(frame.at(0, i)) * frame.at(0, i);
+    return threshold_ <= energy / (32767.0 * 32767.0) / frame.length;
   }
   return false;
 }
@@ -66,6 +66,20 @@ class VadSimple : public VadStrategy {
    */
   bool detect(const RArray &sample) override;
 
+  /**
+   * @brief energy based detection on the first channel of an interleaved frame
+   * @param frame view on an interleaved frame
+   * @return true if voice is detected
+   */
+  bool detect(const SignalView &frame) override;
+
+  /**
+   * @brief energy based detection on the first channel of an interleaved 16 bit frame
+   * @param frame view on an interleaved frame, full scale is 32767
+   * @return true if voice is detected
+   */
+  bool detect(const Pcm16View &frame);
+
   /**
    * @brief Getter Method for threshold
    * @return threshold value
@@ -0,0 +1,111 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of a spectral voice activity tracker
+*/
+#include "utils/vad_spectral.h"
+#include <algorithm>
+#include <cmath>
+
+namespace taylortrack {
+namespace utils {
+
+VadSpectral::VadSpectral(double threshold, int sample_rate) {
+  threshold_ = threshold;
+  sample_rate_ = sample_rate;
+}
+
+bool VadSpectral::detect(const RArray &sample) {
+  if (sample.size() == 0)
+    return false;
+  return transform_and_detect(&sample[0], 1, static_cast<int64_t>(sample.size()));
+}
+
+bool VadSpectral::detect(const SignalView &frame) {
+  if (frame.length <= 0)
+    return false;
+  return transform_and_detect(&frame.at(0, 0), frame.stride, frame.length);
+}
+
+bool VadSpectral::transform_and_detect(const double *samples, int64_t stride,
+                                       int64_t length) {
+  size_t fft_length = 1;
+  while (fft_length < static_cast<size_t>(length))
+    fft_length <<= 1;
+  if (!plan_ || plan_->get_length() != fft_length)
+    plan_ = std::make_shared<FftPlan>(fft_length);
+  if (spectrum_.size() != fft_length)
+    spectrum_.resize(fft_length);
+  for (int64_t n = 0; n < length; ++n)
+    spectrum_[n] = samples[n * stride];
+  for (size_t n = static_cast<size_t>(length); n < fft_length; ++n)
+    spectrum_[n] = 0.0;
+  plan_->fft(spectrum_);
+  return detect_spectrum(spectrum_, length);
+}
+
+bool VadSpectral::detect_spectrum(const CArray &spectrum, int64_t frame_length) {
+  size_t fft_length = spectrum.size();
+  if (fft_length < 2 || frame_length <= 0)
+    return false;
+  double bin_width = static_cast<double>(sample_rate_) / fft_length;
+  size_t first = static_cast<size_t>(std::max(1.0, std::ceil(band_low_ / bin_width)));
+  size_t last = std::min(fft_length / 2, static_cast<size_t>(band_high_ / bin_width));
+
+  double total_energy = 0.0;
+  double band_energy = 0.0;
+  double log_sum = 0.0;
+  for (size_t k = 0; k <= fft_length / 2; ++k) {
+    double power = std::norm(spectrum[k]);
+    // every bin except dc and nyquist also stands for its negative frequency
+    total_energy += k == 0 || k == fft_length / 2 ? power : 2.0 * power;
+    if (k >= first && k <= last) {
+      band_energy += power;
+      log_sum += std::log(power + 1e-30);
+    }
+  }
+  size_t band_bins = last >= first ? last - first + 1 : 0;
+  if (band_bins == 0)
+    return false;
+  // Parseval, the zero padding adds no energy
+  double mean_power = total_energy / (static_cast<double>(fft_length) * frame_length);
+  double band_ratio = total_energy > 0.0 ? 2.0 * band_energy / total_energy : 0.0;
+  double arithmetic_mean = band_energy / band_bins;
+  double flatness = arithmetic_mean > 0.0 ?
+      std::exp(log_sum / band_bins) / arithmetic_mean : 1.0;
+
+  double floor = noise_floor_;
+  if (noise_floor_ < 0.0 || band_energy < noise_floor_)
+    noise_floor_ = band_energy;
+  else
+    noise_floor_ *= 1.0 + floor_rise_;
+  if (floor < 0.0)
+    return false;
+  return mean_power >= threshold_ && band_energy > snr_threshold_ * floor &&
+      band_ratio >= min_band_ratio_ && flatness <= max_flatness_;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
@@ -0,0 +1,190 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Voice Activity Detection on the spectrum of a frame
+*/
+
+#ifndef TAYLORTRACK_UTILS_VAD_SPECTRAL_H_
+#define TAYLORTRACK_UTILS_VAD_SPECTRAL_H_
+#include <cstdint>
+#include <memory>
+#include "utils/fft_plan.h"
+#include "utils/vad_strategy.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class VadSpectral
+* @brief Implements a Voice Activity Detection using the spectral shape of a signal.
+*
+* A frame counts as speech if its mean power reaches the threshold, its speech band energy rises clearly above a
+* tracked noise floor, most of its energy lies in the speech band and the speech band is not flat like noise.
+* The noise floor follows the speech band energy down immediately and up slowly, so the first frame only
+* initializes it and is never classified as speech.
+  * @code
+  * // Example usage:
+  * //   Create a class instance with the mean power threshold of VadSimple and the sample rate
+  * taylortrack::utils::VadSpectral vad(0.0000007, 44100);
+  * // spectra computed elsewhere are classified without another transformation
+  * bool speech = vad.detect_spectrum(spectrum, frame_length);
+  * @endcode
+  */
+class VadSpectral : public VadStrategy {
+ public:
+  /**
+   * @brief Default constructor, uses the default threshold of the audio settings and 44100 Hz.
+   */
+  VadSpectral() = default;
+
+  /**
+   * @brief Constructor
+   * @param threshold minimum mean power of a speech frame
+   * @param sample_rate sample rate of the classified signals
+   */
+  VadSpectral(double threshold, int sample_rate);
+
+  /**
+   * @brief Default copy constructor
+   */
+  VadSpectral(const VadSpectral &that) = default;
+
+  /**
+   * @brief spectral detection, the sample is transformed first
+   * @param &sample
+   * @return true if voice is detected
+   */
+  bool detect(const RArray &sample) override;
+
+  /**
+   * @brief spectral detection on the first channel of an interleaved frame
+   * @param frame view on an interleaved frame
+   * @return true if voice is detected
+   */
+  bool detect(const SignalView &frame) override;
+
+  /**
+   * @brief spectral detection on an already transformed frame
+   *
+   * Only the bins up to the Nyquist frequency are read, the spectrum may belong to a zero padded frame.
+   * @param spectrum transform of the frame
+   * @param frame_length number of samples of the frame before zero padding
+   * @return true if voice is detected
+   */
+  bool detect_spectrum(const CArray &spectrum, int64_t frame_length);
+
+  /**
+   * @brief Getter Method for threshold
+   * @return minimum mean power of a speech frame
+   */
+  double get_threshold() const {
+    return threshold_;
+  }
+
+  /**
+   * @brief Setter Method for threshold
+   * @param threshold minimum mean power of a speech frame
+   */
+  void set_threshold(double threshold) {
+    threshold_ = threshold;
+  }
+
+  /**
+   * @brief Sets the frequency band considered as speech.
+   * @param low lower limit in Hz
+   * @param high upper limit in Hz
+   */
+  void set_band(double low, double high) {
+    band_low_ = low;
+    band_high_ = high;
+  }
+
+  /**
+   * @brief Sets how far the speech band energy has to rise above the noise floor.
+   * @param snr_threshold ratio of speech band energy and noise floor
+   */
+  void set_snr_threshold(double snr_threshold) {
+    snr_threshold_ = snr_threshold;
+  }
+
+  /**
+   * @brief Sets the highest spectral flatness of the speech band still classified as speech.
+   * @param max_flatness geometric over arithmetic mean of the band powers, 1 for white noise spectra
+   */
+  void set_max_flatness(double max_flatness) {
+    max_flatness_ = max_flatness;
+  }
+
+  /**
+   * @brief Sets the smallest share of the energy inside the speech band.
+   * @param min_band_ratio speech band energy over total energy
+   */
+  void set_min_band_ratio(double min_band_ratio) {
+    min_band_ratio_ = min_band_ratio;
+  }
+
+  /**
+   * @brief Returns the current noise floor of the speech band energy.
+   * @return noise floor, negative before the first frame
+   */
+  double get_noise_floor() const {
+    return noise_floor_;
+  }
+
+  /**
+   * @brief Forgets the noise floor, the next frame initializes it again.
+   */
+  void reset() {
+    noise_floor_ = -1.0;
+  }
+
+ private:
+  // minimum mean power of a speech frame
+  double threshold_ = 0.0000007;
+  // sample rate of the classified signals
+  int sample_rate_ = 44100;
+  // lower limit of the speech band in Hz
+  double band_low_ = 100.0;
+  // upper limit of the speech band in Hz
+  double band_high_ = 4000.0;
+  // required ratio of speech band energy and noise floor
+  double snr_threshold_ = 4.0;
+  // highest spectral flatness of the speech band classified as speech
+  double max_flatness_ = 0.4;
+  // smallest share of the energy inside the speech band
+  double min_band_ratio_ = 0.5;
+  // relative rise of the noise floor per frame above it
+  double floor_rise_ = 0.02;
+  // tracked speech band energy of the background, negative until the first frame
+  double noise_floor_ = -1.0;
+  // transform used when the frames arrive as samples
+  std::shared_ptr<FftPlan> plan_;
+  // zero padded copy of the classified channel
+  CArray spectrum_;
+  // transforms length samples read with the given stride and classifies them
+  bool transform_and_detect(const double *samples, int64_t stride, int64_t length);
+};
+}  // namespace utils
+}  // namespace taylortrack
+#endif  // TAYLORTRACK_UTILS_VAD_SPECTRAL_H_
@@ -31,6 +31,7 @@ SOFTWARE.
 #include <complex.h>
 #include <valarray>
 #include <vector>
+#include "utils/signal_view.h"
 
 namespace taylortrack {
 namespace utils {
@@ -49,6 +50,21 @@ class VadStrategy {
    * @return true if voice activity has been tracked in given sample
    */
   virtual bool detect(const RArray &sample) = 0;
+
+  /**
+   * @brief tracks voice activity for the first channel of an interleaved frame
+   *
+   * Copies the first channel and passes it to detect(const RArray &), implementations
+   * may override this to work on the frame directly.
+   * @param frame view on an interleaved frame
+   * @return true if voice activity has been tracked in given frame
+   */
+  virtual bool detect(const SignalView &frame) {
+    RArray sample(static_cast<size_t>(frame.length));
+    for (int64_t i = 0; i < frame.length; ++i)
+      sample[i] = frame.at(0, i);
+    return detect(sample);
+  }
 };
 }  // namespace utils
 }  // namespace taylortrack
@@ -0,0 +1,167 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Implementation of the streaming voice activity tracker
+*/
+#include "utils/vad_streaming.h"
+#include <algorithm>
+
+namespace taylortrack {
+namespace utils {
+
+namespace {
+// floors never reach zero, digital silence would turn any sound into speech
+const double kMinimumFloor = 1e-12;
+
+// sums up the squares of every channel in one pass over the interleaved
+// block, the fixed channel count lets the compiler vectorize the inner loop
+template <int kChannels, typename T>
+void sum_squares(const T *data, int stride, int64_t length, double *sums) {
+  double partial[kChannels] = {};
+  for (int64_t n = 0; n < length; ++n) {
+    const T *sample = data + n * stride;
+    for (int c = 0; c < kChannels; ++c)
+      partial[c] += static_cast<double>(sample[c]) * sample[c];
+  }
+  for (int c = 0; c < kChannels; ++c)
+    sums[c] = partial[c];
+}
+
+template <typename T>
+void sum_squares(const BasicSignalView<T> &block, double *sums) {
+  switch (block.channels) {
+    case 1:
+      sum_squares<1>(block.data, block.stride, block.length, sums);
+      return;
+    case 2:
+      sum_squares<2>(block.data, block.stride, block.length, sums);
+      return;
+    case 4:
+      sum_squares<4>(block.data, block.stride, block.length, sums);
+      return;
+    case 8:
+      sum_squares<8>(block.data, block.stride, block.length, sums);
+      return;
+    default:
+      std::fill(sums, sums + block.channels, 0.0);
+      for (int64_t n = 0; n < block.length; ++n) {
+        for (int c = 0; c < block.channels; ++c)
+          sums[c] += static_cast<double>(block.at(c, n)) * block.at(c, n);
+      }
+  }
+}
+}  // namespace
+
+VadStreaming::VadStreaming(double threshold, int block_size,
+                           int hangover_blocks) {
+  threshold_ = threshold;
+  block_size_ = std::max(1, block_size);
+  hangover_blocks_ = std::max(0, hangover_blocks);
+}
+
+bool VadStreaming::detect(const RArray &sample) {
+  if (sample.size() == 0)
+    return false;
+  return detect(SignalView(&sample[0], 1, 1, static_cast<int64_t>(sample.size())));
+}
+
+bool VadStreaming::detect(const SignalView &frame) {
+  bool voice = false;
+  for (int64_t begin = 0; begin < frame.length; begin += block_size_) {
+    int64_t length = std::min(static_cast<int64_t>(block_size_), frame.length - begin);
+    voice = process_block(SignalView(&frame.at(0, begin), frame.channels,
+                                     frame.stride, length)) || voice;
+  }
+  return voice;
+}
+
+bool VadStreaming::process_block(const SignalView &block) {
+  if (block.length <= 0 || block.channels <= 0)
+    return active_;
+  energies_.resize(static_cast<size_t>(block.channels));
+  sum_squares(block, energies_.data());
+  return update(block.length, 1.0);
+}
+
+bool VadStreaming::process_block(const Pcm16View &block) {
+  if (block.length <= 0 || block.channels <= 0)
+    return active_;
+  energies_.resize(static_cast<size_t>(block.channels));
+  sum_squares(block, energies_.data());
+  return update(block.length, 1.0 / (32767.0 * 32767.0));
+}
+
+bool VadStreaming::update(int64_t length, double scale) {
+  for (double &energy : energies_)
+    energy = energy * scale / length;
+  if (noise_floors_.size() != energies_.size()) {
+    noise_floors_.resize(energies_.size());
+    for (size_t c = 0; c < energies_.size(); ++c)
+      noise_floors_[c] = std::max(kMinimumFloor, energies_[c]);
+    active_ = false;
+    hangover_left_ = 0;
+    return false;
+  }
+
+  double ratio = 0.0;
+  double power = 0.0;
+  for (size_t c = 0; c < energies_.size(); ++c) {
+    ratio += energies_[c] / noise_floors_[c];
+    power += energies_[c];
+  }
+  ratio /= energies_.size();
+  power /= energies_.size();
+  // hysteresis: once active, a lower ratio keeps speech going
+  bool speech = power >= threshold_ &&
+      ratio >= (active_ ? release_ratio_ : onset_ratio_);
+  if (speech) {
+    active_ = true;
+    hangover_left_ = hangover_blocks_;
+  } else if (hangover_left_ > 0) {
+    --hangover_left_;
+  } else {
+    active_ = false;
+  }
+
+  for (size_t c = 0; c < energies_.size(); ++c) {
+    double &floor = noise_floors_[c];
+    if (energies_[c] < floor)
+      floor = std::max(kMinimumFloor, energies_[c]);
+    else if (speech)
+      floor *= 1.0 + floor_rise_;
+    else
+      floor += floor_adaption_ * (energies_[c] - floor);
+  }
+  return active_;
+}
+
+void VadStreaming::reset() {
+  noise_floors_.clear();
+  active_ = false;
+  hangover_left_ = 0;
+}
+
+}  // namespace utils
+}  // namespace taylortrack
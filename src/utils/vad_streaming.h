@@ -0,0 +1,191 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marius Kaufmann, Tamara Frieß, Jannis Hoppe, Christian Hack
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+* @file
+* @brief Streaming multichannel Voice Activity Detection
+*/
+
+#ifndef TAYLORTRACK_UTILS_VAD_STREAMING_H_
+#define TAYLORTRACK_UTILS_VAD_STREAMING_H_
+#include <vector>
+#include "utils/vad_strategy.h"
+
+namespace taylortrack {
+namespace utils {
+/**
+* @class VadStreaming
+* @brief Implements a Voice Activity Detection on short blocks of all channels with memory between them.
+*
+* The mean power of every channel is compared to an adaptive noise floor of that channel. Speech starts once the
+* average ratio of all channels reaches the onset ratio and ends when it falls below the lower release ratio and
+* the hangover blocks passed. Blocks can be fed as soon as they arrive, so a decision is ready before the frame
+* is complete. The first block only initializes the noise floors.
+  * @code
+  * // Example usage:
+  * //   Create a class instance with the minimum mean power, the block size and the hangover in blocks
+  * taylortrack::utils::VadStreaming vad(0.0000007, 256, 8);
+  * // feed the blocks of a frame as they arrive
+  * bool speech = vad.process_block(taylortrack::utils::SignalView(buffer.data(), 4, 4, 256));
+  * // or classify a whole frame, true if any of its blocks contains speech
+  * speech = vad.detect(frame);
+  * @endcode
+  */
+class VadStreaming : public VadStrategy {
+ public:
+  /**
+   * @brief Default constructor, uses the default threshold of the audio settings, 256 samples and 8 blocks.
+   */
+  VadStreaming() = default;
+
+  /**
+   * @brief Constructor
+   * @param threshold minimum mean power of a speech block averaged over the channels
+   * @param block_size number of samples per channel of each block
+   * @param hangover_blocks number of blocks speech is held after the release condition
+   */
+  VadStreaming(double threshold, int block_size, int hangover_blocks);
+
+  /**
+   * @brief Default copy constructor
+   */
+  VadStreaming(const VadStreaming &that) = default;
+
+  /**
+   * @brief streaming detection on a single channel
+   * @param &sample
+   * @return true if voice is detected in any block of the sample
+   */
+  bool detect(const RArray &sample) override;
+
+  /**
+   * @brief streaming detection on all channels of an interleaved frame
+   * @param frame view on an interleaved frame
+   * @return true if voice is detected in any block of the frame
+   */
+  bool detect(const SignalView &frame) override;
+
+  /**
+   * @brief Updates the decision with the next block of the stream.
+   * @param block view on the next samples of all channels, usually get_block_size() samples long
+   * @return true while speech is active
+   */
+  bool process_block(const SignalView &block);
+
+  /**
+   * @brief Updates the decision with the next block of a 16 bit stream.
+   * @param block view on the next samples of all channels, full scale is 32767
+   * @return true while speech is active
+   */
+  bool process_block(const Pcm16View &block);
+
+  /**
+   * @brief Checks whether speech was active after the last block.
+   * @return true while speech is active, including the hangover
+   */
+  bool is_active() const {
+    return active_;
+  }
+
+  /**
+   * @brief Getter Method for threshold
+   * @return minimum mean power of a speech block
+   */
+  double get_threshold() const {
+    return threshold_;
+  }
+
+  /**
+   * @brief Setter Method for threshold
+   * @param threshold minimum mean power of a speech block
+   */
+  void set_threshold(double threshold) {
+    threshold_ = threshold;
+  }
+
+  /**
+   * @brief Returns the number of samples per channel detect() puts into one block.
+   * @return block size in samples
+   */
+  int get_block_size() const {
+    return block_size_;
+  }
+
+  /**
+   * @brief Sets the power ratios over the noise floor starting and ending speech.
+   * @param onset_ratio ratio starting speech
+   * @param release_ratio lower ratio keeping speech active
+   */
+  void set_ratios(double onset_ratio, double release_ratio) {
+    onset_ratio_ = onset_ratio;
+    release_ratio_ = release_ratio;
+  }
+
+  /**
+   * @brief Returns the noise floor of each channel.
+   * @return mean power of the background per channel, empty before the first block
+   */
+  const std::vector<double> &get_noise_floors() const {
+    return noise_floors_;
+  }
+
+  /**
+   * @brief Forgets noise floors and decision, the next block initializes them again.
+   */
+  void reset();
+
+ private:
+  /**
+   * @brief Turns the summed squares in energies_ into mean powers and updates the decision.
+   * @param length number of samples per channel of the block
+   * @param scale factor from the squared samples to the power of samples between -1 and 1
+   * @return true while speech is active
+   */
+  bool update(int64_t length, double scale);
+
+  // minimum mean power of a speech block averaged over the channels
+  double threshold_ = 0.0000007;
+  // samples per channel of the blocks detect() splits frames into
+  int block_size_ = 256;
+  // blocks speech is held after the release condition
+  int hangover_blocks_ = 8;
+  // average power ratio over the noise floors starting speech
+  double onset_ratio_ = 4.0;
+  // average power ratio over the noise floors keeping speech active
+  double release_ratio_ = 2.0;
+  // share of the distance to the block power the floors move per silent block
+  double floor_adaption_ = 0.05;
+  // relative rise of the floors per speech block, recovers from louder backgrounds
+  double floor_rise_ = 0.002;
+  // mean power of the background of each channel
+  std::vector<double> noise_floors_;
+  // mean power of each channel in the current block
+  std::vector<double> energies_;
+  // whether speech is active
+  bool active_ = false;
+  // blocks left until speech ends without a new onset
+  int hangover_left_ = 0;
+};
+}  // namespace utils
+}  // namespace taylortrack
+#endif  // TAYLORTRACK_UTILS_VAD_STREAMING_H_
@@ -21,32 +21,49 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
-
 /**
 * @file
 * @brief Implementation of for taylortrack::utils::WaveParser class.
 */
 
 #include "wave_parser.h"
-#include <string>
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <vector>
 
 namespace taylortrack {
 namespace utils {
 
-WaveParser::WaveParser(const char *file_name) {
-  this->file_ = std::move(std::ifstream(file_name, std::ios::in | std::ios::binary));
+namespace {
+// bytes the kernel is asked to read ahead of the extracted samples
+const size_t kReadahead = 4 << 20;
 
-  if (this->file_)
+// format code of WAVE_FORMAT_EXTENSIBLE
+const uint16_t kFormatExtensible = 0xFFFE;
+
+// little endian fields of the headers
+uint16_t read_uint16(const unsigned char *bytes) {
+  return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t read_uint32(const unsigned char *bytes) {
+  return static_cast<uint32_t>(bytes[0]) |
+      (static_cast<uint32_t>(bytes[1]) << 8) |
+      (static_cast<uint32_t>(bytes[2]) << 16) |
+      (static_cast<uint32_t>(bytes[3]) << 24);
+}
+}  // namespace
+
+WaveParser::WaveParser(const char *file_name) : file_(file_name) {
+  if (file_.is_open())
     this->parse_file();
   else
     valid_ = false;
 }
 
 bool WaveParser::is_done() {
-  return !valid_ || this->file_.eof() ||
-      (static_cast<int64_t>(this->data_offset_) +
-          this->data_size_ <= static_cast<int64_t>(this->file_.tellg()));
+  return !valid_ || position_ >= data_size_;
 }
 
 int64_t WaveParser::get_sample_num() const {
@@ -54,76 +71,94 @@ int64_t WaveParser::get_sample_num() const {
 }
 
 void WaveParser::parse_file() {
-  bool valid = true;
-  char four_byte_buffer[5] = "";
-  uint32_t fmt_size = 0;
-
-  // Read RIFF header indication
-  this->file_.read(four_byte_buffer, 4*sizeof(char));
-  if (strcmp(four_byte_buffer, "RIFF") == 0) {
-    // skip chunk size
-    this->file_.seekg(8, std::ios_base::beg);
-
-    // read chunk format
-    valid &= static_cast<bool>(this->file_.read(four_byte_buffer, 4));
-    if (strcmp(four_byte_buffer, "WAVE") == 0) {
-      // read subchunk id
-      valid &= static_cast<bool>(this->file_.read(four_byte_buffer, 4));
-      if (strcmp(four_byte_buffer, "fmt ") == 0) {
-        fmt_size = static_cast<uint32_t>(
-            this->file_.get() | (this->file_.get() << 8) |
-                (this->file_.get() << 16) | (this->file_.get() << 24));
-
-        this->audio_format_ = static_cast<uint16_t>(this->file_.get() |
-            (this->file_.get() << 8));
-        this->num_channels_ = static_cast<uint16_t>(this->file_.get() |
-            (this->file_.get() << 8));
-        this->sample_rate_ = static_cast<uint32_t>(
-            this->file_.get() | (this->file_.get() << 8) |
-                (this->file_.get() << 16) | (this->file_.get() << 24));
-        this->byte_rate_ = static_cast<uint32_t>(
-            this->file_.get() | (this->file_.get() << 8) |
-                (this->file_.get() << 16) | (this->file_.get() << 24));
-        this->block_align_ = static_cast<uint16_t>(this->file_.get() |
-            (this->file_.get() << 8));
-        this->bits_per_sample_ = static_cast<uint16_t>(this->file_.get() |
-            (this->file_.get() << 8));
-
-        // read data header
-        this->file_.seekg(20 + fmt_size, std::ios_base::beg);
-        valid &= static_cast<bool>(this->file_.read(four_byte_buffer, 4));
-
-        if (strcmp(four_byte_buffer, "data") == 0) {
-          // read data subchunk length in bytes
-          this->data_size_ = static_cast<uint32_t>(
-              this->file_.get() | (this->file_.get() << 8) |
-                  (this->file_.get() << 16) | (this->file_.get() << 24));
-          this->data_offset_ = this->file_.tellg();
-        } else {
-          valid = false;
-        }
-      } else {
-        valid = false;
+  const unsigned char *bytes = file_.data();
+  const size_t file_size = file_.size();
+  bool valid = false;
+  bool fmt_found = false;
+  bool data_found = false;
+  // RIFF header and WAVE format, followed by a list of chunks
+  if (file_size >= 12 && memcmp(bytes, "RIFF", 4) == 0 &&
+      memcmp(bytes + 8, "WAVE", 4) == 0) {
+    size_t chunk = 12;
+    while (chunk + 8 <= file_size && !(fmt_found && data_found)) {
+      const unsigned char *id = bytes + chunk;
+      size_t chunk_size = read_uint32(bytes + chunk + 4);
+      size_t body = chunk + 8;
+      if (memcmp(id, "fmt ", 4) == 0 && !fmt_found) {
+        if (chunk_size < 16 || body + chunk_size > file_size)
+          break;
+        this->audio_format_ = read_uint16(bytes + body);
+        this->num_channels_ = read_uint16(bytes + body + 2);
+        this->sample_rate_ = read_uint32(bytes + body + 4);
+        this->byte_rate_ = read_uint32(bytes + body + 8);
+        this->block_align_ = read_uint16(bytes + body + 12);
+        this->bits_per_sample_ = read_uint16(bytes + body + 14);
+        // WAVE_FORMAT_EXTENSIBLE keeps the actual format code at the start of the sub format GUID
+        if (audio_format_ == kFormatExtensible && chunk_size >= 40)
+          this->audio_format_ = read_uint16(bytes + body + 24);
+        fmt_found = true;
+      } else if (memcmp(id, "data", 4) == 0 && !data_found) {
+        data_offset_ = body;
+        // truncated recordings and streamed files with an unknown size only provide what is in the file
+        this->data_size_ = static_cast<uint32_t>(std::min(chunk_size, file_size - data_offset_));
+        data_found = true;
       }
-    } else {
-      valid = false;
+      // LIST, fact, cue and other chunks are skipped, chunks are padded to an even size
+      chunk = body + chunk_size + (chunk_size & 1);
     }
-  } else {
-    valid = false;
+    valid = fmt_found && data_found && this->block_align_ > 0;
   }
   this->valid_ = valid;
+  if (valid_)
+    encoding_ = get_sample_encoding(audio_format_, bits_per_sample_);
+}
+
+size_t WaveParser::advance(int64_t frame_num) {
+  size_t remaining = data_size_ - std::min<size_t>(position_, data_size_);
+  size_t size = std::min(remaining,
+                         static_cast<size_t>(std::max<int64_t>(0, frame_num)) * block_align_);
+  position_ += size;
+
+  // pages ahead of the next samples
+  if (position_ < data_size_)
+    file_.prefetch(data_offset_ + position_, std::min<size_t>(kReadahead, data_size_ - position_));
+  return size;
 }
 
 std::string WaveParser::get_samples(int64_t sample_num) {
-  int64_t transfered_sample_size =
-      ((this->block_align_ * sample_num) <= this->data_size_ ?
-       this->block_align_ * sample_num :
-       this->data_size_);
-  std::string samples;
-  for (unsigned int i = 0; i < transfered_sample_size; ++i) {
-    samples.push_back(static_cast<char>(this->file_.get()));
+  if (!valid_)
+    return std::string();
+  const char *first = reinterpret_cast<const char *>(file_.data() + data_offset_ + position_);
+  return std::string(first, advance(sample_num));
+}
+
+Pcm16View WaveParser::get_frames(int64_t frame_num) {
+  // the data chunk of a 16 bit file starts at an even offset, so the
+  // samples are properly aligned within the page aligned mapping
+  if (!valid_ || bits_per_sample_ != 16 || data_offset_ % 2 != 0 ||
+      block_align_ != 2 * num_channels_)
+    return Pcm16View();
+  const int16_t *first = reinterpret_cast<const int16_t *>(file_.data() + data_offset_ + position_);
+  int64_t length = static_cast<int64_t>(advance(frame_num) / block_align_);
+  return Pcm16View(first, num_channels_, num_channels_, length);
+}
+
+int64_t WaveParser::get_decoded_frames(int64_t frame_num, std::vector<double> *samples) {
+  int sample_size = get_sample_size(encoding_);
+  if (!valid_ || sample_size * num_channels_ != block_align_) {
+    samples->clear();
+    return 0;
   }
-  return samples;
+  const unsigned char *first = file_.data() + data_offset_ + position_;
+  int64_t length = static_cast<int64_t>(advance(frame_num) / block_align_);
+  samples->resize(static_cast<size_t>(length * num_channels_));
+  decode_samples(encoding_, first, length * num_channels_, samples->data());
+  return length;
+}
+
+bool WaveParser::is_decodable() const {
+  return valid_ && encoding_ != SampleEncoding::kUnsupported &&
+      get_sample_size(encoding_) * num_channels_ == block_align_;
 }
 
 int WaveParser::get_bits_per_sample() const {
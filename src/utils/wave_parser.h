@@ -30,9 +30,13 @@ SOFTWARE.
 #ifndef TAYLORTRACK_UTILS_WAVE_PARSER_H
 #define TAYLORTRACK_UTILS_WAVE_PARSER_H
 
-#include <fstream>
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "utils/mapped_file.h"
+#include "utils/pcm_decoder.h"
+#include "utils/signal_view.h"
 
 namespace taylortrack {
 namespace utils {
@@ -40,8 +44,11 @@ namespace utils {
 * @class WaveParser
 * @brief Parses a wave file and extracts samples.
 *
-* Helper class to deal with .wav files. Parses the RIFF header and the wave chunk headers.
-* However, it only extracts raw sample data and doesn't decode the samples.
+* Helper class to deal with .wav files. Parses the RIFF header and walks the chunks to find the fmt and data chunk,
+* other chunks like LIST are skipped. Raw sample data can be extracted as it is or decoded into doubles,
+* decoding supports 8, 16, 24 and 32 bit PCM as well as 32 bit float, also within WAVE_FORMAT_EXTENSIBLE.
+* The file is memory mapped, so 16 bit samples can be read through views without copying them,
+* which keeps streaming multi gigabyte recordings cheap.
 *
 * @code
 * // Example usage:
@@ -50,6 +57,14 @@ namespace utils {
 *
 * // afterwards you can read the data with the function get_samples like this
 * std::string samples = parser.get_samples(2);
+*
+* // or decode the next sample frames of any supported encoding
+* std::vector<double> decoded;
+* parser.get_decoded_frames(2048, &decoded);
+*
+* // or look at the next 16 bit sample frames in place
+* taylortrack::utils::Pcm16View frames = parser.get_frames(2048);
+* int16_t first_sample_of_second_channel = frames.at(1, 0);
 * @endcode
 */
 class WaveParser {
@@ -75,6 +90,8 @@ class WaveParser {
 
   /**
   * @brief Gets the sample encoding format specified in the wave header
+  *
+  * For WAVE_FORMAT_EXTENSIBLE files this is the format code of the sub format.
   * @pre is_valid() returns true
   * @return The audio format code
   * @sa %Audio format code reference: https://de.wikipedia.org/wiki/RIFF_WAVE#Datenformate_.28Format-Tag.29
@@ -131,6 +148,37 @@ class WaveParser {
   */
   std::string get_samples(int64_t sample_num);
 
+  /**
+  * @brief Fetches a view on the next n sample frames without copying them
+  *
+  * Continues where the previous call of get_samples() or get_frames() stopped, like get_samples().
+  * The view points into the mapped file and stays valid as long as the parser exists.
+  * The samples are little endian like the file, so the view is only meaningful on little endian hosts.
+  * @pre is_valid() returns true
+  * @param frame_num Number of samples to be extracted for each audio channel
+  * @return View on the interleaved samples, empty unless the file holds 16 bits per sample
+  */
+  Pcm16View get_frames(int64_t frame_num);
+
+  /**
+  * @brief Fetches and decodes the next n sample frames
+  *
+  * Continues where the previous extraction stopped, like get_samples(). All samples are decoded in a single pass
+  * into interleaved doubles, integer samples are scaled to about -1.0 to 1.0.
+  * @pre is_valid() returns true
+  * @param frame_num Number of samples to be extracted for each audio channel
+  * @param samples vector receiving the interleaved samples, resized to the number of decoded samples
+  * @return Number of decoded samples per channel, 0 if the encoding is not supported
+  * @sa is_decodable()
+  */
+  int64_t get_decoded_frames(int64_t frame_num, std::vector<double> *samples);
+
+  /**
+  * @brief Checks whether get_decoded_frames() supports the sample encoding of the file
+  * @return true if the file is valid and its samples can be decoded, otherwise false
+  */
+  bool is_decodable() const;
+
   /**
   * @brief Checks whether all samples have been extracted yet
   * @pre is_valid() returns true
@@ -161,11 +209,18 @@ class WaveParser {
   uint16_t bits_per_sample_ = 16;
   // the parsed wave file's datasize
   uint32_t data_size_ = 0;
-  // a stream of the wave file
-  std::ifstream file_;
-  //
-  std::fpos<mbstate_t> data_offset_;
+  // the whole wave file mapped into memory
+  MappedFile file_;
+  // offset of the first sample within the file
+  size_t data_offset_ = 0;
+  // offset of the next unextracted byte within the data chunk
+  size_t position_ = 0;
+  // decoder matching the audio format and sample size
+  SampleEncoding encoding_ = SampleEncoding::kUnsupported;
   void parse_file();
+  // returns the number of bytes of the next n sample frames and advances
+  // the position past them, asking the kernel to read ahead of them
+  size_t advance(int64_t frame_num);
 };
 }  // namespace utils
 }  // namespace taylortrack